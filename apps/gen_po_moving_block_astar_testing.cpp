@@ -79,6 +79,9 @@ int main(int argc, char** argv) {
   case cda_rail::simulator::RemainingTimeHeuristicType::Simple:
     PLOGI << "Remaining time heuristic: Simple";
     break;
+  case cda_rail::simulator::RemainingTimeHeuristicType::PairwiseConflicts:
+    PLOGI << "Remaining time heuristic: PairwiseConflicts";
+    break;
   }
   PLOGI << "Consider earliest exit: "
         << (consider_earliest_exit ? "yes" : "no");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <utility>
 
 // EOM = Equations of Motion
@@ -99,6 +100,31 @@ double vel_on_edge_at_time(double v_1, double v_2, double v_line, double a,
 double get_line_speed(double v_1, double v_2, double v_min, double v_max,
                       double a, double d, double s, double t);
 
+// Batched variants for many velocity combinations of one train on one edge.
+// Entry i of the output uses entry i of every span input. The input is
+// validated once before exception-free kernels are evaluated in tight loops
+// the compiler can vectorize. All spans must have the same size.
+void min_travel_time_batch(std::span<const double> v_1,
+                           std::span<const double> v_2, double v_m, double a,
+                           double d, double s, std::span<double> t);
+void max_travel_time_batch(std::span<const double> v_1,
+                           std::span<const double> v_2, double v_m, double a,
+                           double d, double s, bool stopping_allowed,
+                           std::span<double> t);
+void time_on_edge_batch(std::span<const double> v_1,
+                        std::span<const double> v_2,
+                        std::span<const double> v_line, double a, double d,
+                        double s, std::span<double> t);
+void pos_on_edge_at_time_batch(std::span<const double> v_1,
+                               std::span<const double> v_2,
+                               std::span<const double> v_line, double a,
+                               double d, double s, std::span<const double> t,
+                               std::span<double> pos);
+void get_line_speed_batch(std::span<const double> v_1,
+                          std::span<const double> v_2, double v_min,
+                          double v_max, double a, double d, double s,
+                          std::span<const double> t, std::span<double> v_line);
+
 double braking_distance(double v, double d);
 
 double max_braking_pos_after_dt_linear_movement(double v_0, double v_max,
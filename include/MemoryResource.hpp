@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+namespace cda_rail {
+struct AllocationCounters {
+  size_t allocations   = 0;
+  size_t deallocations = 0;
+  size_t bytes         = 0; // Total number of bytes allocated
+};
+
+// Forwards all requests to its upstream resource and counts them. Counters
+// are atomic, hence, the resource is thread-safe if its upstream is.
+class CountingMemoryResource : public std::pmr::memory_resource {
+private:
+  std::pmr::memory_resource* upstream;
+  std::atomic<size_t>        allocations   = 0;
+  std::atomic<size_t>        deallocations = 0;
+  std::atomic<size_t>        bytes         = 0;
+
+  void* do_allocate(size_t bytes_to_allocate, size_t alignment) override;
+  void  do_deallocate(void* p, size_t bytes_to_deallocate,
+                      size_t alignment) override;
+  [[nodiscard]] bool
+  do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  };
+
+public:
+  explicit CountingMemoryResource(
+      std::pmr::memory_resource* upstream_input =
+          std::pmr::new_delete_resource())
+      : upstream(upstream_input) {};
+
+  [[nodiscard]] AllocationCounters get_counters() const {
+    return {.allocations   = allocations.load(),
+            .deallocations = deallocations.load(),
+            .bytes         = bytes.load()};
+  };
+};
+
+// Pool for short-lived scratch memory of the calling thread, e.g., as upstream
+// of a std::pmr::monotonic_buffer_resource used for a single function call.
+// The pool keeps released memory for later use by the same thread.
+[[nodiscard]] std::pmr::memory_resource* thread_scratch_pool();
+
+// Requests of all scratch pools to the heap
+[[nodiscard]] AllocationCounters scratch_allocation_counters();
+} // namespace cda_rail
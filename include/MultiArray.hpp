@@ -1,9 +1,11 @@
 #pragma once
 #include "Definitions.hpp"
 
+#include <array>
 #include <cstddef>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 namespace cda_rail {
@@ -12,14 +14,21 @@ private:
   cda_rail::index_vector shape;
   std::vector<T>         data;
 
+  template <typename... Args>
+  [[nodiscard]] size_t get_index(Args... args) const;
+
 public:
   // Constructor with arbitrary number of size_t parameters
   template <typename... Args> explicit MultiArray(Args... args);
 
   // getter with arbitrary number of size_t parameters
-  template <typename... Args> T& operator()(Args... args);
+  template <typename... Args> T& operator()(Args... args) {
+    return data[get_index(args...)];
+  };
 
-  template <typename... Args> T at(Args... args) const;
+  template <typename... Args> T at(Args... args) const {
+    return data[get_index(args...)];
+  };
 
   // Function to obtain shape, size and dimensions
   [[nodiscard]] const cda_rail::index_vector& get_shape() const {
@@ -27,21 +36,58 @@ public:
   };
   [[nodiscard]] size_t size() const { return data.size(); };
   [[nodiscard]] size_t dimensions() const { return shape.size(); };
+
+  // Elements in memory order, i.e., the first index changes fastest
+  [[nodiscard]] const std::vector<T>& get_data() const { return data; };
+};
+
+template <typename T> class SparseMultiArray {
+private:
+  cda_rail::index_vector        shape;
+  std::unordered_map<size_t, T> data;
+
+  template <typename... Args>
+  [[nodiscard]] size_t get_index(Args... args) const;
+
+public:
+  // Constructor with arbitrary number of size_t parameters
+  template <typename... Args> explicit SparseMultiArray(Args... args);
+
+  // getter with arbitrary number of size_t parameters, missing elements are
+  // created default-constructed
+  template <typename... Args> T& operator()(Args... args) {
+    return data[get_index(args...)];
+  };
+
+  // getter returning a default-constructed element if it does not exist
+  template <typename... Args> T at(Args... args) const;
+
+  template <typename... Args> [[nodiscard]] bool contains(Args... args) const {
+    return data.contains(get_index(args...));
+  };
+
+  void reserve(size_t n) { data.reserve(n); };
+
+  // Function to obtain shape, number of stored elements and dimensions
+  [[nodiscard]] const cda_rail::index_vector& get_shape() const {
+    return shape;
+  };
+  [[nodiscard]] size_t size() const { return data.size(); };
+  [[nodiscard]] size_t dimensions() const { return shape.size(); };
 };
 
 template <typename T>
 template <typename... Args>
-T& MultiArray<T>::operator()(Args... args) {
+size_t MultiArray<T>::get_index(Args... args) const {
   /**
-   * Getter for an arbitrary number of dimensions.
+   * Index of an element in data for an arbitrary number of dimensions.
    * The first parameter is the index of the first dimension.
    * The remaining parameters are the indices of the remaining dimensions.
    * The number of parameters must coincide with the number of dimensions
    * specified in shape. The value of each parameter must be smaller than the
    * size of the corresponding dimension.
    *
-   * @param first Index of the first dimension
-   * @param args Indices of the remaining dimensions
+   * @param args Indices of the dimensions
    */
 
   // If the number of dimensions and number of arguments does not coincide throw
@@ -51,7 +97,8 @@ T& MultiArray<T>::operator()(Args... args) {
         "Number of dimensions and number of arguments do not coincide.");
   }
   // If the value of any argument is too large throw an error
-  cda_rail::index_vector arg_tuple = {static_cast<size_t>(args)...};
+  const std::array<size_t, sizeof...(args)> arg_tuple = {
+      static_cast<size_t>(args)...};
   for (size_t i = 0; i < sizeof...(args); ++i) {
     if (arg_tuple[i] >= shape[i]) {
       std::stringstream ss;
@@ -68,70 +115,86 @@ T& MultiArray<T>::operator()(Args... args) {
     multiplier *= shape[i];
   }
 
-  return data[index];
+  return index;
 }
 
 template <typename T>
 template <typename... Args>
-T MultiArray<T>::at(Args... args) const {
+MultiArray<T>::MultiArray(Args... args)
+    : shape({static_cast<size_t>(args)...}) {
   /**
-   * Getter for an arbitrary number of dimensions.
-   * The first parameter is the index of the first dimension.
-   * The remaining parameters are the indices of the remaining dimensions.
-   * The number of parameters must coincide with the number of dimensions
-   * specified in shape. The value of each parameter must be smaller than the
-   * size of the corresponding dimension.
+   * Constructor for an arbitrary number of dimensions.
+   * The first parameter is the size of the first dimension.
+   * The remaining parameters are the sizes of the remaining dimensions.
    *
-   * @param first Index of the first dimension
-   * @param args Indices of the remaining dimensions
+   * @param first Size of the first dimension
+   * @param args Sizes of the remaining dimensions
+   */
+
+  // If shape has only one element, allocate data
+  // The overall size of the array is the product of all elements in shape.
+  size_t cap = 1;
+  for (auto& shape_dim : shape) {
+    cap *= shape_dim;
+  }
+  data = std::vector<T>(cap);
+}
+
+template <typename T>
+template <typename... Args>
+size_t SparseMultiArray<T>::get_index(Args... args) const {
+  /**
+   * Linear index of an element for an arbitrary number of dimensions. It only
+   * serves as hash key, hence, it does not follow the layout of MultiArray. The
+   * number of parameters must coincide with the number of dimensions specified
+   * in shape. The value of each parameter must be smaller than the size of the
+   * corresponding dimension.
+   *
+   * @param args Indices of the dimensions
    */
 
-  // If the number of dimensions and number of arguments does not coincide throw
-  // an error
   if (shape.size() != sizeof...(args)) {
     throw std::invalid_argument(
         "Number of dimensions and number of arguments do not coincide.");
   }
-  // If the value of any argument is too large throw an error
-  cda_rail::index_vector arg_tuple = {static_cast<size_t>(args)...};
+  const std::array<size_t, sizeof...(args)> arg_tuple = {
+      static_cast<size_t>(args)...};
+  size_t index = 0;
   for (size_t i = 0; i < sizeof...(args); ++i) {
     if (arg_tuple[i] >= shape[i]) {
       std::stringstream ss;
       ss << "Index " << arg_tuple[i] << " is too large for dimension " << i;
       throw std::out_of_range(ss.str());
     }
+    index = index * shape[i] + arg_tuple[i];
   }
-
-  // Get the index of the element in the data respecting the row-major order
-  size_t index      = 0;
-  size_t multiplier = 1;
-  for (size_t i = 0; i < sizeof...(args); ++i) {
-    index += arg_tuple[i] * multiplier;
-    multiplier *= shape[i];
-  }
-
-  return data[index];
+  return index;
 }
 
 template <typename T>
 template <typename... Args>
-MultiArray<T>::MultiArray(Args... args)
+SparseMultiArray<T>::SparseMultiArray(Args... args)
     : shape({static_cast<size_t>(args)...}) {
   /**
-   * Constructor for an arbitrary number of dimensions.
-   * The first parameter is the size of the first dimension.
-   * The remaining parameters are the sizes of the remaining dimensions.
+   * Constructor for an arbitrary number of dimensions. No elements are
+   * allocated, they are only stored once they are accessed for writing.
    *
-   * @param first Size of the first dimension
-   * @param args Sizes of the remaining dimensions
+   * @param args Sizes of the dimensions
    */
+}
 
-  // If shape has only one element, allocate data
-  // The overall size of the array is the product of all elements in shape.
-  size_t cap = 1;
-  for (auto& shape_dim : shape) {
-    cap *= shape_dim;
-  }
-  data = std::vector<T>(cap);
+template <typename T>
+template <typename... Args>
+T SparseMultiArray<T>::at(Args... args) const {
+  /**
+   * Getter for an arbitrary number of dimensions. If the element has not been
+   * stored, a default-constructed element is returned, as it would be by a
+   * dense MultiArray.
+   *
+   * @param args Indices of the dimensions
+   */
+
+  const auto it = data.find(get_index(args...));
+  return it == data.end() ? T() : it->second;
 }
 } // namespace cda_rail
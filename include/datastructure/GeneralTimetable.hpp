@@ -482,6 +482,16 @@ public:
     return train_list.editable_tr(name);
   };
 
+  T& editable_schedule(size_t index) {
+    if (!train_list.has_train(index)) {
+      throw exceptions::TrainNotExistentException(index);
+    }
+    return schedules.at(index);
+  };
+  T& editable_schedule(const std::string& train_name) {
+    return editable_schedule(train_list.get_train_index(train_name));
+  };
+
   void add_station(const std::string& name) { station_list.add_station(name); };
 
   template <typename StationType = std::string, typename... Args>
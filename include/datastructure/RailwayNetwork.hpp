@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <memory_resource>
 #include <numeric>
 #include <optional>
 #include <string>
@@ -75,6 +76,14 @@ private:
   std::unordered_map<std::size_t, std::pair<size_t, double>>
       new_edge_to_old_edge_after_transform;
 
+  // Per-edge topology annotations. Reverse edges are kept up to date on every
+  // change. Unbreakable sections are recomputed by update_edge_annotations()
+  // and only used as long as they are up to date.
+  std::vector<std::optional<size_t>>  reverse_edge_indices;
+  std::vector<std::optional<size_t>>  unbreakable_section_indices;
+  std::vector<cda_rail::index_vector> edge_unbreakable_sections;
+  bool                                unbreakable_sections_up_to_date = true;
+
   void        read_graphml(const std::filesystem::path& p);
   static void get_keys(tinyxml2::XMLElement* graphml_body,
                        std::string& breakable, std::string& length,
@@ -132,6 +141,12 @@ private:
                              std::optional<size_t>  exit_node           = {},
                              cda_rail::index_vector edges_used_by_train = {},
                              bool return_successors_if_zero = false) const;
+  [[nodiscard]] std::pmr::vector<std::pmr::vector<size_t>>
+  all_routes_of_given_length_from_edge(
+      size_t e_0, double desired_length, bool reverse_direction,
+      std::optional<size_t>         exit_node,
+      const cda_rail::index_vector& edges_used_by_train,
+      std::pmr::memory_resource*    resource) const;
 
   [[nodiscard]] size_t other_vertex(size_t e, size_t v) const {
     return get_edge(e).source == v ? get_edge(e).target : get_edge(e).source;
@@ -522,6 +537,7 @@ public:
   [[nodiscard]] cda_rail::index_vector
                      get_unbreakable_section_containing_edge(size_t e) const;
   [[nodiscard]] bool is_on_same_unbreakable_section(size_t e1, size_t e2) const;
+  void               update_edge_annotations();
 
   [[nodiscard]] cda_rail::index_vector
   inverse_edges(const cda_rail::index_vector& edge_indices) const {
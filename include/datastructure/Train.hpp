@@ -86,6 +86,8 @@ public:
     return (index < trains.size());
   };
 
+  [[nodiscard]] std::vector<size_t> get_train_classes() const;
+
   void export_trains(const std::string& path) const {
     export_trains(std::filesystem::path(path));
   };
@@ -4,6 +4,7 @@
 #include "Definitions.hpp"
 #include "EOMHelper.hpp"
 #include "GeneralProblemInstance.hpp"
+#include "SolutionWriter.hpp"
 #include "VSSGenerationTimetable.hpp"
 #include "datastructure/GeneralTimetable.hpp"
 #include "datastructure/RailwayNetwork.hpp"
@@ -245,6 +246,10 @@ public:
                                train_weights, [](double w) { return w >= 0; }));
   };
 
+  // Groups of at least two trains that can be interchanged in every solution
+  [[nodiscard]] std::vector<cda_rail::index_vector>
+  get_symmetric_train_groups() const;
+
   [[nodiscard]] double get_approximate_leaving_time(size_t train) const;
   [[nodiscard]] double get_maximal_leaving_time(size_t train, double v) const;
   [[nodiscard]] double get_minimal_leaving_time(size_t train, double v) const;
@@ -286,6 +291,44 @@ class SolGeneralPerformanceOptimizationInstance
     }
   };
 
+  void export_solution_helper(const std::filesystem::path& p,
+                              bool export_instance, bool binary) const {
+    if (!check_consistency()) {
+      throw exceptions::ConsistencyException();
+    }
+
+    if (!is_directory_and_create(p / "solution")) {
+      throw exceptions::ExportException("Could not create directory " +
+                                        p.string());
+    }
+
+    SolGeneralProblemInstanceWithScheduleAndRoutes<
+        T>::export_general_solution_data_with_routes(p, export_instance, true);
+
+    // Trajectories are streamed, since they can be large
+    const auto& train_list = this->instance.get_train_list();
+    if (binary) {
+      write_trajectory_binary(p / "solution" / "trajectories.bin", train_list,
+                              train_pos, train_speed);
+    } else {
+      write_trajectory_json(p / "solution" / "train_pos.json", train_list,
+                            train_pos);
+      write_trajectory_json(p / "solution" / "train_speed.json", train_list,
+                            train_speed);
+    }
+
+    // NOLINTNEXTLINE(misc-const-correctness)
+    json train_routed_json;
+    for (size_t tr_id = 0; tr_id < train_list.size(); ++tr_id) {
+      train_routed_json[train_list.get_train(tr_id).name] =
+          train_routed.at(tr_id);
+    }
+
+    std::ofstream train_routed_file(p / "solution" / "train_routed.json");
+    train_routed_file << train_routed_json << '\n';
+    train_routed_file.close();
+  };
+
 public:
   SolGeneralPerformanceOptimizationInstance() = default;
   explicit SolGeneralPerformanceOptimizationInstance(const T& instance)
@@ -329,25 +372,33 @@ public:
 
     this->initialize_vectors();
 
-    // Read train_pos
-    std::ifstream train_pos_file(p / "solution" / "train_pos.json");
-    json          train_pos_json = json::parse(train_pos_file);
-    for (const auto& [tr_name, tr_pos_json] : train_pos_json.items()) {
-      for (const auto& [idx, pos_pair] : tr_pos_json.items()) {
-        const auto [t, pos] =
-            pos_pair.template get<std::pair<double, double>>();
-        this->add_train_pos(tr_name, t, pos);
+    if (!std::filesystem::exists(p / "solution" / "train_pos.json") &&
+        std::filesystem::exists(p / "solution" / "trajectories.bin")) {
+      // Read train_pos and train_speed exported by export_solution_binary
+      std::tie(train_pos, train_speed) =
+          read_trajectory_binary(p / "solution" / "trajectories.bin",
+                                 this->instance.get_train_list());
+    } else {
+      // Read train_pos
+      std::ifstream train_pos_file(p / "solution" / "train_pos.json");
+      json          train_pos_json = json::parse(train_pos_file);
+      for (const auto& [tr_name, tr_pos_json] : train_pos_json.items()) {
+        for (const auto& [idx, pos_pair] : tr_pos_json.items()) {
+          const auto [t, pos] =
+              pos_pair.template get<std::pair<double, double>>();
+          this->add_train_pos(tr_name, t, pos);
+        }
       }
-    }
 
-    // Read train_speed
-    std::ifstream train_speed_file(p / "solution" / "train_speed.json");
-    json          train_speed_json = json::parse(train_speed_file);
-    for (const auto& [tr_name, tr_speed_json] : train_speed_json.items()) {
-      for (const auto& [idx, speed_pair] : tr_speed_json.items()) {
-        const auto [t, speed] =
-            speed_pair.template get<std::pair<double, double>>();
-        this->add_train_speed(tr_name, t, speed);
+      // Read train_speed
+      std::ifstream train_speed_file(p / "solution" / "train_speed.json");
+      json          train_speed_json = json::parse(train_speed_file);
+      for (const auto& [tr_name, tr_speed_json] : train_speed_json.items()) {
+        for (const auto& [idx, speed_pair] : tr_speed_json.items()) {
+          const auto [t, speed] =
+              speed_pair.template get<std::pair<double, double>>();
+          this->add_train_speed(tr_name, t, speed);
+        }
       }
     }
 
@@ -695,42 +746,21 @@ public:
      * the solution
      */
 
-    if (!check_consistency()) {
-      throw exceptions::ConsistencyException();
-    }
-
-    if (!is_directory_and_create(p / "solution")) {
-      throw exceptions::ExportException("Could not create directory " +
-                                        p.string());
-    }
-
-    SolGeneralProblemInstanceWithScheduleAndRoutes<
-        T>::export_general_solution_data_with_routes(p, export_instance, true);
-
-    // NOLINTBEGIN(misc-const-correctness)
-    json train_pos_json;
-    json train_speed_json;
-    json train_routed_json;
-    // NOLINTEND(misc-const-correctness)
-    for (size_t tr_id = 0; tr_id < this->instance.get_train_list().size();
-         ++tr_id) {
-      const auto& train = this->instance.get_train_list().get_train(tr_id);
-      train_pos_json[train.name]    = train_pos.at(tr_id);
-      train_speed_json[train.name]  = train_speed.at(tr_id);
-      train_routed_json[train.name] = train_routed.at(tr_id);
-    }
-
-    std::ofstream train_pos_file(p / "solution" / "train_pos.json");
-    train_pos_file << train_pos_json << '\n';
-    train_pos_file.close();
-
-    std::ofstream train_speed_file(p / "solution" / "train_speed.json");
-    train_speed_file << train_speed_json << '\n';
-    train_speed_file.close();
+    export_solution_helper(p, export_instance, false);
+  };
+  void export_solution_binary(const std::filesystem::path& p,
+                              bool export_instance) const {
+    /**
+     * Same as export_solution, but train_pos and train_speed are exported to
+     * the compact columnar file p / solution / trajectories.bin instead of
+     * json. The solution can be imported as usual.
+     *
+     * @param p the path to the folder where the solution should be exported
+     * @param export_instance whether the instance should be exported next to
+     * the solution
+     */
 
-    std::ofstream train_routed_file(p / "solution" / "train_routed.json");
-    train_routed_file << train_routed_json << '\n';
-    train_routed_file.close();
+    export_solution_helper(p, export_instance, true);
   };
   [[nodiscard]] bool check_consistency() const override {
     if (!SolGeneralProblemInstanceWithScheduleAndRoutes<
@@ -110,6 +110,12 @@ public:
   Train& editable_tr(const std::string& name) {
     return timetable.editable_tr(name);
   };
+  auto& editable_schedule(size_t index) {
+    return timetable.editable_schedule(index);
+  };
+  auto& editable_schedule(const std::string& name) {
+    return timetable.editable_schedule(name);
+  };
 
   [[nodiscard]] bool is_forced_to_stop(const std::string& train_name,
                                        int                time) const {
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "datastructure/Train.hpp"
+
+#include <array>
+#include <filesystem>
+#include <map>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cda_rail::instances {
+
+// Streaming writers for solution files. Values are written to the output
+// stream directly from the solution data, no json DOM is built.
+void write_json_string(std::ostream& os, std::string_view str);
+void write_json_number(std::ostream& os, double value);
+
+// Writes {"<train name>": [[t, value], ...], ...} as used by train_pos.json
+// and train_speed.json
+void write_trajectory_json(
+    const std::filesystem::path& file, const TrainList& train_list,
+    const std::vector<std::map<double, double>>& trajectories);
+
+// Compact columnar trajectory format in native byte order:
+// magic, number of trains, and for every train its name followed by the
+// number of samples n, n times, n positions, and n speeds.
+constexpr std::array<char, 8> TRAJECTORY_BINARY_MAGIC = {'C', 'D', 'A', 'T',
+                                                         'R', 'J', '0', '1'};
+
+void write_trajectory_binary(
+    const std::filesystem::path& file, const TrainList& train_list,
+    const std::vector<std::map<double, double>>& train_pos,
+    const std::vector<std::map<double, double>>& train_speed);
+
+[[nodiscard]] std::pair<std::vector<std::map<double, double>>,
+                        std::vector<std::map<double, double>>>
+read_trajectory_binary(const std::filesystem::path& file,
+                       const TrainList&             train_list);
+
+} // namespace cda_rail::instances
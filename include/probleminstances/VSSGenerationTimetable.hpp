@@ -96,6 +96,9 @@ private:
   bool   postprocessed = false;
 
   void initialize_vectors();
+  void write_time_indexed_json(
+      const std::filesystem::path&            file,
+      const std::vector<std::vector<double>>& values) const;
 
 public:
   // Constructor
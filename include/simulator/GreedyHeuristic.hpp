@@ -1,17 +1,25 @@
 #pragma once
 
 #include "CustomExceptions.hpp"
+#include "Definitions.hpp"
 #include "GeneralSimulator.hpp"
 #include "GreedySimulator.hpp"
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace cda_rail::simulator {
 enum class BrakingTimeHeuristicType : std::uint8_t { Simple = 0 };
-enum class RemainingTimeHeuristicType : std::uint8_t { Zero = 0, Simple = 1 };
+enum class RemainingTimeHeuristicType : std::uint8_t {
+  Zero              = 0,
+  Simple            = 1,
+  PairwiseConflicts = 2
+};
 
 // Braking time heuristics for A*
 [[nodiscard]] double
@@ -33,43 +41,99 @@ braking_time_heuristic(BrakingTimeHeuristicType type, size_t tr,
       "This code should not have been reachable...");
 };
 
+// Travel times at maximum speed of the remaining legs of a train, i.e., to each
+// of its remaining stops and finally to its exit. std::nullopt if a remaining
+// stop has no stop tracks.
+using RemainingTravelTimes = std::optional<std::vector<double>>;
+
+[[nodiscard]] RemainingTravelTimes
+remaining_travel_times(size_t tr, const GreedySimulator& simulator);
+
+// Remaining travel times do not depend on exit times but only on the train,
+// its last edge, and the number of stops it has served. Hence, they can be
+// shared among all states of a search. Not thread-safe.
+class RemainingTimeHeuristicCache {
+private:
+  struct Key {
+    size_t tr;
+    size_t last_edge;
+    size_t stops_served;
+
+    bool operator==(const Key& other) const = default;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      // Based on boost::hash_combine implementation
+      size_t seed = 0;
+      for (const size_t v : {key.tr, key.last_edge, key.stops_served}) {
+        seed ^= std::hash<size_t>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      }
+      return seed;
+    }
+  };
+
+  std::unordered_map<Key, RemainingTravelTimes, KeyHash> travel_times_map;
+  size_t                                                 hits = 0;
+
+public:
+  [[nodiscard]] const RemainingTravelTimes&
+  travel_times(size_t tr, const GreedySimulator& simulator);
+
+  [[nodiscard]] size_t size() const { return travel_times_map.size(); };
+  [[nodiscard]] size_t get_hits() const { return hits; };
+};
+
 // Remaining time heuristics for A*
 [[nodiscard]] std::pair<bool, double> simple_remaining_time_heuristic(
     size_t tr, const GreedySimulator& simulator, double tr_exit_time,
     double braking_time_heuristic, bool late_stop_possible,
-    bool late_exit_possible, bool consider_earliest_exit);
+    bool late_exit_possible, bool consider_earliest_exit,
+    RemainingTimeHeuristicCache* cache = nullptr);
 
 [[nodiscard]] inline std::pair<bool, double>
 remaining_time_heuristic(RemainingTimeHeuristicType type, size_t tr,
                          const GreedySimulator& simulator, double tr_exit_time,
                          double braking_time_heuristic, bool late_stop_possible,
-                         bool late_exit_possible, bool consider_earliest_exit) {
+                         bool late_exit_possible, bool consider_earliest_exit,
+                         RemainingTimeHeuristicCache* cache = nullptr) {
   switch (type) {
   case RemainingTimeHeuristicType::Zero:
     return {true, 0.0};
   case RemainingTimeHeuristicType::Simple:
+  case RemainingTimeHeuristicType::PairwiseConflicts:
     return simple_remaining_time_heuristic(
         tr, simulator, tr_exit_time, braking_time_heuristic, late_stop_possible,
-        late_exit_possible, consider_earliest_exit);
+        late_exit_possible, consider_earliest_exit, cache);
   }
   // This should never be reached
   throw cda_rail::exceptions::ConsistencyException(
       "This code should not have been reachable...");
 };
 
+// Weighted lower bound on the delay of trains that have not yet been ordered
+// at their exit vertex due to the headway of this vertex. Trains follow all
+// trains already ordered at the vertex and pairs of them cannot exit closer
+// than the headway. tr_exit_estimates are lower bounds on all exit times.
+[[nodiscard]] double
+pairwise_exit_conflict_heuristic(const GreedySimulator&     simulator,
+                                 const SimulatorResults&    sim_results,
+                                 const std::vector<double>& tr_exit_estimates);
+
 [[nodiscard]] inline std::pair<bool, double>
 greedy_heuristic(BrakingTimeHeuristicType   braking_time_heuristic_type,
                  RemainingTimeHeuristicType remaining_time_heuristic_type,
                  size_t tr, const GreedySimulator& simulator,
                  double tr_exit_time, double braking_time,
                  double braking_distance, bool late_stop_possible,
-                 bool late_exit_possible, bool consider_earliest_exit) {
+                 bool late_exit_possible, bool consider_earliest_exit,
+                 RemainingTimeHeuristicCache* cache = nullptr) {
   const double bt_val =
       braking_time_heuristic(braking_time_heuristic_type, tr, simulator,
                              tr_exit_time, braking_time, braking_distance);
   const auto [feas, obj] = remaining_time_heuristic(
       remaining_time_heuristic_type, tr, simulator, tr_exit_time, bt_val,
-      late_stop_possible, late_exit_possible, consider_earliest_exit);
+      late_stop_possible, late_exit_possible, consider_earliest_exit, cache);
   return {feas, bt_val + obj};
 }
 
@@ -79,7 +143,8 @@ full_greedy_heuristic(BrakingTimeHeuristicType   braking_time_heuristic_type,
                       const GreedySimulator&     simulator,
                       const SimulatorResults&    sim_results,
                       bool late_stop_possible, bool late_exit_possible,
-                      bool consider_earliest_exit) {
+                      bool                         consider_earliest_exit,
+                      RemainingTimeHeuristicCache* cache = nullptr) {
   const auto train_count =
       simulator.get_instance()->get_timetable().get_train_list().size();
   if (sim_results.exit_times.size() != train_count ||
@@ -94,16 +159,24 @@ full_greedy_heuristic(BrakingTimeHeuristicType   braking_time_heuristic_type,
         "SimulatorResults indicate unsuccessful simulation, heuristic cannot "
         "be calculated.");
   }
-  bool   feas = true;
-  double obj  = 0.0;
+  bool                feas = true;
+  double              obj  = 0.0;
+  std::vector<double> tr_exit_estimates(train_count);
   for (size_t tr = 0; tr < train_count; ++tr) {
     const auto [feas_tr, obj_tr] = greedy_heuristic(
         braking_time_heuristic_type, remaining_time_heuristic_type, tr,
         simulator, sim_results.exit_times.at(tr),
         sim_results.braking_times.at(tr), sim_results.braking_distances.at(tr),
-        late_stop_possible, late_exit_possible, consider_earliest_exit);
+        late_stop_possible, late_exit_possible, consider_earliest_exit, cache);
     feas = feas && feas_tr;
     obj += simulator.get_instance()->get_train_weights().at(tr) * obj_tr;
+    tr_exit_estimates.at(tr) = sim_results.exit_times.at(tr) + obj_tr;
+  }
+  if (feas && obj < cda_rail::INF &&
+      remaining_time_heuristic_type ==
+          RemainingTimeHeuristicType::PairwiseConflicts) {
+    obj += pairwise_exit_conflict_heuristic(simulator, sim_results,
+                                            tr_exit_estimates);
   }
   return {feas, obj};
 };
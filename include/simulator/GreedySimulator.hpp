@@ -12,6 +12,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <map>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -48,6 +50,7 @@ class GreedySimulator_ScheduleFeasibility_Test;
 class GreedySimulator_ReverseEdgeMA_Test;
 class GreedySimulator_ExitVertexOrder_Test;
 class GreedySimulator_FutureSpeedRestrictionConstraintsAfterLeaving_Test;
+class GreedySimulator_SpeedLimitProfile_Test;
 #endif
 
 namespace cda_rail::simulator {
@@ -77,6 +80,7 @@ private:
   FRIEND_TEST(::GreedySimulator, ReverseEdgeMA);
   FRIEND_TEST(::GreedySimulator, ExitVertexOrder);
   FRIEND_TEST(::GreedySimulator, FutureSpeedRestrictionConstraintsAfterLeaving);
+  FRIEND_TEST(::GreedySimulator, SpeedLimitProfile);
 #endif
 
   struct MaAndMaxVResult {
@@ -86,6 +90,13 @@ private:
     double max_v_without_route_end;
   };
 
+  // Kinematics of a single train within one time step
+  struct TrainStep {
+    double v_1;                   // speed at the end of the time step
+    double v_1_without_route_end; // speed if the route end was not binding
+    double displacement;          // distance moved by the train's front
+  };
+
   enum class TTDOccupationType : std::uint8_t {
     OnlyOccupied,
     OnlyBehind,
@@ -93,6 +104,108 @@ private:
   };
   enum class DestinationType : std::uint8_t { None, Network, Station, Edge };
 
+  // Trajectory recording policies of simulate_with_options
+  struct NoTrajectoryRecorder {
+    void reserve(size_t /*n*/) {};
+    void record(size_t /*tr*/, int /*t*/, double /*pos*/, double /*vel*/) {};
+    [[nodiscard]] static std::vector<std::map<double, PosVel>>
+    extract(size_t /*num_tr*/) {
+      return {};
+    };
+  };
+
+  struct FlatTrajectoryRecorder {
+    struct Entry {
+      size_t tr;
+      int    t;
+      PosVel pos_vel;
+    };
+    std::vector<Entry> entries;
+
+    void reserve(size_t n) { entries.reserve(n); };
+    void record(size_t tr, int t, double pos, double vel) {
+      entries.push_back(
+          {.tr = tr, .t = t, .pos_vel = {.pos = pos, .vel = vel}});
+    };
+    [[nodiscard]] std::vector<std::map<double, PosVel>>
+    extract(size_t num_tr) const;
+  };
+
+  // Index of the trains currently occupying an edge. A train is stored on
+  // every edge of its route that is reached by the interval from its rear to
+  // its front plus braking distance. The entries of every edge are sorted by
+  // the rear position on the edge, hence, the nearest obstacle is found first.
+  class EdgeOccupancyIndex {
+  public:
+    struct Entry {
+      size_t tr;
+      double start; // position of the edge's source on the train's route
+      double end;   // position of the edge's target on the train's route
+      double rear;
+      double front;
+      double reach; // front plus braking distance
+
+      [[nodiscard]] bool is_occupied() const { return front > start + EPS; };
+      [[nodiscard]] double rear_on_edge() const {
+        return std::max(0.0, rear - start);
+      };
+      [[nodiscard]] double front_on_edge() const {
+        return std::min(end - start, front - start);
+      };
+    };
+
+    // Entries are frequently inserted and removed during a simulation, hence,
+    // all memory is taken from the given resource.
+    EdgeOccupancyIndex(size_t number_of_edges, size_t number_of_trains,
+                       std::pmr::memory_resource* resource =
+                           std::pmr::get_default_resource())
+        : entries(number_of_edges, resource),
+          indexed_edges(number_of_trains, resource) {};
+
+    void insert(size_t edge_id, const Entry& entry);
+    void remove(size_t tr);
+
+    [[nodiscard]] const std::pmr::vector<Entry>& on_edge(size_t edge_id) const {
+      return entries.at(edge_id);
+    };
+
+  private:
+    std::pmr::vector<std::pmr::vector<Entry>>  entries;
+    std::pmr::vector<std::pmr::vector<size_t>> indexed_edges;
+  };
+
+  // Speed limits along the route of a train. The most restrictive speed limit
+  // of consecutive route edges is obtained in constant time from a sparse
+  // table, which is built once per route.
+  class SpeedLimitProfile {
+  public:
+    std::vector<double> milestones;   // as returned by edge_milestones
+    std::vector<double> speed_limits; // maximal speed on every route edge
+
+    SpeedLimitProfile(std::vector<double> milestones,
+                      std::vector<double> speed_limits);
+
+    [[nodiscard]] size_t number_of_edges() const {
+      return speed_limits.size();
+    };
+    [[nodiscard]] double route_length() const {
+      return milestones.empty() ? 0.0 : milestones.back();
+    };
+
+    // First route edge ending after pos
+    [[nodiscard]] size_t first_edge_ending_after(double pos) const;
+    // Most restrictive speed limit on route edges first, ..., last - 1
+    [[nodiscard]] double min_speed_limit(size_t first, size_t last) const;
+
+  private:
+    std::vector<std::vector<double>> sparse_table;
+  };
+
+  template <bool LateEntryPossible, bool LateExitPossible,
+            bool LateStopPossible, bool LimitSpeedByLeavingEdges,
+            bool SaveTrajectories>
+  [[nodiscard]] SimulatorResults simulate_with_options(int dt) const;
+
   // private simulator helper functions
   [[nodiscard]] std::pair<bool, std::unordered_set<size_t>>
   get_entering_trains(int t, const std::unordered_set<size_t>& tr_present,
@@ -145,27 +258,71 @@ private:
     return is_on_ttd(tr, ttd, pos, TTDOccupationType::OnlyBehind);
   };
 
+  void update_occupancy(EdgeOccupancyIndex& occupancy, size_t tr,
+                        const std::pair<double, double>& pos, double v,
+                        const std::vector<double>& milestones) const;
+
+  [[nodiscard]] EdgeOccupancyIndex build_occupancy_index(
+      const std::vector<std::pair<double, double>>& train_positions,
+      const std::vector<double>&                    train_velocities,
+      const std::unordered_set<size_t>&             trains_in_network) const;
+
+  [[nodiscard]] bool is_ok_to_enter(
+      size_t tr, const std::vector<std::pair<double, double>>& train_positions,
+      const std::unordered_set<size_t>& trains_in_network,
+      const EdgeOccupancyIndex&         occupancy) const;
+
+  // Overloads building the occupancy index from scratch. The routed trains
+  // per edge are implied by train_edges.
   [[nodiscard]] bool is_ok_to_enter(
       size_t tr, const std::vector<std::pair<double, double>>& train_positions,
-      const std::vector<double>&                     train_velocities,
-      const std::unordered_set<size_t>&              trains_in_network,
-      const std::vector<std::unordered_set<size_t>>& tr_on_edges) const;
+      const std::vector<double>&        train_velocities,
+      const std::unordered_set<size_t>& trains_in_network,
+      const std::vector<std::unordered_set<size_t>>& /*tr_on_edges*/) const {
+    return is_ok_to_enter(tr, train_positions, trains_in_network,
+                          build_occupancy_index(train_positions,
+                                                train_velocities,
+                                                trains_in_network));
+  };
 
   [[nodiscard]] static double max_displacement(const Train& train, double v_0,
                                                int dt);
 
   [[nodiscard]] double get_absolute_distance_ma(
       size_t tr, double max_displacement,
-      const std::vector<std::pair<double, double>>&  train_positions,
-      const std::vector<double>&                     train_velocities,
-      const std::unordered_set<size_t>&              trains_in_network,
-      const std::unordered_set<size_t>&              trains_left,
-      const std::vector<std::unordered_set<size_t>>& tr_on_edges) const;
+      const std::vector<std::pair<double, double>>& train_positions,
+      const std::unordered_set<size_t>&             trains_in_network,
+      const std::unordered_set<size_t>&             trains_left,
+      const EdgeOccupancyIndex&                     occupancy) const;
+
+  [[nodiscard]] double get_absolute_distance_ma(
+      size_t tr, double max_displacement,
+      const std::vector<std::pair<double, double>>& train_positions,
+      const std::vector<double>&                    train_velocities,
+      const std::unordered_set<size_t>&             trains_in_network,
+      const std::unordered_set<size_t>&             trains_left,
+      const std::vector<std::unordered_set<size_t>>& /*tr_on_edges*/) const {
+    return get_absolute_distance_ma(
+        tr, max_displacement, train_positions, trains_in_network, trains_left,
+        build_occupancy_index(train_positions, train_velocities,
+                              trains_in_network));
+  };
+
+  [[nodiscard]] SpeedLimitProfile speed_limit_profile(size_t tr) const;
+
+  [[nodiscard]] MaAndMaxVResult get_future_max_speed_constraints(
+      size_t tr, const Train& train, double pos, double v_0,
+      double max_displacement, int dt, bool also_limit_by_leaving_edges,
+      const SpeedLimitProfile& profile) const;
 
   [[nodiscard]] MaAndMaxVResult
   get_future_max_speed_constraints(size_t tr, const Train& train, double pos,
                                    double v_0, double max_displacement, int dt,
-                                   bool also_limit_by_leaving_edges) const;
+                                   bool also_limit_by_leaving_edges) const {
+    return get_future_max_speed_constraints(
+        tr, train, pos, v_0, max_displacement, dt, also_limit_by_leaving_edges,
+        speed_limit_profile(tr));
+  };
 
   [[nodiscard]] double
   get_exit_vertex_order_ma(size_t tr, const Train& train, double pos,
@@ -181,9 +338,17 @@ private:
   [[nodiscard]] static double
   get_next_stop_ma(double max_displacement, double pos, double next_stop_pos);
 
+  [[nodiscard]] double
+  get_max_speed_exit_headway(size_t tr, const Train& train, double pos,
+                             double v_0, int h, int dt,
+                             const SpeedLimitProfile& profile) const;
+
   [[nodiscard]] double get_max_speed_exit_headway(size_t tr, const Train& train,
                                                   double pos, double v_0, int h,
-                                                  int dt) const;
+                                                  int dt) const {
+    return get_max_speed_exit_headway(tr, train, pos, v_0, h, dt,
+                                      speed_limit_profile(tr));
+  };
 
   [[nodiscard]] static std::pair<bool, double>
   time_to_exit_objective(double v_0, double v_1, double v_e, double s, double a,
@@ -195,16 +360,45 @@ private:
                   const std::vector<std::pair<double, double>>& train_positions,
                   const std::unordered_set<size_t>& trains_in_network,
                   const std::unordered_set<size_t>& trains_left,
-                  const std::vector<std::unordered_set<size_t>>& tr_on_edges,
+                  const EdgeOccupancyIndex&         occupancy,
+                  const SpeedLimitProfile&          profile,
                   bool also_limit_speed_by_leaving_edges) const;
 
+  [[nodiscard]] MaAndMaxVResult get_ma_and_maxv(
+      size_t tr, const std::vector<double>& train_velocities,
+      std::optional<size_t> next_stop, int h, int dt,
+      const std::vector<std::pair<double, double>>& train_positions,
+      const std::unordered_set<size_t>&             trains_in_network,
+      const std::unordered_set<size_t>&             trains_left,
+      const std::vector<std::unordered_set<size_t>>& /*tr_on_edges*/,
+      bool also_limit_speed_by_leaving_edges) const {
+    return get_ma_and_maxv(tr, train_velocities, next_stop, h, dt,
+                           train_positions, trains_in_network, trains_left,
+                           build_occupancy_index(train_positions,
+                                                 train_velocities,
+                                                 trains_in_network),
+                           speed_limit_profile(tr),
+                           also_limit_speed_by_leaving_edges);
+  };
+
   [[nodiscard]] static double get_v1_from_ma(double v_0, double ma, double d,
                                              int dt);
 
+  [[nodiscard]] static double move_distance(double v_0, double v_1, double ma,
+                                            int dt);
+
+  [[nodiscard]] static TrainStep train_step(double                 v_0,
+                                            const MaAndMaxVResult& ma_data,
+                                            double d, int dt);
+
   [[nodiscard]] static bool
   move_train(size_t tr, double v_0, double v_1, double ma, int dt,
              std::vector<std::pair<double, double>>& train_positions);
 
+  static void
+  update_rear_positions(std::vector<std::pair<double, double>>& train_positions,
+                        const std::vector<double>& train_lengths);
+
   void update_rear_positions(
       std::vector<std::pair<double, double>>& train_positions) const;
 
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cda_rail::solver {
+
+class SharedIncumbent {
+  /**
+   * Thread-safe exchange of incumbents and bounds between solvers that run
+   * concurrently on the same instance, e.g., within a portfolio or between
+   * VSS budget levels. All solvers sharing an object have to use the same
+   * objective, e.g., weighted sums of exit times (as in the A* solver) for
+   * moving block routing. Routes are stored by vertex names, so that they are
+   * independent of a discretization of the network.
+   */
+public:
+  using NamedRoute = std::vector<std::pair<std::string, std::string>>;
+
+private:
+  mutable std::mutex      shared_mutex;
+  double                  upper_bound    = INF;
+  double                  lower_bound    = -INF;
+  std::vector<NamedRoute> routes         = {};
+  size_t                  routes_version = 0;
+  std::atomic<bool>       stop_requested = false;
+
+public:
+  bool update_upper_bound(double                  obj,
+                          std::vector<NamedRoute> new_routes = {}) {
+    // Returns true if obj improves the shared incumbent
+    const std::lock_guard<std::mutex> lock(shared_mutex);
+    if (obj >= upper_bound - EPS) {
+      return false;
+    }
+    upper_bound = obj;
+    if (!new_routes.empty()) {
+      routes = std::move(new_routes);
+      routes_version++;
+    }
+    return true;
+  };
+  void update_lower_bound(double bound) {
+    const std::lock_guard<std::mutex> lock(shared_mutex);
+    lower_bound = std::max(lower_bound, bound);
+  };
+
+  [[nodiscard]] double get_upper_bound() const {
+    const std::lock_guard<std::mutex> lock(shared_mutex);
+    return upper_bound;
+  };
+  [[nodiscard]] double get_lower_bound() const {
+    const std::lock_guard<std::mutex> lock(shared_mutex);
+    return lower_bound;
+  };
+  [[nodiscard]] std::pair<size_t, std::vector<NamedRoute>>
+  get_routes() const {
+    // Version 0 means that no routes have been shared yet
+    const std::lock_guard<std::mutex> lock(shared_mutex);
+    return {routes_version, routes};
+  };
+
+  void               request_stop() { stop_requested = true; };
+  [[nodiscard]] bool is_stop_requested() const { return stop_requested; };
+};
+
+} // namespace cda_rail::solver
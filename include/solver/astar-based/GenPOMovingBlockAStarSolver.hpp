@@ -6,13 +6,17 @@
 #include "simulator/GreedyHeuristic.hpp"
 #include "simulator/GreedySimulator.hpp"
 #include "solver/GeneralSolver.hpp"
+#include "solver/SharedIncumbent.hpp"
 
 // NOLINTNEXTLINE(misc-include-cleaner)
 #include "gtest/gtest_prod.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
 #include <queue>
 #include <string>
@@ -33,6 +37,8 @@
 class GenPOMovingBlockAStarSolver;
 class GenPOMovingBlockAStarSolver_NextStates_Test;
 class GenPOMovingBlockAStarSolver_NextStatesTTD_Test;
+class GenPOMovingBlockAStarSolver_CanonicalState_Test;
+class GenPOMovingBlockAStarSolver_StateActions_Test;
 #endif
 
 namespace cda_rail::solver::astar_based {
@@ -58,6 +64,20 @@ struct SolverStrategyMBAStar {
       simulator::RemainingTimeHeuristicType::Simple;
   NextStateStrategy next_state_strategy    = NextStateStrategy::SingleEdge;
   bool              consider_earliest_exit = true;
+  // Successors are screened with this coarser time step and only simulated
+  // with ModelDetail::dt once they are popped. Disabled if not larger than dt.
+  // Screening is a heuristic, solutions are only reported as feasible.
+  int screening_dt = 0;
+  // If larger than 1, the state space is partitioned by hash among this many
+  // worker threads (HDA*). screening_dt is only used by the sequential search.
+  size_t num_threads = 1;
+  // States that only differ by a permutation of interchangeable trains, which
+  // keeps the order in which trains are simulated, are searched only once
+  bool symmetry_reduction = true;
+  // Actions of different trains that commute are only taken in one order
+  // (sleep sets), i.e., the other interleaving is not generated. Only used by
+  // the sequential search.
+  bool partial_order_reduction = false;
 };
 
 struct GreedySimulatorState {
@@ -82,6 +102,30 @@ struct GreedySimulatorState {
     return this_obj > other_obj;
   }
 };
+
+struct StateAction {
+  // Transition of a single train between two states
+  size_t                 train;
+  cda_rail::index_vector new_edges;
+  std::vector<double>    new_stop_positions;
+  // Sections and vertices whose orders the train is appended to
+  cda_rail::index_vector ttd_sections;
+  cda_rail::index_vector vertices;
+
+  bool operator==(const StateAction& other) const = default;
+
+  [[nodiscard]] bool is_independent_of(const StateAction& other) const {
+    // Independent actions lead to the same state in either order
+    const auto disjoint = [](const auto& a, const auto& b) {
+      return std::ranges::none_of(
+          a, [&b](const auto& x) { return std::ranges::contains(b, x); });
+    };
+    return train != other.train &&
+           disjoint(ttd_sections, other.ttd_sections) &&
+           disjoint(vertices, other.vertices) &&
+           disjoint(new_edges, other.new_edges);
+  }
+};
 } // namespace cda_rail::solver::astar_based
 
 namespace std {
@@ -139,6 +183,8 @@ private:
 #if TEST_FRIENDS
   FRIEND_TEST(::GenPOMovingBlockAStarSolver, NextStates);
   FRIEND_TEST(::GenPOMovingBlockAStarSolver, NextStatesTTD);
+  FRIEND_TEST(::GenPOMovingBlockAStarSolver, CanonicalState);
+  FRIEND_TEST(::GenPOMovingBlockAStarSolver, StateActions);
 #endif
 
   using StateObjectivePair =
@@ -159,10 +205,60 @@ private:
       std::priority_queue<StateObjectivePair, std::vector<StateObjectivePair>,
                           CompareByObjective>;
 
-  [[nodiscard]] static std::unordered_set<GreedySimulatorState>
-  next_states_single_edge(const simulator::GreedySimulator& simulator);
-  [[nodiscard]] static std::unordered_set<GreedySimulatorState>
-  next_states_next_ttd(const simulator::GreedySimulator& simulator);
+  // Incumbents and bounds exchanged with concurrently running solvers
+  std::shared_ptr<SharedIncumbent> shared_incumbent;
+
+  // Groups of interchangeable trains, empty if symmetry reduction is disabled
+  std::vector<cda_rail::index_vector> symmetric_train_groups;
+
+  // Statistics of the last search
+  size_t num_expansions       = 0;
+  size_t num_generated_states = 0;
+  size_t num_simulations      = 0;
+
+  void publish_incumbent(double obj, const GreedySimulatorState& state) const;
+  void publish_optimality_proof(double lower_bound) const;
+
+  [[nodiscard]] GreedySimulatorState
+  canonical_state(const GreedySimulatorState& state) const;
+
+  [[nodiscard]] static StateAction
+  state_action(const GreedySimulatorState& state,
+               const GreedySimulatorState& next_state);
+
+  struct HashDistributedSearchResult {
+    bool                 exhausted           = false;
+    bool                 pruned_by_shared_ub = false;
+    size_t               expansions          = 0;
+    size_t               generated_states    = 0;
+    size_t               simulations         = 0;
+    double               best_obj            = INF;
+    GreedySimulatorState best_state;
+  };
+
+  [[nodiscard]] HashDistributedSearchResult
+  hash_distributed_search(const ModelDetail&           model_detail_input,
+                          const SolverStrategyMBAStar& solver_strategy_input,
+                          int                          time_limit,
+                          const GreedySimulatorState&  init_state);
+
+  // Next states only live until the expansion is finished, hence, the set is
+  // allocated from a resource released afterwards. Actions in sleep_set are
+  // not generated (partial order reduction).
+  [[nodiscard]] static std::pmr::unordered_set<GreedySimulatorState>
+  next_states_single_edge(const simulator::GreedySimulator& simulator,
+                          std::pmr::memory_resource*        resource =
+                              std::pmr::get_default_resource(),
+                          const std::vector<StateAction>& sleep_set = {});
+  [[nodiscard]] static std::pmr::unordered_set<GreedySimulatorState>
+  next_states_next_ttd(const simulator::GreedySimulator& simulator,
+                       std::pmr::memory_resource*        resource =
+                           std::pmr::get_default_resource(),
+                       const std::vector<StateAction>& sleep_set = {});
+  [[nodiscard]] static bool
+  is_asleep(const std::vector<StateAction>& sleep_set, size_t tr,
+            const cda_rail::index_vector& new_edges,
+            const std::vector<double>&    new_stop_positions);
 
   static void next_state_ttd_helper(size_t tr, GreedySimulatorState& state,
                                     const simulator::GreedySimulator& simulator,
@@ -170,14 +266,17 @@ private:
   static void
   next_state_exit_vertex_helper(size_t tr, GreedySimulatorState& state,
                                 const simulator::GreedySimulator& simulator);
-  [[nodiscard]] static std::unordered_set<GreedySimulatorState>
+  [[nodiscard]] static std::pmr::unordered_set<GreedySimulatorState>
   next_states(const simulator::GreedySimulator& simulator,
-              const NextStateStrategy&          next_state_strategy_input) {
+              const NextStateStrategy&          next_state_strategy_input,
+              std::pmr::memory_resource*        resource =
+                  std::pmr::get_default_resource(),
+              const std::vector<StateAction>& sleep_set = {}) {
     switch (next_state_strategy_input) {
     case NextStateStrategy::SingleEdge:
-      return next_states_single_edge(simulator);
+      return next_states_single_edge(simulator, resource, sleep_set);
     case NextStateStrategy::NextTTD:
-      return next_states_next_ttd(simulator);
+      return next_states_next_ttd(simulator, resource, sleep_set);
     default:
       throw cda_rail::exceptions::ConsistencyException(
           "Unknown next state strategy.");
@@ -214,6 +313,21 @@ public:
 
   ~GenPOMovingBlockAStarSolver() override = default;
 
+  void set_shared_incumbent(std::shared_ptr<SharedIncumbent> incumbent) {
+    shared_incumbent = std::move(incumbent);
+  };
+
+  // Number of expanded, generated, and simulated states of the last solve
+  [[nodiscard]] size_t get_number_of_expansions() const {
+    return num_expansions;
+  };
+  [[nodiscard]] size_t get_number_of_generated_states() const {
+    return num_generated_states;
+  };
+  [[nodiscard]] size_t get_number_of_simulations() const {
+    return num_simulations;
+  };
+
   using GeneralSolver::solve;
   [[nodiscard]] instances::SolGeneralPerformanceOptimizationInstance<
       instances::GeneralPerformanceOptimizationInstance>
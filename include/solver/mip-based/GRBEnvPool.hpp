@@ -0,0 +1,66 @@
+#pragma once
+
+#include "gurobi_c++.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cda_rail::solver::mip_based {
+
+class GRBEnvPool {
+  /**
+   * Process-wide pool of started Gurobi environments. Starting an environment
+   * (including the license checkout) is expensive, hence, solvers borrow an
+   * environment for the duration of a solve and return it afterwards.
+   * Borrowed environments are used by exactly one solver at a time, the pool
+   * itself is thread-safe.
+   */
+private:
+  mutable std::mutex                   pool_mutex;
+  std::vector<std::unique_ptr<GRBEnv>> available_envs;
+  size_t                               max_pool_size         = 16;
+  size_t                               num_created_envs      = 0;
+  size_t                               num_reused_envs       = 0;
+  bool                                 reset_params_on_reuse = true;
+
+  GRBEnvPool() = default;
+
+  void release(GRBEnv* env);
+
+public:
+  GRBEnvPool(const GRBEnvPool&)            = delete;
+  GRBEnvPool& operator=(const GRBEnvPool&) = delete;
+  GRBEnvPool(GRBEnvPool&&)                 = delete;
+  GRBEnvPool& operator=(GRBEnvPool&&)      = delete;
+  ~GRBEnvPool()                            = default;
+
+  [[nodiscard]] static GRBEnvPool& get_instance();
+
+  // The returned environment is given back to the pool once the last copy of
+  // the pointer is destroyed. Models created from it must be destroyed first.
+  [[nodiscard]] std::shared_ptr<GRBEnv> acquire();
+
+  void clear();
+  void set_max_pool_size(size_t max_size);
+  void set_reset_params_on_reuse(bool reset_params) {
+    const std::lock_guard<std::mutex> lock(pool_mutex);
+    reset_params_on_reuse = reset_params;
+  };
+
+  [[nodiscard]] size_t get_number_of_available_environments() const {
+    const std::lock_guard<std::mutex> lock(pool_mutex);
+    return available_envs.size();
+  };
+  [[nodiscard]] size_t get_number_of_created_environments() const {
+    const std::lock_guard<std::mutex> lock(pool_mutex);
+    return num_created_envs;
+  };
+  [[nodiscard]] size_t get_number_of_reused_environments() const {
+    const std::lock_guard<std::mutex> lock(pool_mutex);
+    return num_reused_envs;
+  };
+};
+
+} // namespace cda_rail::solver::mip_based
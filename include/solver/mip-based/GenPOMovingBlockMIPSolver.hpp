@@ -6,6 +6,7 @@
 #include "gurobi_c++.h"
 #include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
 #include "solver/GeneralSolver.hpp"
+#include "solver/SharedIncumbent.hpp"
 #include "solver/mip-based/GeneralMIPSolver.hpp"
 
 // NOLINTNEXTLINE(misc-include-cleaner)
@@ -13,9 +14,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -32,6 +37,8 @@
 #if TEST_FRIENDS
 class GenPOMovingBlockMIPSolver;
 class GenPOMovingBlockMIPSolver_PrivateFillFunctions_Test;
+class GenPOMovingBlockMIPSolver_SharedRoutesOnDiscretizedNetwork_Test;
+class GenPOMovingBlockMIPSolver_NoTinyCoefficients_Test;
 #endif
 
 namespace cda_rail::solver::mip_based {
@@ -43,6 +50,8 @@ struct ModelDetail {
       VelocityRefinementStrategy::MinOneStep;
   bool simplify_headway_constraints          = false;
   bool strengthen_vertex_headway_constraints = false;
+
+  bool operator==(const ModelDetail& other) const = default;
 };
 
 enum class LazyConstraintSelectionStrategy : std::uint8_t {
@@ -66,7 +75,60 @@ struct SolverStrategyMovingBlock {
   LazyTrainSelectionStrategy lazy_train_selection_strategy =
       LazyTrainSelectionStrategy::OnlyAdjacent;
   double abs_mip_gap = 10;
+  bool   use_lazy_cut_pool =
+      true; // Skip lazy constraints that were already added and are satisfied
+  size_t promote_lazy_cuts_after =
+      0; // If > 0, cuts separated at least this often become hard constraints
+         // in subsequent solves with the same model detail
+  bool retain_model =
+      false; // Keep the model after solving for incremental re-solves
+  bool parallel_model_building =
+      false; // Build independent constraint families concurrently
+  bool break_train_symmetries =
+      false; // Interchangeable trains enter in the order of their indices
+};
+
+enum class LazyConstraintFamily : std::uint8_t {
+  VertexHeadway         = 0,
+  EdgeHeadway           = 1,
+  TTDHeadway            = 2,
+  SimplifiedEdgeHeadway = 3,
+  SimplifiedTTDHeadway  = 4,
+  ReverseEdge           = 5
+};
+
+struct LazyCutKey {
+  LazyConstraintFamily family;
+  // Starts with the two trains whose variables appear in the constraint
+  cda_rail::index_vector indices;
+
+  bool operator==(const LazyCutKey& other) const = default;
 };
+} // namespace cda_rail::solver::mip_based
+
+namespace std {
+template <> struct hash<cda_rail::solver::mip_based::LazyCutKey> {
+  size_t operator()(const cda_rail::solver::mip_based::LazyCutKey& key) const {
+    // Based on boost::hash_combine implementation
+
+    size_t seed         = 0;
+    auto   hash_combine = [&seed](size_t h) {
+      seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+
+    hash_combine(
+        std::hash<std::uint8_t>{}(static_cast<std::uint8_t>(key.family)));
+    hash_combine(std::hash<size_t>{}(key.indices.size()));
+    for (const size_t idx : key.indices) {
+      hash_combine(std::hash<size_t>{}(idx));
+    }
+
+    return seed;
+  }
+};
+} // namespace std
+
+namespace cda_rail::solver::mip_based {
 
 class GenPOMovingBlockMIPSolver
     : public GeneralMIPSolver<
@@ -76,6 +138,8 @@ class GenPOMovingBlockMIPSolver
 private:
 #if TEST_FRIENDS
   FRIEND_TEST(::GenPOMovingBlockMIPSolver, PrivateFillFunctions);
+  FRIEND_TEST(::GenPOMovingBlockMIPSolver, SharedRoutesOnDiscretizedNetwork);
+  FRIEND_TEST(::GenPOMovingBlockMIPSolver, NoTinyCoefficients);
 #endif
 
   SolutionSettingsMovingBlock         solution_settings = {};
@@ -87,14 +151,78 @@ private:
   size_t                              num_ttd           = 0;
   int                                 max_t             = 0;
   std::vector<cda_rail::index_vector> ttd_sections;
+
+  // Per-train view into tables that are shared by all trains of a class
+  template <typename T> class SharedEntries {
+  private:
+    std::vector<std::shared_ptr<const T>> entries;
+
+  public:
+    void reserve(size_t n) { entries.reserve(n); };
+    void push_back(std::shared_ptr<const T> entry) {
+      entries.push_back(std::move(entry));
+    };
+    [[nodiscard]] const T& at(size_t i) const { return *entries.at(i); };
+    [[nodiscard]] size_t   size() const { return entries.size(); };
+  };
+  using StopData =
+      std::vector<std::pair<size_t, std::vector<cda_rail::index_vector>>>;
+
+  // Train classes:
+  // Trains with identical physics and identical usable edges share their
+  // preprocessed data. For every class, the first train and its usable edges
+  // are stored.
+  std::vector<size_t>                 train_classes;
+  std::vector<size_t>                 train_class_representatives;
+  std::vector<cda_rail::index_vector> train_class_edges;
   // tr_stop_data:
   // For every train, for every station, list of possible stop vertices together
   // with respective edges
-  std::vector<std::vector<
-      std::vector<std::pair<size_t, std::vector<cda_rail::index_vector>>>>>
-                                                tr_stop_data;
-  std::vector<std::vector<std::vector<double>>> velocity_extensions;
-  std::vector<std::pair<size_t, size_t>>        relevant_reverse_edges;
+  std::vector<SharedEntries<StopData>> tr_stop_data;
+  // velocity_extensions:
+  // For every train, for every vertex, possible velocities
+  std::vector<SharedEntries<std::vector<double>>> velocity_extensions;
+  std::vector<std::pair<size_t, size_t>>          relevant_reverse_edges;
+  double                                          coefficient_tolerance    = 0;
+  size_t                                          num_dropped_coefficients = 0;
+
+  // Lazy cut pool:
+  // Every lazy constraint is stored as expr (sense) 0 together with how often
+  // it was separated and in which callback it was last found to be satisfied.
+  // It is only valid as long as the current model exists.
+  struct PooledLazyCut {
+    GRBLinExpr expr;
+    char       sense;
+    size_t     num_separations = 0;
+    size_t     last_callback   = 0;
+    size_t     last_satisfied  = 0;
+  };
+  std::unordered_map<LazyCutKey, PooledLazyCut> lazy_cut_pool;
+  size_t                                        num_lazy_callbacks = 0;
+
+  // Promoted cuts survive cleanup and are referenced by variable names, so that
+  // they can be added to a newly built model using the same model detail.
+  struct PromotedLazyCut {
+    std::vector<std::pair<std::string, double>> terms;
+    char                                        sense;
+    double                                      rhs;
+  };
+  std::unordered_map<LazyCutKey, PromotedLazyCut> promoted_lazy_cuts;
+  std::optional<ModelDetail> promoted_lazy_cuts_model_detail;
+
+  // Incremental re-solves:
+  // If the model is retained, the instance stays discretized and the original
+  // instance is kept to construct solution objects.
+  std::optional<instances::GeneralPerformanceOptimizationInstance>
+       retained_instance;
+  bool incumbent_stored_as_start = false;
+  // Trains (tr1, tr2) and name of every symmetry breaking constraint. They are
+  // removed once a modification makes the trains distinguishable.
+  std::vector<std::tuple<size_t, size_t, std::string>>
+      symmetry_breaking_constraints;
+
+  // Incumbents and bounds exchanged with concurrently running solvers
+  std::shared_ptr<SharedIncumbent> shared_incumbent;
 
   void initialize_variables(
       const SolutionSettingsMovingBlock& solution_settings_input,
@@ -103,11 +231,17 @@ private:
 
   double ub_timing_variable(size_t tr) const;
 
+  void fill_train_classes();
   void fill_tr_stop_data();
   void fill_relevant_reverse_edges();
   void fill_velocity_extensions();
-  void fill_velocity_extensions_using_none_strategy();
-  void fill_velocity_extensions_using_min_one_step_strategy();
+  [[nodiscard]] std::vector<double>
+  velocity_extensions_using_none_strategy(size_t tr, size_t v,
+                                          const index_vector& tr_edges) const;
+  [[nodiscard]] std::vector<double>
+  velocity_extensions_using_min_one_step_strategy(size_t tr, size_t v,
+                                                  const index_vector& tr_edges,
+                                                  bool is_exit) const;
 
   size_t get_maximal_velocity_extension_size() const;
 
@@ -136,6 +270,16 @@ private:
   void create_vertex_headway_constraints();
   void create_headway_constraints();
   void create_simplified_headway_constraints();
+  void create_symmetry_breaking_constraints();
+  void add_promoted_lazy_cuts();
+  void promote_frequent_lazy_cuts();
+
+  // Helper for incremental re-solves
+  void prepare_model_modification();
+  void remove_symmetry_breaking_constraints(size_t tr);
+  void store_incumbent_as_start();
+  void set_edge_upper_bound(const std::string& source,
+                            const std::string& target, double ub);
 
   // Helper for headway normal and lazy constraints
   [[nodiscard]] GRBLinExpr
@@ -143,6 +287,14 @@ private:
                      double initial_velocity,
                      bool   also_higher_velocities = false);
 
+  // Terms of a constraint are merged per variable and coefficients below
+  // coefficient_tolerance are dropped to prevent numerical issues. Hides the
+  // unchecked add_constr of GeneralMIPSolver.
+  [[nodiscard]] GRBLinExpr checked_expr(const GRBLinExpr& expr);
+  void add_constr(const GRBLinExpr& lhs, char sense, const GRBLinExpr& rhs,
+                  const std::string& name);
+  static GRBTempConstr to_temp_constr(const GRBLinExpr& expr, char sense);
+
   void extract_solution(
       instances::SolGeneralPerformanceOptimizationInstance<
           instances::GeneralPerformanceOptimizationInstance>& sol) const;
@@ -150,9 +302,26 @@ private:
   static double headway(const Train& tr_obj, const Edge& e_obj, double v_0,
                         double v_1, bool entry_vertex = false);
 
+  [[nodiscard]] std::optional<std::unordered_set<size_t>>
+  get_discretized_route_edges(size_t                              tr,
+                              const SharedIncumbent::NamedRoute& route) const;
+
   class LazyCallback : public MessageCallback {
   private:
     GenPOMovingBlockMIPSolver* solver;
+    size_t                     injected_routes_version = 0;
+
+    // Values of all variables in vars are fetched at once per callback. They
+    // are ordered by train, i.e., the first index of the variable, so that
+    // trains whose routes or timings changed can be detected.
+    std::vector<GRBVar> solution_vars;
+    std::vector<size_t> train_var_offsets;
+    std::vector<int>    solution_positions;
+    std::vector<double> solution_values;
+    std::vector<size_t> train_last_changed;
+
+    void exchange_shared_bounds();
+    void inject_shared_routes();
 
     std::vector<std::vector<std::pair<size_t, double>>> get_routes();
     std::vector<std::unordered_map<size_t, double>>     get_train_velocities(
@@ -163,6 +332,15 @@ private:
                                             const std::vector<std::vector<std::pair<size_t, double>>>& routes);
     std::vector<cda_rail::index_vector> get_train_orders_on_ttd();
 
+    void                 initialize_solution_vars();
+    void                 fetch_solution_values();
+    [[nodiscard]] double get_solution_value(const GRBVar& var);
+    [[nodiscard]] double get_cut_violation(const GRBLinExpr& expr, char sense);
+    bool                 separate_lazy_cut_pool();
+    bool is_cut_satisfied(const LazyCutKey& key, PooledLazyCut& cut);
+    bool add_lazy_constraint(LazyCutKey key, const GRBLinExpr& lhs, char sense,
+                             const GRBLinExpr& rhs);
+
     bool create_lazy_edge_and_ttd_headway_constraints(
         const std::vector<std::vector<std::pair<size_t, double>>>& routes,
         const std::vector<std::unordered_map<size_t, double>>& train_velocities,
@@ -195,6 +373,8 @@ private:
     void callback() override;
   };
 
+  std::optional<LazyCallback> lazy_callback;
+
 protected:
   void cleanup() override;
 
@@ -229,6 +409,67 @@ public:
 
   ~GenPOMovingBlockMIPSolver() override = default;
 
+  void clear_lazy_cut_pool() {
+    promoted_lazy_cuts.clear();
+    promoted_lazy_cuts_model_detail.reset();
+  };
+  [[nodiscard]] size_t get_number_of_promoted_lazy_cuts() const {
+    return promoted_lazy_cuts.size();
+  };
+
+  // Objective values of this solver are normalized by the sum of train
+  // weights and relative to the earliest exit times. This converts them to the
+  // weighted sum of exit times used by other solvers.
+  [[nodiscard]] static double absolute_objective(
+      const instances::GeneralPerformanceOptimizationInstance& instance,
+      double                                                   obj);
+
+  void set_shared_incumbent(std::shared_ptr<SharedIncumbent> incumbent) {
+    shared_incumbent = std::move(incumbent);
+  };
+
+  // Incremental what-if re-solves on a model retained by
+  // SolverStrategyMovingBlock::retain_model
+  [[nodiscard]] bool has_retained_model() const {
+    return retained_instance.has_value();
+  };
+  void release_model();
+
+  void set_train_entry_time_range(size_t tr, std::pair<int, int> t_0);
+  void set_train_entry_time_range(const std::string& tr_name,
+                                  std::pair<int, int> t_0) {
+    set_train_entry_time_range(
+        instance.get_train_list().get_train_index(tr_name), t_0);
+  };
+  void set_stop_time_ranges(size_t tr, const std::string& station_name,
+                            std::pair<int, int> begin, std::pair<int, int> end);
+  void set_stop_time_ranges(const std::string&  tr_name,
+                            const std::string&  station_name,
+                            std::pair<int, int> begin,
+                            std::pair<int, int> end) {
+    set_stop_time_ranges(instance.get_train_list().get_train_index(tr_name),
+                         station_name, begin, end);
+  };
+  void set_train_weight(size_t tr, double weight);
+  void set_train_weight(const std::string& tr_name, double weight) {
+    set_train_weight(instance.get_train_list().get_train_index(tr_name),
+                     weight);
+  };
+  // Closing an edge only changes bounds of the retained model. It is not
+  // recorded in the instance and is lost by release_model() or a new solve().
+  // Source and target refer to vertices of the instance network, i.e., before
+  // discretization. Other edges throw an InvalidInputException.
+  void close_edge(const std::string& source, const std::string& target) {
+    set_edge_upper_bound(source, target, 0.0);
+  };
+  void reopen_edge(const std::string& source, const std::string& target) {
+    set_edge_upper_bound(source, target, 1.0);
+  };
+
+  [[nodiscard]] instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+  resolve(int time_limit = -1);
+
   using GeneralSolver::solve;
   [[nodiscard]] instances::SolGeneralPerformanceOptimizationInstance<
       instances::GeneralPerformanceOptimizationInstance>
@@ -6,13 +6,18 @@
 #include "gurobi_c.h"
 #include "probleminstances/GeneralProblemInstance.hpp"
 #include "solver/GeneralSolver.hpp"
+#include "solver/mip-based/GRBEnvPool.hpp"
 
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
 #include <optional>
 #include <plog/Log.h>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cda_rail::solver::mip_based {
@@ -63,18 +68,77 @@ protected:
   std::vector<GRBTempConstr> lazy_constraints;
 
   // Gurobi variables
-  std::optional<GRBEnv>                               env;
-  std::optional<GRBModel>                             model;
-  std::unordered_map<std::string, MultiArray<GRBVar>> vars;
-  GRBLinExpr                                          objective_expr;
+  std::shared_ptr<GRBEnv>                                   env;
+  std::optional<GRBModel>                                   model;
+  std::unordered_map<std::string, MultiArray<GRBVar>>       vars;
+  std::unordered_map<std::string, SparseMultiArray<GRBVar>> sparse_vars;
+  GRBLinExpr                                                objective_expr;
+
+  // Constraints of families built by build_constraint_families on worker
+  // threads are collected in a thread-local buffer
+  using ConstraintBuffer = std::vector<std::pair<GRBTempConstr, std::string>>;
+  inline static thread_local ConstraintBuffer* constraint_buffer = nullptr;
+
+  void add_constr(const GRBTempConstr& constr, const std::string& name) {
+    if (constraint_buffer != nullptr) {
+      constraint_buffer->emplace_back(constr, name);
+    } else {
+      model->addConstr(constr, name);
+    }
+  };
+
+  void
+  build_constraint_families(const std::vector<std::function<void()>>& families,
+                            bool parallel) {
+    /**
+     * Builds the given constraint families. If parallel is true, every family
+     * is built on its own thread into a separate buffer. The buffers are added
+     * to the model in the order of families, hence, the model does not depend
+     * on thread scheduling. Families built in parallel must only read shared
+     * data and add constraints using add_constr.
+     */
+
+    if (!parallel || families.size() <= 1) {
+      for (const auto& family : families) {
+        family();
+      }
+      return;
+    }
+
+    std::vector<std::future<ConstraintBuffer>> futures;
+    futures.reserve(families.size());
+    for (const auto& family : families) {
+      futures.push_back(std::async(std::launch::async, [&family]() {
+        ConstraintBuffer buffer;
+        constraint_buffer = &buffer;
+        try {
+          family();
+        } catch (...) {
+          constraint_buffer = nullptr;
+          throw;
+        }
+        constraint_buffer = nullptr;
+        return buffer;
+      }));
+    }
+
+    // Buffers are added as soon as they are ready, remaining families are
+    // still built concurrently
+    for (auto& future : futures) {
+      for (const auto& [constr, name] : future.get()) {
+        model->addConstr(constr, name);
+      }
+    }
+  };
 
   virtual void cleanup() {
     objective_expr = 0;
     lazy_constraints.clear();
     model->reset(1);
     vars.clear();
+    sparse_vars.clear();
     model.reset();
-    env.reset();
+    env.reset(); // Returns the environment to the pool
   };
 
   void solve_init_general_mip(int time_limit, bool debug_input,
@@ -89,10 +153,9 @@ protected:
     this->solve_init_general(time_limit, debug_input, overwrite_severity);
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    PLOGD << "Create Gurobi environment and model";
-    this->env.emplace(true);
-    this->env->start();
-    this->model.emplace(env.value());
+    PLOGD << "Acquire Gurobi environment and create model";
+    this->env = GRBEnvPool::get_instance().acquire();
+    this->model.emplace(*env);
 
     this->model->setCallback(cb);
     this->model->set(GRB_IntParam_LogToConsole, 0);
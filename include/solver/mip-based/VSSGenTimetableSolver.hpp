@@ -6,11 +6,13 @@
 #include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
 #include "probleminstances/VSSGenerationTimetable.hpp"
 #include "solver/GeneralSolver.hpp"
+#include "solver/SharedIncumbent.hpp"
 #include "unordered_map"
 
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -24,17 +26,19 @@ struct SolverStrategy {
   bool                         iterative_approach = false;
   cda_rail::OptimalityStrategy optimality_strategy =
       cda_rail::OptimalityStrategy::Optimal;
-  UpdateStrategy update_strategy = UpdateStrategy::Fixed;
-  double         initial_value   = 1;
-  double         update_value    = 2;
-  bool           include_cuts    = true;
+  UpdateStrategy update_strategy        = UpdateStrategy::Fixed;
+  double         initial_value          = 1;
+  double         update_value           = 2;
+  bool           include_cuts           = true;
+  size_t         parallel_budget_levels = 1;
 };
 
 struct ModelDetail {
-  int  delta_t        = 15;
-  bool fix_routes     = true;
-  bool train_dynamics = true;
-  bool braking_curves = true;
+  int  delta_t           = 15;
+  bool fix_routes        = true;
+  bool train_dynamics    = true;
+  bool braking_curves    = true;
+  bool prune_unreachable = true;
 };
 
 struct ModelDetailMBInformation {
@@ -96,6 +100,36 @@ private:
   std::vector<std::pair<cda_rail::index_vector, cda_rail::index_vector>>
       fwd_bwd_sections;
 
+  // Reachability in the time-expanded network:
+  // For every train and edge (resp. vertex), the range of time steps in which
+  // the train can possibly occupy it. Position variables outside of this range
+  // are not created, i.e., not stored in sparse_vars, and trivial constraints
+  // are skipped.
+  bool prune_unreachable = false;
+  std::vector<std::vector<std::pair<size_t, size_t>>> reachable_edge_steps;
+  std::vector<std::vector<std::pair<size_t, size_t>>> reachable_vertex_steps;
+
+  // Incumbent of the previous iteration, used as MIP start for the next one
+  std::vector<GRBVar> incumbent_vars;
+  std::vector<double> incumbent_values;
+
+  // Exchange of bounds between concurrently solved VSS budget levels
+  std::shared_ptr<SharedIncumbent> shared_incumbent;
+  int                              gurobi_threads = 0;
+
+  class SharedBoundsCallback : public MessageCallback {
+  private:
+    VSSGenTimetableSolver* solver;
+
+  protected:
+    void callback() override;
+
+  public:
+    explicit SharedBoundsCallback(VSSGenTimetableSolver* solver)
+        : solver(solver) {};
+  };
+  std::optional<SharedBoundsCallback> shared_bounds_callback;
+
   // Variable functions
   void create_variables();
   void create_general_variables();
@@ -169,6 +203,25 @@ private:
   void                 calculate_fwd_bwd_sections_non_discretized();
   [[nodiscard]] double get_max_brakelen(const size_t& tr) const;
 
+  void                              calculate_reachable_steps();
+  [[nodiscard]] std::vector<double> distances_from_entry(size_t tr) const;
+  [[nodiscard]] std::vector<double> distances_to_exit(size_t tr) const;
+  [[nodiscard]] bool is_reachable(size_t tr, size_t t, size_t e) const {
+    const auto& [t_min, t_max] = reachable_edge_steps.at(tr).at(e);
+    return t_min <= t && t <= t_max;
+  };
+  [[nodiscard]] bool is_vertex_reachable(size_t tr, size_t t, size_t v) const {
+    const auto& [t_min, t_max] = reachable_vertex_steps.at(tr).at(v);
+    return t_min <= t && t <= t_max;
+  };
+  // Sparse position variable, zero if the combination has been pruned
+  [[nodiscard]] GRBLinExpr pruned_var(const std::string& name, size_t tr,
+                                      size_t t, size_t i) const {
+    const auto& var_array = sparse_vars.at(name);
+    return var_array.contains(tr, t, i) ? GRBLinExpr(var_array.at(tr, t, i))
+                                        : GRBLinExpr(0);
+  };
+
   [[nodiscard]] std::pair<std::vector<cda_rail::index_vector>,
                           std::vector<cda_rail::index_vector>>
   common_entry_exit_vertices() const;
@@ -199,6 +252,9 @@ private:
 
   bool update_vss(size_t relevant_edge_index, double obj_ub,
                   GRBLinExpr& cut_expr);
+  [[nodiscard]] double budget_lower_bound() const;
+  void store_incumbent();
+  void set_incumbent_as_start();
   void update_max_vss_on_edge(size_t relevant_edge_index, size_t new_max_vss,
                               GRBLinExpr& cut_expr);
   [[nodiscard]] std::optional<instances::VSSGenerationTimetable>
@@ -208,6 +264,13 @@ private:
                        const SolutionSettings& solution_settings,
                        int time_limit, bool debug_input,
                        bool overwrite_severity);
+  [[nodiscard]] instances::SolVSSGenerationTimetable
+  solve_parallel_budget_levels(const ModelDetail&      model_detail,
+                               const ModelSettings&    model_settings,
+                               const SolverStrategy&   solver_strategy,
+                               const SolutionSettings& solution_settings,
+                               int time_limit, bool debug_input,
+                               bool overwrite_severity);
 
 protected:
   void solve_init_vss_gen_timetable(int time_limit, bool debug_input,
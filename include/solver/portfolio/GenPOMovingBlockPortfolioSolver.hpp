@@ -0,0 +1,106 @@
+#pragma once
+
+#include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
+#include "solver/GeneralSolver.hpp"
+#include "solver/SharedIncumbent.hpp"
+#include "solver/astar-based/GenPOMovingBlockAStarSolver.hpp"
+#include "solver/mip-based/GenPOMovingBlockMIPSolver.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace cda_rail::solver::portfolio {
+
+enum class PortfolioStrategyType : std::uint8_t {
+  AStar         = 0,
+  LazyMIP       = 1,
+  SimplifiedMIP = 2
+};
+
+struct SolverStrategyPortfolio {
+  bool                                 use_astar             = true;
+  bool                                 use_lazy_mip          = true;
+  bool                                 use_simplified_mip    = false;
+  astar_based::ModelDetail             astar_model_detail    = {};
+  astar_based::SolverStrategyMBAStar   astar_solver_strategy = {};
+  mip_based::ModelDetail               mip_model_detail      = {};
+  mip_based::SolverStrategyMovingBlock mip_solver_strategy   = {};
+};
+
+class GenPOMovingBlockPortfolioSolver
+    : public GeneralSolver<
+          instances::GeneralPerformanceOptimizationInstance,
+          instances::SolGeneralPerformanceOptimizationInstance<
+              instances::GeneralPerformanceOptimizationInstance>> {
+  /**
+   * Runs the selected strategies concurrently under one time limit. The
+   * strategies share incumbents and bounds, i.e., routes found by A* become
+   * MIP starts and MIP bounds prune the A* search. All strategies are stopped
+   * as soon as one of them proves optimality.
+   * The objective of the returned solution is the weighted sum of exit times
+   * independent of the winning strategy.
+   */
+private:
+  std::optional<PortfolioStrategyType> winning_strategy;
+
+  [[nodiscard]] instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+  run_strategy(PortfolioStrategyType                   strategy,
+               const SolverStrategyPortfolio&          solver_strategy_input,
+               const std::shared_ptr<SharedIncumbent>& shared, int time_limit,
+               bool debug_input) const;
+
+public:
+  GenPOMovingBlockPortfolioSolver() = default;
+
+  explicit GenPOMovingBlockPortfolioSolver(
+      const instances::GeneralPerformanceOptimizationInstance& instance)
+      : GeneralSolver<instances::GeneralPerformanceOptimizationInstance,
+                      instances::SolGeneralPerformanceOptimizationInstance<
+                          instances::GeneralPerformanceOptimizationInstance>>(
+            instance) {};
+
+  explicit GenPOMovingBlockPortfolioSolver(const std::filesystem::path& p)
+      : GeneralSolver<instances::GeneralPerformanceOptimizationInstance,
+                      instances::SolGeneralPerformanceOptimizationInstance<
+                          instances::GeneralPerformanceOptimizationInstance>>(
+            p) {};
+
+  explicit GenPOMovingBlockPortfolioSolver(const std::string& path)
+      : GeneralSolver<instances::GeneralPerformanceOptimizationInstance,
+                      instances::SolGeneralPerformanceOptimizationInstance<
+                          instances::GeneralPerformanceOptimizationInstance>>(
+            path) {};
+
+  explicit GenPOMovingBlockPortfolioSolver(const char* path)
+      : GeneralSolver<instances::GeneralPerformanceOptimizationInstance,
+                      instances::SolGeneralPerformanceOptimizationInstance<
+                          instances::GeneralPerformanceOptimizationInstance>>(
+            path) {};
+
+  ~GenPOMovingBlockPortfolioSolver() override = default;
+
+  [[nodiscard]] const std::optional<PortfolioStrategyType>&
+  get_winning_strategy() const {
+    return winning_strategy;
+  };
+
+  using GeneralSolver::solve;
+  [[nodiscard]] instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+  solve(int time_limit, bool debug_input, bool overwrite_severity) override {
+    return solve({}, {}, time_limit, debug_input, overwrite_severity);
+  };
+
+  [[nodiscard]] instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+  solve(const SolverStrategyPortfolio& solver_strategy_input,
+        const GeneralSolutionSettings& solution_settings_input,
+        int time_limit = -1, bool debug_input = false,
+        bool overwrite_severity = true);
+};
+
+} // namespace cda_rail::solver::portfolio
@@ -4,21 +4,158 @@
 #include "Definitions.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <initializer_list>
 #include <limits>
+#include <optional>
+#include <span>
 #include <string>
 #include <utility>
 
-double cda_rail::min_travel_time_from_start(double v_1, double v_2, double v_m,
-                                            double a, double d, double s,
-                                            double x) {
-  check_consistency_of_eom_input(v_1, v_2, a, d, s, x);
+using std::size_t;
 
-  const auto s_points =
-      get_min_travel_time_acceleration_change_points(v_1, v_2, v_m, a, d, s);
-  const auto& s_1 = s_points.first;
-  const auto& s_2 = s_points.second;
+namespace {
+// The unchecked kernels below assume validated input. They are free of
+// exceptions, so that the batched variants can evaluate them in tight loops.
+
+void check_batch_sizes(size_t n, std::initializer_list<size_t> sizes) {
+  if (std::ranges::any_of(sizes, [n](size_t m) { return m != n; })) {
+    throw cda_rail::exceptions::InvalidInputException(
+        "All batch inputs must have the same size.");
+  }
+}
+
+double rounded_towards_zero(double val) {
+  return std::abs(val) < cda_rail::GRB_EPS ? 0 : val;
+}
+
+void check_maximal_speed_of_min_travel_time_input(double v_1, double v_2,
+                                                  double v_m) {
+  if (v_m <= 0) {
+    throw cda_rail::exceptions::ConsistencyException(
+        "v_m must be greater than 0.");
+  }
+  if (v_1 > v_m || v_2 > v_m) {
+    throw cda_rail::exceptions::ConsistencyException(
+        "v_m must be greater than or equal to v_1 and v_2.");
+  }
+}
+
+void check_minimal_speed_of_max_travel_time_input(double v_m) {
+  if (v_m < 0) {
+    throw cda_rail::exceptions::ConsistencyException(
+        "v_m must be greater than or equal 0.");
+  }
+}
+
+void check_consistency_of_eom_batch_input(
+    std::span<const double> v_1, std::span<const double> v_2, double a,
+    double d, double s, std::optional<double> v_m = std::nullopt) {
+  /**
+   * Performs the same checks as check_consistency_of_eom_input (and the
+   * maximal speed check if v_m is given) for all entries. The entries are
+   * checked in a single pass without branches. Only if some entry is invalid,
+   * the scalar checks are repeated to throw the respective exception.
+   */
+  if (v_1.empty()) {
+    return;
+  }
+  // The scalar input is checked once using a standstill entry
+  double v_1_0 = 0;
+  double v_2_0 = 0;
+  double x     = s;
+  cda_rail::check_consistency_of_eom_input(v_1_0, v_2_0, a, d, s, x);
+
+  const double v_max   = v_m.value_or(std::numeric_limits<double>::max());
+  bool         invalid = v_max <= 0;
+  for (size_t i = 0; i < v_1.size(); i++) {
+    const double v_1_i = rounded_towards_zero(v_1[i]);
+    const double v_2_i = rounded_towards_zero(v_2[i]);
+    invalid |= (v_1_i < 0) | (v_2_i < 0) |
+               !cda_rail::possible_by_eom(v_1_i, v_2_i, a, d, s) |
+               (v_1_i > v_max) | (v_2_i > v_max);
+  }
+  if (!invalid) {
+    return;
+  }
+  for (size_t i = 0; i < v_1.size(); i++) {
+    double v_1_i = v_1[i];
+    double v_2_i = v_2[i];
+    double a_i   = a;
+    double d_i   = d;
+    double s_i   = s;
+    double x_i   = s;
+    cda_rail::check_consistency_of_eom_input(v_1_i, v_2_i, a_i, d_i, s_i, x_i);
+    if (v_m.has_value()) {
+      check_maximal_speed_of_min_travel_time_input(v_1_i, v_2_i, v_m.value());
+    }
+  }
+}
+
+std::pair<double, double>
+min_travel_time_acceleration_change_points_unchecked(double v_1, double v_2,
+                                                     double v_m, double a,
+                                                     double d, double s) {
+  const double s_1 =
+      (v_m + v_1) * (v_m - v_1) / (2 * a); // Distance to reach maximal speed
+
+  const double s_2 = s - ((v_m + v_2) * (v_m - v_2) / (2 * d));
+
+  // Point at which decelerating starts if maximal speed is not reached.
+  // Selecting instead of branching keeps batched evaluations vectorizable.
+  const double y = (2 * d * s + (v_2 + v_1) * (v_2 - v_1)) / (2 * (a + d));
+
+  const bool v_m_reached = s_2 >= s_1;
+  return {v_m_reached ? s_1 : y, v_m_reached ? s_2 : y};
+}
+
+std::pair<double, double>
+max_travel_time_acceleration_change_points_unchecked(double v_1, double v_2,
+                                                     double v_m, double a,
+                                                     double d, double s) {
+  // v_m is minimal speed in this case
+
+  const bool v_1_below_minimal_speed = v_1 < v_m;
+  const bool v_2_below_minimal_speed = v_2 < v_m;
+
+  const double s_1 =
+      (v_1 + v_m) * (v_1 - v_m) /
+      (2 *
+       (v_1_below_minimal_speed ? -a : d)); // Distance to reach minimal speed
+
+  const double s_2 = s - ((v_2 + v_m) * (v_2 - v_m) /
+                          (2 * (v_2_below_minimal_speed ? -d : a)));
+
+  if (s_2 >= s_1) {
+    return {s_1, s_2};
+  }
+
+  if (v_1_below_minimal_speed && v_2_below_minimal_speed) {
+    // Very short distance, train cannot reach minimal speed, hence same as
+    // minimal time
+    return min_travel_time_acceleration_change_points_unchecked(v_1, v_2, v_m,
+                                                                a, d, s);
+  }
+
+  assert((!v_1_below_minimal_speed && !v_2_below_minimal_speed));
+
+  const double y = (2 * a * s + (v_1 + v_2) * (v_1 - v_2)) /
+                   (2 * (a + d)); // Distance at which accelerating starts if
+  // minimal speed is not reached
+
+  return {y, y};
+}
+
+// Inlined, so that the batched evaluation can be vectorized
+inline double min_travel_time_from_start_unchecked(double v_1, double v_2,
+                                                   double v_m, double a,
+                                                   double d, double s,
+                                                   double x) {
+  const auto [s_1, s_2] = min_travel_time_acceleration_change_points_unchecked(
+      v_1, v_2, v_m, a, d, s);
 
   assert(s_2 >= s_1);
 
@@ -51,30 +188,17 @@ double cda_rail::min_travel_time_from_start(double v_1, double v_2, double v_m,
   return t_1 + t_2 + t_3;
 }
 
-double cda_rail::min_travel_time(double v_1, double v_2, double v_m, double a,
-                                 double d, double s) {
-  return min_travel_time_from_start(v_1, v_2, v_m, a, d, s, s);
-}
-
-bool cda_rail::possible_by_eom(double v_1, double v_2, double a, double d,
-                               double s) {
-  return v_1 <= v_2 ? (v_2 + v_1) * (v_2 - v_1) <= 2 * a * s + GRB_EPS
-                    : (v_1 + v_2) * (v_1 - v_2) <= 2 * d * s + GRB_EPS;
-}
-
-double cda_rail::max_travel_time_from_start_no_stopping(double v_1, double v_2,
+double max_travel_time_from_start_no_stopping_unchecked(double v_1, double v_2,
                                                         double v_m, double a,
                                                         double d, double s,
                                                         double x) {
   // v_m is minimal speed in this case
 
-  check_consistency_of_eom_input(v_1, v_2, a, d, s, x);
-
   const bool v_1_below_minimal_speed = v_1 < v_m;
   const bool v_2_below_minimal_speed = v_2 < v_m;
 
-  const auto s_points =
-      get_max_travel_time_acceleration_change_points(v_1, v_2, v_m, a, d, s);
+  const auto s_points = max_travel_time_acceleration_change_points_unchecked(
+      v_1, v_2, v_m, a, d, s);
   const auto& s_1 = s_points.first;
   const auto& s_2 = s_points.second;
 
@@ -114,30 +238,205 @@ double cda_rail::max_travel_time_from_start_no_stopping(double v_1, double v_2,
   return t_1 + t_2 + t_3;
 }
 
-double cda_rail::max_travel_time_no_stopping(double v_1, double v_2, double v_m,
-                                             double a, double d, double s) {
-  return max_travel_time_from_start_no_stopping(v_1, v_2, v_m, a, d, s, s);
-}
-
-double cda_rail::max_travel_time_from_start_stopping_allowed(
+double max_travel_time_from_start_stopping_allowed_unchecked(
     double v_1, double v_2, double a, double d, double s, double x) {
-  check_consistency_of_eom_input(v_1, v_2, a, d, s, x);
-
-  const auto s_points =
-      get_max_travel_time_acceleration_change_points(v_1, v_2, 0, a, d, s);
+  const auto s_points = max_travel_time_acceleration_change_points_unchecked(
+      v_1, v_2, 0, a, d, s);
   const auto& s_1 = s_points.first;
 
   const double bd = v_1 * v_1 / (2 * d); // Distance to stop
 
-  if (bd <= s_1 + EPS) {
-    if (x + EPS >= s_1) {
+  if (bd <= s_1 + cda_rail::EPS) {
+    if (x + cda_rail::EPS >= s_1) {
       // Infinite, because train could have stopped
       return std::numeric_limits<double>::infinity();
     }
   }
 
   // Train cannot stop, hence same as max_travel_time_from_start_no_stopping
-  return max_travel_time_from_start_no_stopping(v_1, v_2, 0, a, d, s, x);
+  return max_travel_time_from_start_no_stopping_unchecked(v_1, v_2, 0, a, d, s,
+                                                          x);
+}
+
+void check_consistency_of_time_on_edge_input(double& v_1, double& v_2,
+                                             double& v_line, double& a,
+                                             double& d, double& s) {
+  // If any variable is within std::abs(GRB_EPS), set to 0
+  cda_rail::round_towards_zero(v_1, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(v_2, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(v_line, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(a, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(d, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(s, cda_rail::GRB_EPS);
+
+  // Assert that all variables are >= 0 and a, d, s, v_line are >= GRB_EPS
+  if (v_1 < 0 || v_2 < 0 || v_line < cda_rail::GRB_EPS ||
+      a < cda_rail::GRB_EPS || d < cda_rail::GRB_EPS || s < 0) {
+    throw cda_rail::exceptions::InvalidInputException(
+        "All input values must be non-negative, and a, d, v_line must be "
+        "greater "
+        "than 0.");
+  }
+
+  if (s == 0) {
+    return;
+  }
+
+  // If s1 + s2 > s, this is not possible
+  const double a1 = v_line >= v_1 ? a : -d;
+  const double s1 = (v_line * v_line - v_1 * v_1) / (2 * a1);
+  const double a2 = v_2 >= v_line ? a : -d;
+  const double s2 = (v_2 * v_2 - v_line * v_line) / (2 * a2);
+  if (s1 + s2 - cda_rail::GRB_EPS > s) {
+    throw cda_rail::exceptions::ConsistencyException(
+        "Travel time not possible by equations of motion.");
+  }
+}
+
+double time_on_edge_unchecked(double v_1, double v_2, double v_line, double a,
+                              double d, double s) {
+  cda_rail::round_towards_zero(v_1, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(v_2, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(v_line, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(a, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(d, cda_rail::GRB_EPS);
+  cda_rail::round_towards_zero(s, cda_rail::GRB_EPS);
+
+  if (s == 0) {
+    return 0;
+  }
+
+  // First segment: v_1 -> v_line
+  const double a1 = v_line >= v_1 ? a : -d;
+  const double s1 = (v_line * v_line - v_1 * v_1) / (2 * a1);
+  const double t1 = (v_line - v_1) / a1;
+  assert(t1 >= 0);
+
+  // Last segment: v_line -> v_2
+  const double a2 = v_2 >= v_line ? a : -d;
+  const double s2 = (v_2 * v_2 - v_line * v_line) / (2 * a2);
+  const double t2 = (v_2 - v_line) / a2;
+  assert(t2 >= 0);
+
+  if (std::abs(s - s1 - s2) < cda_rail::GRB_EPS) {
+    return t1 + t2;
+  }
+
+  return t1 + t2 + ((s - s1 - s2) / v_line);
+}
+
+double pos_on_edge_at_time_unchecked(double v_1, double v_2, double v_line,
+                                     double a, double d, double s, double t) {
+  // Time exceeding the total travel time is assumed to be validated already
+  const auto total_time = time_on_edge_unchecked(v_1, v_2, v_line, a, d, s);
+  if (std::abs(total_time) < cda_rail::GRB_EPS) {
+    return 0;
+  }
+  if (t > total_time - cda_rail::GRB_EPS) {
+    return s;
+  }
+
+  const auto a1 = v_line >= v_1 ? a : -d;
+  const auto a2 = v_2 >= v_line ? a : -d;
+
+  const auto t1 = (v_line - v_1) / a1;
+  const auto t2 = total_time - ((v_2 - v_line) / a2);
+
+  if (t <= t1) {
+    return (v_1 * t) + (0.5 * a1 * t * t);
+  }
+  if (t <= t2) {
+    return (v_1 * t1) + (0.5 * a1 * t1 * t1) + (v_line * (t - t1));
+  }
+  return s + (0.5 * a2 * (total_time - t) * (total_time - t)) -
+         (v_2 * (total_time - t));
+}
+
+std::optional<double> line_speed_on_speed_interval(double v_1, double v_2,
+                                                   double a, double d, double s,
+                                                   double t, double v_lb,
+                                                   double v_ub) {
+  /**
+   * Returns the line speed v in [v_lb, v_ub] with time_on_edge(v) = t assuming
+   * that neither v_1 nor v_2 lies strictly inside the interval. Then, the
+   * travel time is
+   * t = (v-v_1)/a_1 + (v_2-v)/a_2 + (s - (v^2-v_1^2)/(2a_1) -
+   * (v_2^2-v^2)/(2a_2))/v
+   * with fixed a_1, a_2. Multiplying by v yields a quadratic equation in v.
+   */
+  const double v_mid = (v_lb + v_ub) / 2;
+  const double a_1   = v_mid >= v_1 ? a : -d;
+  const double a_2   = v_2 >= v_mid ? a : -d;
+
+  const double alpha = ((1 / a_1) - (1 / a_2)) / 2;
+  const double beta  = (v_2 / a_2) - (v_1 / a_1) - t;
+  const double gamma = s + (v_1 * v_1 / (2 * a_1)) - (v_2 * v_2 / (2 * a_2));
+
+  std::array<double, 2> roots = {-1, -1};
+  if (std::abs(alpha) < cda_rail::EPS) {
+    if (std::abs(beta) >= cda_rail::EPS) {
+      roots.at(0) = -gamma / beta;
+    }
+  } else {
+    // Numerically stable version of the quadratic formula
+    const double disc = std::max(0.0, (beta * beta) - (4 * alpha * gamma));
+    const double q    = -(beta + std::copysign(std::sqrt(disc), beta)) / 2;
+    roots.at(0)       = q / alpha;
+    if (std::abs(q) >= cda_rail::EPS) {
+      roots.at(1) = gamma / q;
+    }
+  }
+
+  for (const auto& v : roots) {
+    if (v >= v_lb - cda_rail::GRB_EPS && v <= v_ub + cda_rail::GRB_EPS) {
+      return std::clamp(v, v_lb, v_ub);
+    }
+  }
+  return std::nullopt;
+}
+} // namespace
+
+double cda_rail::min_travel_time_from_start(double v_1, double v_2, double v_m,
+                                            double a, double d, double s,
+                                            double x) {
+  check_consistency_of_eom_input(v_1, v_2, a, d, s, x);
+  check_maximal_speed_of_min_travel_time_input(v_1, v_2, v_m);
+  return min_travel_time_from_start_unchecked(v_1, v_2, v_m, a, d, s, x);
+}
+
+double cda_rail::min_travel_time(double v_1, double v_2, double v_m, double a,
+                                 double d, double s) {
+  return min_travel_time_from_start(v_1, v_2, v_m, a, d, s, s);
+}
+
+bool cda_rail::possible_by_eom(double v_1, double v_2, double a, double d,
+                               double s) {
+  return v_1 <= v_2 ? (v_2 + v_1) * (v_2 - v_1) <= 2 * a * s + GRB_EPS
+                    : (v_1 + v_2) * (v_1 - v_2) <= 2 * d * s + GRB_EPS;
+}
+
+double cda_rail::max_travel_time_from_start_no_stopping(double v_1, double v_2,
+                                                        double v_m, double a,
+                                                        double d, double s,
+                                                        double x) {
+  // v_m is minimal speed in this case
+
+  check_consistency_of_eom_input(v_1, v_2, a, d, s, x);
+  check_minimal_speed_of_max_travel_time_input(v_m);
+  return max_travel_time_from_start_no_stopping_unchecked(v_1, v_2, v_m, a, d,
+                                                          s, x);
+}
+
+double cda_rail::max_travel_time_no_stopping(double v_1, double v_2, double v_m,
+                                             double a, double d, double s) {
+  return max_travel_time_from_start_no_stopping(v_1, v_2, v_m, a, d, s, s);
+}
+
+double cda_rail::max_travel_time_from_start_stopping_allowed(
+    double v_1, double v_2, double a, double d, double s, double x) {
+  check_consistency_of_eom_input(v_1, v_2, a, d, s, x);
+  return max_travel_time_from_start_stopping_allowed_unchecked(v_1, v_2, a, d,
+                                                               s, x);
 }
 
 double cda_rail::max_travel_time_stopping_allowed(double v_1, double v_2,
@@ -324,25 +623,9 @@ cda_rail::get_min_travel_time_acceleration_change_points(double v_1, double v_2,
                                                          double v_m, double a,
                                                          double d, double s) {
   check_consistency_of_eom_input(v_1, v_2, a, d, s, s);
-  if (v_m <= 0) {
-    throw exceptions::ConsistencyException("v_m must be greater than 0.");
-  }
-  if (v_1 > v_m || v_2 > v_m) {
-    throw exceptions::ConsistencyException(
-        "v_m must be greater than or equal to v_1 and v_2.");
-  }
-
-  const double s_1 =
-      (v_m + v_1) * (v_m - v_1) / (2 * a); // Distance to reach maximal speed
-
-  const double s_2 = s - ((v_m + v_2) * (v_m - v_2) / (2 * d));
-
-  if (s_2 >= s_1) {
-    return {s_1, s_2};
-  }
-
-  const double y = (2 * d * s + (v_2 + v_1) * (v_2 - v_1)) / (2 * (a + d));
-  return {y, y};
+  check_maximal_speed_of_min_travel_time_input(v_1, v_2, v_m);
+  return min_travel_time_acceleration_change_points_unchecked(v_1, v_2, v_m, a,
+                                                              d, s);
 }
 
 std::pair<double, double>
@@ -352,40 +635,9 @@ cda_rail::get_max_travel_time_acceleration_change_points(double v_1, double v_2,
   // v_m is minimal speed in this case
 
   check_consistency_of_eom_input(v_1, v_2, a, d, s, s);
-  if (v_m < 0) {
-    throw exceptions::ConsistencyException(
-        "v_m must be greater than or equal 0.");
-  }
-
-  const bool v_1_below_minimal_speed = v_1 < v_m;
-  const bool v_2_below_minimal_speed = v_2 < v_m;
-
-  const double s_1 =
-      (v_1 + v_m) * (v_1 - v_m) /
-      (2 *
-       (v_1_below_minimal_speed ? -a : d)); // Distance to reach minimal speed
-
-  const double s_2 = s - ((v_2 + v_m) * (v_2 - v_m) /
-                          (2 * (v_2_below_minimal_speed ? -d : a)));
-
-  if (s_2 >= s_1) {
-    return {s_1, s_2};
-  }
-
-  if (v_1_below_minimal_speed && v_2_below_minimal_speed) {
-    // Very short distance, train cannot reach minimal speed, hence same as
-    // minimal time
-    return get_min_travel_time_acceleration_change_points(v_1, v_2, v_m, a, d,
-                                                          s);
-  }
-
-  assert((!v_1_below_minimal_speed && !v_2_below_minimal_speed));
-
-  const double y = (2 * a * s + (v_1 + v_2) * (v_1 - v_2)) /
-                   (2 * (a + d)); // Distance at which accelerating starts if
-  // minimal speed is not reached
-
-  return {y, y};
+  check_minimal_speed_of_max_travel_time_input(v_m);
+  return max_travel_time_acceleration_change_points_unchecked(v_1, v_2, v_m, a,
+                                                              d, s);
 }
 
 double cda_rail::min_time_from_front_to_ma_point(double v_1, double v_2,
@@ -546,50 +798,8 @@ double cda_rail::time_on_edge(double v_1, double v_2, double v_line, double a,
    * - deceleration d
    */
 
-  // If any variable is within std::abs(GRB_EPS), set to 0
-  round_towards_zero(v_1, GRB_EPS);
-  round_towards_zero(v_2, GRB_EPS);
-  round_towards_zero(v_line, GRB_EPS);
-  round_towards_zero(a, GRB_EPS);
-  round_towards_zero(d, GRB_EPS);
-  round_towards_zero(s, GRB_EPS);
-
-  // Assert that all variables are >= 0 and a, d, s, v_line are >= GRB_EPS
-  if (v_1 < 0 || v_2 < 0 || v_line < GRB_EPS || a < GRB_EPS || d < GRB_EPS ||
-      s < 0) {
-    throw exceptions::InvalidInputException(
-        "All input values must be non-negative, and a, d, v_line must be "
-        "greater "
-        "than 0.");
-  }
-
-  if (s == 0) {
-    return 0;
-  }
-
-  // First segment: v_1 -> v_line
-  const double a1 = v_line >= v_1 ? a : -d;
-  const double s1 = (v_line * v_line - v_1 * v_1) / (2 * a1);
-  const double t1 = (v_line - v_1) / a1;
-  assert(t1 >= 0);
-
-  // Last segment: v_line -> v_2
-  const double a2 = v_2 >= v_line ? a : -d;
-  const double s2 = (v_2 * v_2 - v_line * v_line) / (2 * a2);
-  const double t2 = (v_2 - v_line) / a2;
-  assert(t2 >= 0);
-
-  // If s1 + s2 > s, this is not possible
-  if (s1 + s2 - GRB_EPS > s) {
-    throw exceptions::ConsistencyException(
-        "Travel time not possible by equations of motion.");
-  }
-
-  if (std::abs(s - s1 - s2) < GRB_EPS) {
-    return t1 + t2;
-  }
-
-  return t1 + t2 + ((s - s1 - s2) / v_line);
+  check_consistency_of_time_on_edge_input(v_1, v_2, v_line, a, d, s);
+  return time_on_edge_unchecked(v_1, v_2, v_line, a, d, s);
 }
 
 double cda_rail::maximal_line_speed(double v_1, double v_2, double v_max,
@@ -642,6 +852,25 @@ double cda_rail::get_line_speed(double v_1, double v_2, double v_min,
 
   assert(t_lb < t);
   assert(t < t_ub);
+
+  // The travel time is strictly decreasing in the line speed. Between the
+  // breakpoints v_1 and v_2 it is given by a quadratic equation, hence, the
+  // line speed is obtained in closed form.
+  std::array<double, 4> breakpoints = {v_lb, std::clamp(v_1, v_lb, v_ub),
+                                       std::clamp(v_2, v_lb, v_ub), v_ub};
+  std::ranges::sort(breakpoints);
+  for (size_t i = 0; i + 1 < breakpoints.size(); i++) {
+    if (breakpoints.at(i + 1) - breakpoints.at(i) < GRB_EPS) {
+      continue;
+    }
+    if (const auto v = line_speed_on_speed_interval(
+            v_1, v_2, a, d, s, t, breakpoints.at(i), breakpoints.at(i + 1));
+        v.has_value()) {
+      return v.value();
+    }
+  }
+
+  // Bisection in case of numerical difficulties
   while (v_ub - v_lb > LINE_SPEED_ACCURACY &&
          t - t_lb > LINE_SPEED_TIME_ACCURACY) {
     const double v = (v_ub + v_lb) / 2;
@@ -795,3 +1024,113 @@ double cda_rail::max_braking_pos_after_dt_linear_movement(double v_0,
   const double bd  = braking_distance(v_1, d); // Braking distance at v_1
   return x_1 + bd; // Maximum position of the braking point
 }
+
+void cda_rail::min_travel_time_batch(std::span<const double> v_1,
+                                     std::span<const double> v_2, double v_m,
+                                     double a, double d, double s,
+                                     std::span<double> t) {
+  check_batch_sizes(t.size(), {v_1.size(), v_2.size()});
+  check_consistency_of_eom_batch_input(v_1, v_2, a, d, s, v_m);
+
+  a = rounded_towards_zero(a);
+  d = rounded_towards_zero(d);
+  s = rounded_towards_zero(s);
+  for (size_t i = 0; i < t.size(); i++) {
+    t[i] = min_travel_time_from_start_unchecked(rounded_towards_zero(v_1[i]),
+                                                rounded_towards_zero(v_2[i]),
+                                                v_m, a, d, s, s);
+  }
+}
+
+void cda_rail::max_travel_time_batch(std::span<const double> v_1,
+                                     std::span<const double> v_2, double v_m,
+                                     double a, double d, double s,
+                                     bool stopping_allowed,
+                                     std::span<double> t) {
+  check_batch_sizes(t.size(), {v_1.size(), v_2.size()});
+  check_consistency_of_eom_batch_input(v_1, v_2, a, d, s);
+  if (!stopping_allowed && !t.empty()) {
+    check_minimal_speed_of_max_travel_time_input(v_m);
+  }
+
+  a = rounded_towards_zero(a);
+  d = rounded_towards_zero(d);
+  s = rounded_towards_zero(s);
+  if (stopping_allowed) {
+    for (size_t i = 0; i < t.size(); i++) {
+      t[i] = max_travel_time_from_start_stopping_allowed_unchecked(
+          rounded_towards_zero(v_1[i]), rounded_towards_zero(v_2[i]), a, d, s,
+          s);
+    }
+  } else {
+    for (size_t i = 0; i < t.size(); i++) {
+      t[i] = max_travel_time_from_start_no_stopping_unchecked(
+          rounded_towards_zero(v_1[i]), rounded_towards_zero(v_2[i]), v_m, a,
+          d, s, s);
+    }
+  }
+}
+
+void cda_rail::time_on_edge_batch(std::span<const double> v_1,
+                                  std::span<const double> v_2,
+                                  std::span<const double> v_line, double a,
+                                  double d, double s, std::span<double> t) {
+  check_batch_sizes(t.size(), {v_1.size(), v_2.size(), v_line.size()});
+  for (size_t i = 0; i < t.size(); i++) {
+    double v_1_i    = v_1[i];
+    double v_2_i    = v_2[i];
+    double v_line_i = v_line[i];
+    double a_i      = a;
+    double d_i      = d;
+    double s_i      = s;
+    check_consistency_of_time_on_edge_input(v_1_i, v_2_i, v_line_i, a_i, d_i,
+                                            s_i);
+  }
+
+  for (size_t i = 0; i < t.size(); i++) {
+    t[i] = time_on_edge_unchecked(v_1[i], v_2[i], v_line[i], a, d, s);
+  }
+}
+
+void cda_rail::pos_on_edge_at_time_batch(std::span<const double> v_1,
+                                         std::span<const double> v_2,
+                                         std::span<const double> v_line,
+                                         double a, double d, double s,
+                                         std::span<const double> t,
+                                         std::span<double>       pos) {
+  check_batch_sizes(pos.size(),
+                    {v_1.size(), v_2.size(), v_line.size(), t.size()});
+  for (size_t i = 0; i < pos.size(); i++) {
+    double v_1_i    = v_1[i];
+    double v_2_i    = v_2[i];
+    double v_line_i = v_line[i];
+    double a_i      = a;
+    double d_i      = d;
+    double s_i      = s;
+    check_consistency_of_time_on_edge_input(v_1_i, v_2_i, v_line_i, a_i, d_i,
+                                            s_i);
+    if (t[i] > time_on_edge_unchecked(v_1[i], v_2[i], v_line[i], a, d, s) +
+                   GRB_EPS) {
+      // Rare case, the scalar version validates the exceeding time
+      pos[i] = pos_on_edge_at_time(v_1[i], v_2[i], v_line[i], a, d, s, t[i]);
+    }
+  }
+
+  for (size_t i = 0; i < pos.size(); i++) {
+    pos[i] =
+        pos_on_edge_at_time_unchecked(v_1[i], v_2[i], v_line[i], a, d, s, t[i]);
+  }
+}
+
+void cda_rail::get_line_speed_batch(std::span<const double> v_1,
+                                    std::span<const double> v_2, double v_min,
+                                    double v_max, double a, double d, double s,
+                                    std::span<const double> t,
+                                    std::span<double>       v_line) {
+  // The line speed depends on the case distinctions of the closed form, hence,
+  // the entries are evaluated one after another.
+  check_batch_sizes(v_line.size(), {v_1.size(), v_2.size(), t.size()});
+  for (size_t i = 0; i < v_line.size(); i++) {
+    v_line[i] = get_line_speed(v_1[i], v_2[i], v_min, v_max, a, d, s, t[i]);
+  }
+}
@@ -0,0 +1,41 @@
+#include "MemoryResource.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace {
+cda_rail::CountingMemoryResource& scratch_upstream() {
+  // Shared by the pools of all threads, new_delete_resource is thread-safe
+  static cda_rail::CountingMemoryResource resource;
+  return resource;
+}
+} // namespace
+
+void* cda_rail::CountingMemoryResource::do_allocate(size_t bytes_to_allocate,
+                                                    size_t alignment) {
+  void* p = upstream->allocate(bytes_to_allocate, alignment);
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytes.fetch_add(bytes_to_allocate, std::memory_order_relaxed);
+  return p;
+}
+
+void cda_rail::CountingMemoryResource::do_deallocate(void*  p,
+                                                     size_t bytes_to_deallocate,
+                                                     size_t alignment) {
+  upstream->deallocate(p, bytes_to_deallocate, alignment);
+  deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::pmr::memory_resource* cda_rail::thread_scratch_pool() {
+  /**
+   * Returns the scratch pool of the calling thread. It is not synchronized,
+   * hence, it must not be shared with other threads.
+   */
+
+  thread_local std::pmr::unsynchronized_pool_resource pool(&scratch_upstream());
+  return &pool;
+}
+
+cda_rail::AllocationCounters cda_rail::scratch_allocation_counters() {
+  return scratch_upstream().get_counters();
+}
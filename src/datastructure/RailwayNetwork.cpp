@@ -2,6 +2,7 @@
 
 #include "CustomExceptions.hpp"
 #include "Definitions.hpp"
+#include "MemoryResource.hpp"
 #include "VSSModel.hpp"
 #include "nlohmann/json.hpp"
 #include "nlohmann/json_fwd.hpp"
@@ -15,6 +16,7 @@
 #include <functional>
 #include <ios>
 #include <limits>
+#include <memory_resource>
 #include <optional>
 #include <queue>
 #include <sstream>
@@ -288,7 +290,17 @@ size_t cda_rail::Network::add_edge(size_t source, size_t target, double length,
   edges.emplace_back(source, target, length, max_speed, breakable,
                      min_block_length, min_stop_block_length);
   successors.emplace_back();
-  return edges.size() - 1;
+
+  const auto edge_index = edges.size() - 1;
+  reverse_edge_indices.emplace_back();
+  if (has_edge(target, source)) {
+    const auto reverse_edge_index            = get_edge_index(target, source);
+    reverse_edge_indices[edge_index]         = reverse_edge_index;
+    reverse_edge_indices[reverse_edge_index] = edge_index;
+  }
+  unbreakable_sections_up_to_date = false;
+
+  return edge_index;
 }
 
 void cda_rail::Network::add_successor(size_t edge_in, size_t edge_out) {
@@ -531,7 +543,8 @@ void cda_rail::Network::set_edge_breakable(size_t index) {
   if (!has_edge(index)) {
     throw exceptions::EdgeNotExistentException(index);
   }
-  edges[index].breakable = true;
+  edges[index].breakable          = true;
+  unbreakable_sections_up_to_date = false;
 }
 
 void cda_rail::Network::set_edge_unbreakable(size_t index) {
@@ -543,7 +556,8 @@ void cda_rail::Network::set_edge_unbreakable(size_t index) {
   if (!has_edge(index)) {
     throw exceptions::EdgeNotExistentException(index);
   }
-  edges[index].breakable = false;
+  edges[index].breakable          = false;
+  unbreakable_sections_up_to_date = false;
 }
 
 cda_rail::index_vector cda_rail::Network::out_edges(size_t index) const {
@@ -885,6 +899,7 @@ cda_rail::Network::Network(const std::filesystem::path& p) {
 
   this->read_graphml(p);
   this->read_successors(p);
+  this->update_edge_annotations();
 }
 
 bool cda_rail::Network::is_adjustable(size_t vertex_id) const {
@@ -1047,6 +1062,9 @@ cda_rail::Network::separate_edge_at(
     }
   }
 
+  // Sources of the original edges have changed
+  update_edge_annotations();
+
   return return_edges;
 }
 
@@ -1116,8 +1134,9 @@ cda_rail::index_vector cda_rail::Network::relevant_breakable_edges() const {
   for (size_t i = 0; i < number_of_edges(); ++i) {
     const auto& edge = get_edge(i);
     // add edge only if reverse edge does not exist or has larger index
-    if (edge.breakable && (!has_edge(edge.target, edge.source) ||
-                           get_edge_index(edge.target, edge.source) > i)) {
+    if (const auto reverse_edge_index = reverse_edge_indices.at(i);
+        edge.breakable &&
+        (!reverse_edge_index.has_value() || reverse_edge_index.value() > i)) {
       ret_val.emplace_back(i);
     }
   }
@@ -1363,7 +1382,8 @@ void cda_rail::Network::change_vertex_type(size_t index, VertexType new_type) {
   if (!has_vertex(index)) {
     throw exceptions::VertexNotExistentException(index);
   }
-  vertices[index].type = new_type;
+  vertices[index].type            = new_type;
+  unbreakable_sections_up_to_date = false;
 }
 
 std::vector<std::pair<std::optional<size_t>, std::optional<size_t>>>
@@ -1416,11 +1436,7 @@ cda_rail::Network::get_reverse_edge_index(size_t edge_index) const {
     throw exceptions::EdgeNotExistentException(edge_index);
   }
 
-  if (const auto& edge = get_edge(edge_index);
-      has_edge(edge.target, edge.source)) {
-    return get_edge_index(edge.target, edge.source);
-  }
-  return {};
+  return reverse_edge_indices.at(edge_index);
 }
 
 size_t cda_rail::Network::get_track_index(size_t edge_index) const {
@@ -1781,45 +1797,72 @@ cda_rail::Network::all_routes_of_given_length(
     }
   }
 
+  // Paths of the recursion are only needed during this call
+  std::pmr::monotonic_buffer_resource arena(cda_rail::thread_scratch_pool());
   std::vector<cda_rail::index_vector> ret_val;
-
   for (const auto& e_index : edges_to_consider) {
-    if (!reverse_direction && exit_node.has_value() &&
-        get_edge(e_index).target == exit_node.value()) {
-      ret_val.emplace_back(1, e_index);
-      continue;
+    for (const auto& path : all_routes_of_given_length_from_edge(
+             e_index, desired_length, reverse_direction, exit_node,
+             edges_used_by_train, &arena)) {
+      ret_val.emplace_back(path.begin(), path.end());
     }
+  }
 
-    const auto& e_len = get_edge(e_index).length;
+  return ret_val;
+}
 
-    if (e_len >= desired_length) {
-      ret_val.emplace_back(1, e_index);
-      continue;
-    }
+std::pmr::vector<std::pmr::vector<size_t>>
+cda_rail::Network::all_routes_of_given_length_from_edge(
+    size_t e_0, double desired_length, bool reverse_direction,
+    std::optional<size_t>         exit_node,
+    const cda_rail::index_vector& edges_used_by_train,
+    std::pmr::memory_resource*    resource) const {
+  /**
+   * Recursion of all_routes_of_given_length for routes starting with edge e_0.
+   * All paths are allocated from resource.
+   */
 
-    const auto next_edges =
-        reverse_direction ? get_predecessors(e_index) : get_successors(e_index);
-
-    for (const auto& e_next_index : next_edges) {
-      const auto paths_e_next = all_routes_of_given_length(
-          std::nullopt, e_next_index, desired_length - e_len, reverse_direction,
-          exit_node, edges_used_by_train);
-      for (const auto& path_e_next : paths_e_next) {
-        // check for cycle
-        const auto edges_r = reverse_direction
-                                 ? in_edges(get_edge(e_index).target)
-                                 : out_edges(get_edge(e_index).source);
-        if (std::ranges::any_of(edges_r, [&path_e_next](const auto& e) {
-              return std::ranges::contains(path_e_next, e);
-            })) {
-          continue;
-        }
+  std::pmr::vector<std::pmr::vector<size_t>> ret_val(resource);
+
+  if (!reverse_direction && exit_node.has_value() &&
+      get_edge(e_0).target == exit_node.value()) {
+    ret_val.emplace_back(1, e_0);
+    return ret_val;
+  }
+
+  const auto& e_len = get_edge(e_0).length;
+
+  if (e_len >= desired_length) {
+    ret_val.emplace_back(1, e_0);
+    return ret_val;
+  }
 
-        cda_rail::index_vector path;
-        path.emplace_back(e_index);
-        path.insert(path.end(), path_e_next.begin(), path_e_next.end());
-        ret_val.push_back(path);
+  const auto next_edges =
+      reverse_direction ? get_predecessors(e_0) : get_successors(e_0);
+  // Paths containing these edges would lead back to e_0
+  const auto edges_r = reverse_direction ? in_edges(get_edge(e_0).target)
+                                         : out_edges(get_edge(e_0).source);
+
+  for (const auto& e_next_index : next_edges) {
+    if (!edges_used_by_train.empty() &&
+        !std::ranges::contains(edges_used_by_train, e_next_index)) {
+      continue;
+    }
+    const auto paths_e_next = all_routes_of_given_length_from_edge(
+        e_next_index, desired_length - e_len, reverse_direction, exit_node,
+        edges_used_by_train, resource);
+    for (const auto& path_e_next : paths_e_next) {
+      // check for cycle
+      if (std::ranges::any_of(edges_r, [&path_e_next](const auto& e) {
+            return std::ranges::contains(path_e_next, e);
+          })) {
+        continue;
       }
+
+      auto& path = ret_val.emplace_back();
+      path.reserve(path_e_next.size() + 1);
+      path.emplace_back(e_0);
+      path.insert(path.end(), path_e_next.begin(), path_e_next.end());
     }
   }
 
@@ -1981,6 +2024,11 @@ cda_rail::Network::get_unbreakable_section_containing_edge(size_t e) const {
     return {};
   }
 
+  if (unbreakable_sections_up_to_date) {
+    return edge_unbreakable_sections.at(
+        unbreakable_section_indices.at(e).value());
+  }
+
   cda_rail::index_vector ret_val;
   ret_val.emplace_back(e);
   const auto reverse_e = get_reverse_edge_index(e);
@@ -2042,10 +2090,112 @@ bool cda_rail::Network::is_on_same_unbreakable_section(size_t e1,
    * unbreakable section.
    */
 
+  if (unbreakable_sections_up_to_date) {
+    if (get_edge(e1).breakable) {
+      return false;
+    }
+    const auto section_index = unbreakable_section_indices.at(e1).value();
+    return std::ranges::contains(edge_unbreakable_sections.at(section_index),
+                                 e2);
+  }
+
   const auto section_tmp = get_unbreakable_section_containing_edge(e1);
   return std::ranges::contains(section_tmp, e2);
 }
 
+void cda_rail::Network::update_edge_annotations() {
+  /**
+   * Recomputes the per-edge topology annotations, i.e., the reverse edge and
+   * the unbreakable section containing every unbreakable edge, in linear time.
+   * Sections coincide with the ones returned by the search in
+   * get_unbreakable_section_containing_edge: An edge with an endpoint that is
+   * neither of type TTD nor VSS belongs to all edges incident to the connected
+   * component of such vertices. All other edges form a section together with
+   * their reverse edge.
+   */
+
+  std::vector<cda_rail::index_vector> out_edges_of_vertex(number_of_vertices());
+  std::vector<cda_rail::index_vector> incident_edges(number_of_vertices());
+  for (size_t e = 0; e < number_of_edges(); ++e) {
+    out_edges_of_vertex[edges[e].source].emplace_back(e);
+    incident_edges[edges[e].source].emplace_back(e);
+    incident_edges[edges[e].target].emplace_back(e);
+  }
+
+  reverse_edge_indices.assign(number_of_edges(), std::nullopt);
+  for (size_t e = 0; e < number_of_edges(); ++e) {
+    for (const auto& e_out : out_edges_of_vertex[edges[e].target]) {
+      if (edges[e_out].target == edges[e].source) {
+        reverse_edge_indices[e] = e_out;
+        break;
+      }
+    }
+  }
+
+  const auto extends_section = [this](size_t v) {
+    return vertices[v].type != VertexType::TTD &&
+           vertices[v].type != VertexType::VSS;
+  };
+
+  // Connected components of vertices that extend a section
+  edge_unbreakable_sections.clear();
+  unbreakable_section_indices.assign(number_of_edges(), std::nullopt);
+  std::vector<std::optional<size_t>> vertex_section(number_of_vertices());
+  std::vector<bool>                  edge_added(number_of_edges(), false);
+  for (size_t v_0 = 0; v_0 < number_of_vertices(); ++v_0) {
+    if (vertex_section[v_0].has_value() || !extends_section(v_0)) {
+      continue;
+    }
+    const auto section_index = edge_unbreakable_sections.size();
+    auto&      section       = edge_unbreakable_sections.emplace_back();
+
+    std::queue<size_t> vertices_to_visit;
+    vertices_to_visit.push(v_0);
+    vertex_section[v_0] = section_index;
+    while (!vertices_to_visit.empty()) {
+      const auto v = vertices_to_visit.front();
+      vertices_to_visit.pop();
+      for (const auto& e : incident_edges[v]) {
+        if (!edge_added[e]) {
+          edge_added[e] = true;
+          section.emplace_back(e);
+        }
+        const auto w =
+            (edges[e].source == v) ? edges[e].target : edges[e].source;
+        if (!vertex_section[w].has_value() && extends_section(w)) {
+          vertex_section[w] = section_index;
+          vertices_to_visit.push(w);
+        }
+      }
+    }
+  }
+
+  for (size_t e = 0; e < number_of_edges(); ++e) {
+    if (edges[e].breakable) {
+      continue;
+    }
+    if (vertex_section[edges[e].source].has_value()) {
+      unbreakable_section_indices[e] = vertex_section[edges[e].source];
+    } else if (vertex_section[edges[e].target].has_value()) {
+      unbreakable_section_indices[e] = vertex_section[edges[e].target];
+    } else if (const auto reverse_e = reverse_edge_indices[e];
+               reverse_e.has_value() &&
+               unbreakable_section_indices[reverse_e.value()].has_value()) {
+      unbreakable_section_indices[e] =
+          unbreakable_section_indices[reverse_e.value()];
+    } else {
+      unbreakable_section_indices[e] = edge_unbreakable_sections.size();
+      auto& section                  = edge_unbreakable_sections.emplace_back();
+      section.emplace_back(e);
+      if (reverse_e.has_value()) {
+        section.emplace_back(reverse_e.value());
+      }
+    }
+  }
+
+  unbreakable_sections_up_to_date = true;
+}
+
 std::pair<std::optional<double>, cda_rail::index_vector>
 cda_rail::Network::shortest_path_between_sets_using_edges(
     cda_rail::index_vector source_edge_ids, cda_rail::index_vector target_ids,
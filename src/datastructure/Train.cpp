@@ -8,7 +8,9 @@
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include <string>
+#include <tuple>
 
 using json = nlohmann::json;
 
@@ -89,6 +91,29 @@ cda_rail::Train& cda_rail::TrainList::editable_tr(size_t index) {
   return trains.at(index);
 }
 
+std::vector<size_t> cda_rail::TrainList::get_train_classes() const {
+  /**
+   * Groups the trains by their physical properties, i.e., length, maximal
+   * speed, acceleration, and deceleration. Trains of the same class can share
+   * all preprocessing that only depends on these properties.
+   *
+   * @return For every train the index of its class. Classes are numbered in
+   * order of their first train.
+   */
+  std::map<std::tuple<double, double, double, double>, size_t> class_indices;
+  std::vector<size_t>                                          train_classes;
+  train_classes.reserve(trains.size());
+  for (const auto& tr : trains) {
+    const auto class_it = class_indices
+                              .try_emplace({tr.length, tr.max_speed,
+                                            tr.acceleration, tr.deceleration},
+                                           class_indices.size())
+                              .first;
+    train_classes.push_back(class_it->second);
+  }
+  return train_classes;
+}
+
 void cda_rail::TrainList::export_trains(const std::filesystem::path& p) const {
   /**
    * This method exports all trains to a directory in trains.json.
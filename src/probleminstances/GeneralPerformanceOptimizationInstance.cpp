@@ -6,6 +6,11 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 void cda_rail::instances::GeneralPerformanceOptimizationInstance::
     discretize_stops() {
@@ -24,6 +29,69 @@ void cda_rail::instances::GeneralPerformanceOptimizationInstance::
   }
 }
 
+std::vector<cda_rail::index_vector> cda_rail::instances::
+    GeneralPerformanceOptimizationInstance::get_symmetric_train_groups() const {
+  /**
+   * Trains are interchangeable if they have the same physical properties,
+   * schedule (including all time windows and stops), weight, optionality, and
+   * fixed route. Exchanging two such trains maps every solution to a solution
+   * with the same objective.
+   *
+   * @return Groups of at least two interchangeable trains, each sorted by
+   * index. Groups are ordered by their first train.
+   */
+
+  using StopKey = std::tuple<std::pair<int, int>, std::pair<int, int>, int,
+                             std::string>;
+  using TrainKey =
+      std::tuple<size_t, bool, std::pair<int, int>, double, size_t,
+                 std::pair<int, int>, double, size_t, std::vector<StopKey>,
+                 double, bool, bool, cda_rail::index_vector>;
+
+  const auto& train_list    = this->get_train_list();
+  const auto  train_classes = train_list.get_train_classes();
+
+  std::map<TrainKey, size_t>          group_indices;
+  std::vector<cda_rail::index_vector> groups;
+  for (size_t tr = 0; tr < train_list.size(); ++tr) {
+    const auto& tr_name  = train_list.get_train(tr).name;
+    const auto& schedule = this->get_timetable().get_schedule(tr);
+
+    std::vector<StopKey> stops;
+    stops.reserve(schedule.get_stops().size());
+    for (const auto& stop : schedule.get_stops()) {
+      stops.emplace_back(stop.get_begin_range(), stop.get_end_range(),
+                         stop.get_min_stopping_time(),
+                         stop.get_station_name());
+    }
+    const bool has_route = this->has_route(tr_name);
+
+    TrainKey key{train_classes.at(tr),
+                 train_list.get_train(tr).tim,
+                 schedule.get_t_0_range(),
+                 schedule.get_v_0(),
+                 schedule.get_entry(),
+                 schedule.get_t_n_range(),
+                 schedule.get_v_n(),
+                 schedule.get_exit(),
+                 std::move(stops),
+                 train_weights.at(tr),
+                 train_optional.at(tr),
+                 has_route,
+                 has_route ? this->get_route(tr_name).get_edges()
+                           : cda_rail::index_vector{}};
+    const auto [it, inserted] =
+        group_indices.try_emplace(std::move(key), groups.size());
+    if (inserted) {
+      groups.emplace_back();
+    }
+    groups.at(it->second).push_back(tr);
+  }
+
+  std::erase_if(groups, [](const auto& group) { return group.size() < 2; });
+  return groups;
+}
+
 double cda_rail::instances::GeneralPerformanceOptimizationInstance::
     get_approximate_leaving_time(size_t train) const {
   const auto& tr_object = this->get_train_list().get_train(train);
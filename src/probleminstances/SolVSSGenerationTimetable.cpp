@@ -7,6 +7,7 @@
 #include "nlohmann/json_fwd.hpp"
 #include "plog/Severity.h"
 #include "probleminstances/GeneralProblemInstance.hpp"
+#include "probleminstances/SolutionWriter.hpp"
 #include "probleminstances/VSSGenerationTimetable.hpp"
 #include "solver/mip-based/VSSGenTimetableSolver.hpp"
 
@@ -319,42 +320,70 @@ void cda_rail::instances::SolVSSGenerationTimetable::export_solution(
   data_file << data << '\n';
   data_file.close();
 
-  json vss_pos_json;
+  // vss_pos, train_pos and train_speed are streamed, since trajectories can be
+  // large
+  std::ofstream vss_pos_file(p / "solution" / "vss_pos.json");
+  vss_pos_file.put('{');
   for (size_t edge_id = 0; edge_id < instance.const_n().number_of_edges();
        ++edge_id) {
     const auto& edge = instance.const_n().get_edge(edge_id);
     const auto& v0   = instance.const_n().get_vertex(edge.source).name;
     const auto& v1   = instance.const_n().get_vertex(edge.target).name;
-    vss_pos_json["('" + v0 + "', '" + v1 + "')"] = vss_pos.at(edge_id);
+    if (edge_id > 0) {
+      vss_pos_file.put(',');
+    }
+    write_json_string(vss_pos_file, "('" + v0 + "', '" + v1 + "')");
+    vss_pos_file << ":[";
+    for (size_t i = 0; i < vss_pos.at(edge_id).size(); ++i) {
+      if (i > 0) {
+        vss_pos_file.put(',');
+      }
+      write_json_number(vss_pos_file, vss_pos.at(edge_id).at(i));
+    }
+    vss_pos_file.put(']');
   }
-
-  std::ofstream vss_pos_file(p / "solution" / "vss_pos.json");
-  vss_pos_file << vss_pos_json << '\n';
+  vss_pos_file << "}\n";
   vss_pos_file.close();
 
-  json train_pos_json;
-  json train_speed_json;
+  write_time_indexed_json(p / "solution" / "train_pos.json", train_pos);
+  write_time_indexed_json(p / "solution" / "train_speed.json", train_speed);
+}
+
+void cda_rail::instances::SolVSSGenerationTimetable::write_time_indexed_json(
+    const std::filesystem::path&            file,
+    const std::vector<std::vector<double>>& values) const {
+  /**
+   * Streams {"<train name>": {"<t>": value, ...}, ...} to file, where value is
+   * the entry of the time index corresponding to time t.
+   *
+   * @param file the path of the json file
+   * @param values for every train, the values at its time indices
+   */
+
+  std::ofstream os(file);
+  os.put('{');
   for (size_t tr_id = 0; tr_id < instance.get_train_list().size(); ++tr_id) {
     const auto& train       = instance.get_train_list().get_train(tr_id);
     const auto  tr_interval = instance.time_index_interval(tr_id, dt, true);
-    json        train_pos_json_tmp;
-    json        train_speed_json_tmp;
-    for (size_t t_id = 0; t_id < train_pos.at(tr_id).size(); ++t_id) {
+    if (tr_id > 0) {
+      os.put(',');
+    }
+    write_json_string(os, train.name);
+    os.put(':');
+    os.put('{');
+    for (size_t t_id = 0; t_id < values.at(tr_id).size(); ++t_id) {
       const auto t = static_cast<int>(tr_interval.first + t_id) * dt;
-      train_pos_json_tmp[std::to_string(t)]   = train_pos.at(tr_id).at(t_id);
-      train_speed_json_tmp[std::to_string(t)] = train_speed.at(tr_id).at(t_id);
+      if (t_id > 0) {
+        os.put(',');
+      }
+      write_json_string(os, std::to_string(t));
+      os.put(':');
+      write_json_number(os, values.at(tr_id).at(t_id));
     }
-    train_pos_json[train.name]   = train_pos_json_tmp;
-    train_speed_json[train.name] = train_speed_json_tmp;
+    os.put('}');
   }
-
-  std::ofstream train_pos_file(p / "solution" / "train_pos.json");
-  train_pos_file << train_pos_json << '\n';
-  train_pos_file.close();
-
-  std::ofstream train_speed_file(p / "solution" / "train_speed.json");
-  train_speed_file << train_speed_json << '\n';
-  train_speed_file.close();
+  os << "}\n";
+  os.close();
 }
 
 cda_rail::instances::SolVSSGenerationTimetable::SolVSSGenerationTimetable(
@@ -491,7 +520,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
   } else if (model->get(GRB_IntAttr_SolCount) >= 1) {
     PLOGD << "Solution status: Feasible (optimality unknown)";
     sol_obj.set_status(SolutionStatus::Feasible);
-  } else if (grb_status == GRB_TIME_LIMIT &&
+  } else if ((grb_status == GRB_TIME_LIMIT || grb_status == GRB_INTERRUPTED) &&
              model->get(GRB_IntAttr_SolCount) == 0) {
     PLOGD << "Solution status: Timeout (Feasibility unknown)";
     sol_obj.set_status(SolutionStatus::Timeout);
@@ -569,11 +598,11 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
           for (size_t t = train_interval.at(tr).first;
                t <= train_interval.at(tr).second; ++t) {
             const auto front1 =
-                vars.at("b_front")
+                sparse_vars.at("b_front")
                     .at(tr, t, breakable_edge_indices.at(e_index), vss)
                     .get(GRB_DoubleAttr_X) > 0.5;
             const auto rear1 =
-                vars.at("b_rear")
+                sparse_vars.at("b_rear")
                     .at(tr, t, breakable_edge_indices.at(e_index), vss)
                     .get(GRB_DoubleAttr_X) > 0.5;
             const auto front2 =
@@ -582,7 +611,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
                       .trains_on_edge(reverse_edge_index.value(), fix_routes,
                                       {tr})
                       .empty())
-                    ? vars.at("b_front")
+                    ? sparse_vars.at("b_front")
                               .at(tr, t,
                                   breakable_edge_indices.at(
                                       reverse_edge_index.value()),
@@ -595,7 +624,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
                       .trains_on_edge(reverse_edge_index.value(), fix_routes,
                                       {tr})
                       .empty())
-                    ? vars.at("b_rear")
+                    ? sparse_vars.at("b_rear")
                               .at(tr, t,
                                   breakable_edge_indices.at(
                                       reverse_edge_index.value()),
@@ -648,7 +677,8 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
         std::unordered_set<size_t> edge_list;
         for (int e = 0; e < num_edges; ++e) {
           const auto tr_on_edge =
-              vars.at("x").at(tr, t, e).get(GRB_DoubleAttr_X) > 0.5;
+              sparse_vars.at("x").contains(tr, t, e) &&
+              sparse_vars.at("x").at(tr, t, e).get(GRB_DoubleAttr_X) > 0.5;
           if (tr_on_edge &&
               !sol_obj.get_instance().get_route(train.name).contains_edge(e) &&
               !edge_list.contains(e)) {
@@ -703,10 +733,13 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::extract_solution(
           for (auto e_index :
                sol_obj.get_instance().get_route(train.name).get_edges()) {
             const bool e_used =
-                vars.at("x").at(tr, t, e_index).get(GRB_DoubleAttr_X) > 0.5;
+                sparse_vars.at("x").contains(tr, t, e_index) &&
+                sparse_vars.at("x").at(tr, t, e_index).get(GRB_DoubleAttr_X) >
+                    0.5;
             if (e_used) {
-              const double lda_val =
-                  vars.at("e_lda").at(tr, t, e_index).get(GRB_DoubleAttr_X);
+              const double lda_val = sparse_vars.at("e_lda")
+                                         .at(tr, t, e_index)
+                                         .get(GRB_DoubleAttr_X);
               const double e_pos = sol_obj.get_instance()
                                        .route_edge_pos(train.name, e_index)
                                        .first;
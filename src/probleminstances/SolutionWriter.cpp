@@ -0,0 +1,262 @@
+#include "probleminstances/SolutionWriter.hpp"
+
+#include "CustomExceptions.hpp"
+#include "datastructure/Train.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+using std::size_t;
+
+namespace {
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+template <typename V>
+void write_binary_value(std::ostream& os, const V& value) {
+  os.write(reinterpret_cast<const char*>(&value), sizeof(V));
+}
+
+template <typename V> V read_binary_value(std::istream& is) {
+  V value{};
+  is.read(reinterpret_cast<char*>(&value), sizeof(V));
+  if (!is) {
+    throw cda_rail::exceptions::ImportException("binary trajectories");
+  }
+  return value;
+}
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+} // namespace
+
+void cda_rail::instances::write_json_string(std::ostream&    os,
+                                            std::string_view str) {
+  /**
+   * Writes a json string including quotes and escape sequences.
+   */
+
+  constexpr std::string_view hex_digits = "0123456789abcdef";
+
+  os.put('"');
+  for (const char c : str) {
+    switch (c) {
+    case '"':
+      os << "\\\"";
+      break;
+    case '\\':
+      os << "\\\\";
+      break;
+    case '\b':
+      os << "\\b";
+      break;
+    case '\f':
+      os << "\\f";
+      break;
+    case '\n':
+      os << "\\n";
+      break;
+    case '\r':
+      os << "\\r";
+      break;
+    case '\t':
+      os << "\\t";
+      break;
+    default:
+      if (const auto uc = static_cast<unsigned char>(c); uc < 0x20) {
+        os << "\\u00" << hex_digits[uc >> 4U] << hex_digits[uc & 0xFU];
+      } else {
+        os.put(c);
+      }
+    }
+  }
+  os.put('"');
+}
+
+void cda_rail::instances::write_json_number(std::ostream& os, double value) {
+  /**
+   * Writes the shortest representation of value that is parsed back to the
+   * same double. As in nlohmann::json, integral values keep a trailing ".0"
+   * and non-finite values are written as null.
+   */
+
+  if (!std::isfinite(value)) {
+    os << "null";
+    return;
+  }
+
+  std::array<char, 32> buffer{};
+  const auto [end, ec] =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  if (ec != std::errc()) {
+    throw exceptions::ExportException("Could not write number " +
+                                      std::to_string(value));
+  }
+  const std::string_view str(buffer.data(), end);
+  os << str;
+  if (str.find_first_of(".e") == std::string_view::npos) {
+    os << ".0";
+  }
+}
+
+void cda_rail::instances::write_trajectory_json(
+    const std::filesystem::path& file, const TrainList& train_list,
+    const std::vector<std::map<double, double>>& trajectories) {
+  /**
+   * Streams the trajectories of all trains to file using the same layout as
+   * the json serialization of std::map<double, double>.
+   *
+   * @param file: Path of the json file
+   * @param train_list: Trains, whose names are used as keys
+   * @param trajectories: For every train, a map from time to value
+   */
+
+  std::ofstream os(file);
+  if (!os) {
+    throw exceptions::ExportException("Could not open " + file.string());
+  }
+
+  os.put('{');
+  for (size_t tr = 0; tr < train_list.size(); ++tr) {
+    if (tr > 0) {
+      os.put(',');
+    }
+    write_json_string(os, train_list.get_train(tr).name);
+    os << ":[";
+    bool first = true;
+    for (const auto& [t, value] : trajectories.at(tr)) {
+      if (!first) {
+        os.put(',');
+      }
+      first = false;
+      os.put('[');
+      write_json_number(os, t);
+      os.put(',');
+      write_json_number(os, value);
+      os.put(']');
+    }
+    os.put(']');
+  }
+  os << "}\n";
+
+  if (!os) {
+    throw exceptions::ExportException("Could not write " + file.string());
+  }
+}
+
+void cda_rail::instances::write_trajectory_binary(
+    const std::filesystem::path& file, const TrainList& train_list,
+    const std::vector<std::map<double, double>>& train_pos,
+    const std::vector<std::map<double, double>>& train_speed) {
+  /**
+   * Streams the trajectories of all trains to file in the columnar binary
+   * format described in SolutionWriter.hpp. Every position must have a speed
+   * at the same time.
+   *
+   * @param file: Path of the binary file
+   * @param train_list: Trains, whose names identify the trajectories
+   * @param train_pos: For every train, a map from time to position
+   * @param train_speed: For every train, a map from time to speed
+   */
+
+  std::ofstream os(file, std::ios::binary);
+  if (!os) {
+    throw exceptions::ExportException("Could not open " + file.string());
+  }
+
+  os.write(TRAJECTORY_BINARY_MAGIC.data(), TRAJECTORY_BINARY_MAGIC.size());
+  write_binary_value<std::uint64_t>(os, train_list.size());
+  for (size_t tr = 0; tr < train_list.size(); ++tr) {
+    const auto& name     = train_list.get_train(tr).name;
+    const auto& tr_pos   = train_pos.at(tr);
+    const auto& tr_speed = train_speed.at(tr);
+    write_binary_value<std::uint64_t>(os, name.size());
+    os.write(name.data(), static_cast<std::streamsize>(name.size()));
+    write_binary_value<std::uint64_t>(os, tr_pos.size());
+    for (const auto& [t, pos] : tr_pos) {
+      write_binary_value(os, t);
+    }
+    for (const auto& [t, pos] : tr_pos) {
+      write_binary_value(os, pos);
+    }
+    for (const auto& [t, pos] : tr_pos) {
+      write_binary_value(os, tr_speed.at(t));
+    }
+  }
+
+  if (!os) {
+    throw exceptions::ExportException("Could not write " + file.string());
+  }
+}
+
+std::pair<std::vector<std::map<double, double>>,
+          std::vector<std::map<double, double>>>
+cda_rail::instances::read_trajectory_binary(const std::filesystem::path& file,
+                                            const TrainList& train_list) {
+  /**
+   * Reads trajectories written by write_trajectory_binary. Trains are matched
+   * by name.
+   *
+   * @param file: Path of the binary file
+   * @param train_list: Trains of the corresponding instance
+   *
+   * @return: For every train, a map from time to position and a map from time
+   * to speed
+   */
+
+  std::ifstream is(file, std::ios::binary);
+  if (!is) {
+    throw exceptions::ImportException(file.string());
+  }
+
+  std::array<char, TRAJECTORY_BINARY_MAGIC.size()> magic{};
+  is.read(magic.data(), magic.size());
+  if (!is || magic != TRAJECTORY_BINARY_MAGIC) {
+    throw exceptions::ImportException(file.string());
+  }
+
+  std::vector<std::map<double, double>> train_pos(train_list.size());
+  std::vector<std::map<double, double>> train_speed(train_list.size());
+
+  const auto num_tr = read_binary_value<std::uint64_t>(is);
+  for (std::uint64_t i = 0; i < num_tr; ++i) {
+    std::string name(read_binary_value<std::uint64_t>(is), '\0');
+    is.read(name.data(), static_cast<std::streamsize>(name.size()));
+    if (!is) {
+      throw exceptions::ImportException(file.string());
+    }
+    if (!train_list.has_train(name)) {
+      throw exceptions::TrainNotExistentException(name);
+    }
+    const auto tr = train_list.get_train_index(name);
+
+    const auto          n = read_binary_value<std::uint64_t>(is);
+    std::vector<double> times;
+    for (std::uint64_t j = 0; j < n; ++j) {
+      times.push_back(read_binary_value<double>(is));
+    }
+    auto& tr_pos = train_pos.at(tr);
+    for (const auto t : times) {
+      tr_pos.insert_or_assign(tr_pos.end(), t, read_binary_value<double>(is));
+    }
+    auto& tr_speed = train_speed.at(tr);
+    for (const auto t : times) {
+      tr_speed.insert_or_assign(tr_speed.end(), t,
+                                read_binary_value<double>(is));
+    }
+  }
+
+  return {std::move(train_pos), std::move(train_speed)};
+}
@@ -5,8 +5,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <iterator>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -51,10 +53,110 @@ double cda_rail::simulator::simple_braking_time_heuristic(
   return ret_val;
 }
 
+cda_rail::simulator::RemainingTravelTimes
+cda_rail::simulator::remaining_travel_times(
+    size_t tr, const cda_rail::simulator::GreedySimulator& simulator) {
+  /**
+   * Calculates the travel times at maximum speed from the current position of
+   * a train to each of its remaining stops and from the last of them to the
+   * exit vertex. Acceleration, deceleration, and the train length are not
+   * considered.
+   *
+   * @param tr The train for which the travel times are calculated.
+   * @param simulator The simulator instance containing the train and its edges.
+   *
+   * @return The travel time of every remaining leg, the last one leading to the
+   * exit. std::nullopt if a remaining stop has no stop tracks.
+   */
+
+  const auto& tr_edges    = simulator.get_train_edges_of_tr(tr);
+  const auto& tr_schedule = simulator.get_instance()->get_schedule(tr);
+  const auto& tr_stops    = tr_schedule.get_stops();
+  const auto& tr_obj = simulator.get_instance()->get_train_list().get_train(tr);
+
+  const auto first_next_stop = simulator.get_stop_positions_of_tr(tr).size();
+
+  // Initial position of the train
+  auto start_edges =
+      tr_edges.empty()
+          ? cda_rail::index_vector{simulator.get_instance()
+                                       ->const_n()
+                                       .out_edges(tr_schedule.get_entry())}
+          : cda_rail::index_vector{tr_edges.back()};
+  bool include_first_edge = tr_edges.empty();
+
+  std::vector<double> travel_times;
+  travel_times.reserve(tr_stops.size() - first_next_stop + 1);
+  for (size_t next_stop = first_next_stop; next_stop < tr_stops.size();
+       ++next_stop) {
+    // Quickest path to next station
+    const auto& next_station_name = tr_stops.at(next_stop).get_station_name();
+    cda_rail::index_vector next_station_tracks;
+    const auto&            stop_tracks =
+        simulator.get_instance()->get_stop_tracks(tr, next_station_name);
+    next_station_tracks.reserve(stop_tracks.size());
+    std::transform(stop_tracks.begin(), stop_tracks.end(),
+                   std::back_inserter(next_station_tracks),
+                   [](const auto& track_pair) { return track_pair.first; });
+
+    if (next_station_tracks.empty()) {
+      return std::nullopt;
+    }
+    travel_times.push_back(simulator.get_instance()
+                               ->const_n()
+                               .shortest_path_between_sets(
+                                   start_edges, next_station_tracks, true,
+                                   include_first_edge, true, tr_obj.max_speed)
+                               .value_or(cda_rail::INF));
+
+    // Initialize next iteration
+    start_edges        = std::move(next_station_tracks);
+    include_first_edge = false;
+  }
+
+  // Move to exit vertex
+  travel_times.push_back(simulator.get_instance()
+                             ->const_n()
+                             .shortest_path_between_sets(
+                                 start_edges, {tr_schedule.get_exit()}, false,
+                                 include_first_edge, true, tr_obj.max_speed)
+                             .value_or(cda_rail::INF));
+
+  return travel_times;
+}
+
+const cda_rail::simulator::RemainingTravelTimes&
+cda_rail::simulator::RemainingTimeHeuristicCache::travel_times(
+    size_t tr, const cda_rail::simulator::GreedySimulator& simulator) {
+  /**
+   * Returns the remaining travel times of a train, which are only calculated
+   * if the train's last edge and number of served stops are seen for the first
+   * time.
+   */
+
+  // Trains that have not entered the network are keyed by an invalid edge
+  const auto& tr_edges = simulator.get_train_edges_of_tr(tr);
+  const auto  last_edge =
+      tr_edges.empty() ? simulator.get_instance()->const_n().number_of_edges()
+                       : tr_edges.back();
+  const Key key{.tr           = tr,
+                .last_edge    = last_edge,
+                .stops_served = simulator.get_stop_positions_of_tr(tr).size()};
+
+  const auto it = travel_times_map.find(key);
+  if (it != travel_times_map.end()) {
+    hits++;
+    return it->second;
+  }
+  return travel_times_map.emplace(key, remaining_travel_times(tr, simulator))
+      .first->second;
+}
+
 std::pair<bool, double> cda_rail::simulator::simple_remaining_time_heuristic(
     size_t tr, const cda_rail::simulator::GreedySimulator& simulator,
     double tr_exit_time, double braking_time_heuristic, bool late_stop_possible,
-    bool late_exit_possible, bool consider_earliest_exit) {
+    bool late_exit_possible, bool consider_earliest_exit,
+    cda_rail::simulator::RemainingTimeHeuristicCache* cache) {
   /**
    * This heuristic calculates the remaining time for a train to exit the
    * network. It is assumed that the train will travel at its maximum speed.
@@ -71,6 +173,8 @@ std::pair<bool, double> cda_rail::simulator::simple_remaining_time_heuristic(
    * planned.
    * @param consider_earliest_exit If true, the heuristic will consider the
    * earliest exit time of each station and exit point.
+   * @param cache If not nullptr, remaining travel times are looked up in and
+   * stored to this cache.
    *
    * @return A pair containing:
    * - bool: indicates if a valid timetable can still be achieved
@@ -103,37 +207,22 @@ std::pair<bool, double> cda_rail::simulator::simple_remaining_time_heuristic(
 
   const auto first_next_stop = simulator.get_stop_positions_of_tr(tr).size();
 
-  // Initial position of the train
-  auto start_edges =
-      tr_edges.empty()
-          ? cda_rail::index_vector{simulator.get_instance()
-                                       ->const_n()
-                                       .out_edges(tr_schedule.get_entry())}
-          : cda_rail::index_vector{tr_edges.back()};
-  bool include_first_edge = tr_edges.empty();
+  // Without a cache, the travel times are calculated for this call only
+  const auto uncached_travel_times =
+      cache == nullptr ? remaining_travel_times(tr, simulator)
+                       : RemainingTravelTimes{};
+  const auto& travel_times =
+      cache == nullptr ? uncached_travel_times
+                       : cache->travel_times(tr, simulator);
+  if (!travel_times.has_value()) {
+    return {false, cda_rail::INF};
+  }
 
   bool feasible = true;
   for (size_t next_stop = first_next_stop; next_stop < tr_stops.size();
        ++next_stop) {
     // Quickest path to next station
-    const auto& next_station_name = tr_stops.at(next_stop).get_station_name();
-    cda_rail::index_vector next_station_tracks;
-    const auto&            stop_tracks =
-        simulator.get_instance()->get_stop_tracks(tr, next_station_name);
-    next_station_tracks.reserve(stop_tracks.size());
-    std::transform(stop_tracks.begin(), stop_tracks.end(),
-                   std::back_inserter(next_station_tracks),
-                   [](const auto& track_pair) { return track_pair.first; });
-
-    if (next_station_tracks.empty()) {
-      return {false, cda_rail::INF};
-    }
-    heuristic_exit_time += simulator.get_instance()
-                               ->const_n()
-                               .shortest_path_between_sets(
-                                   start_edges, next_station_tracks, true,
-                                   include_first_edge, true, tr_obj.max_speed)
-                               .value_or(cda_rail::INF);
+    heuristic_exit_time += travel_times->at(next_stop - first_next_stop);
 
     if (!late_stop_possible &&
         heuristic_exit_time > tr_stops.at(next_stop).get_begin_range().second) {
@@ -152,19 +241,10 @@ std::pair<bool, double> cda_rail::simulator::simple_remaining_time_heuristic(
           heuristic_exit_time,
           static_cast<double>(tr_stops.at(next_stop).get_end_range().first));
     }
-
-    // Initialize next iteration
-    start_edges        = std::move(next_station_tracks);
-    include_first_edge = false;
   }
 
   // Move to exit vertex
-  heuristic_exit_time += simulator.get_instance()
-                             ->const_n()
-                             .shortest_path_between_sets(
-                                 start_edges, {tr_schedule.get_exit()}, false,
-                                 include_first_edge, true, tr_obj.max_speed)
-                             .value_or(cda_rail::INF);
+  heuristic_exit_time += travel_times->back();
   heuristic_exit_time +=
       tr_obj.length /
       tr_obj.max_speed; // Only left after fully leaving the network
@@ -180,3 +260,66 @@ std::pair<bool, double> cda_rail::simulator::simple_remaining_time_heuristic(
 
   return {feasible, heuristic_exit_time - rel_exit_time};
 }
+
+double cda_rail::simulator::pairwise_exit_conflict_heuristic(
+    const cda_rail::simulator::GreedySimulator&  simulator,
+    const cda_rail::simulator::SimulatorResults& sim_results,
+    const std::vector<double>&                   tr_exit_estimates) {
+  /**
+   * This heuristic bounds the delay caused by the headway of exit vertices,
+   * which the per train heuristics ignore. Orders at a vertex are only
+   * extended, hence, a train that has not yet been ordered at its exit vertex
+   * cannot pass it before the vertex headway of the simulated trains expires.
+   * Moreover, two such trains exit at least the headway apart, in whichever
+   * order. Lower bounds of disjoint pairs can be added up.
+   *
+   * @param simulator The simulator instance containing the current orders.
+   * @param sim_results The results of simulating the current state.
+   * @param tr_exit_estimates For every train, a lower bound on its exit time.
+   *
+   * @return The weighted additional delay, which is non-negative.
+   */
+
+  const auto& instance      = *simulator.get_instance();
+  const auto& weights       = instance.get_train_weights();
+  const auto& vertex_orders = simulator.get_vertex_orders();
+
+  std::vector<cda_rail::index_vector> unordered_trains(
+      instance.const_n().number_of_vertices());
+  for (size_t tr = 0; tr < tr_exit_estimates.size(); ++tr) {
+    const auto exit_vertex = instance.get_schedule(tr).get_exit();
+    if (!std::ranges::contains(vertex_orders.at(exit_vertex), tr)) {
+      unordered_trains.at(exit_vertex).push_back(tr);
+    }
+  }
+
+  double obj = 0.0;
+  for (size_t v = 0; v < unordered_trains.size(); ++v) {
+    const auto& trains = unordered_trains.at(v);
+    if (trains.empty()) {
+      continue;
+    }
+
+    // Trains follow the ones already simulated at this vertex
+    std::vector<std::pair<double, size_t>> lower_bounds;
+    lower_bounds.reserve(trains.size());
+    for (const auto tr : trains) {
+      const auto lb =
+          std::max(tr_exit_estimates.at(tr), sim_results.vertex_headways.at(v));
+      obj += weights.at(tr) * (lb - tr_exit_estimates.at(tr));
+      lower_bounds.emplace_back(lb, tr);
+    }
+
+    // Pairs of consecutive trains have to be separated by the headway
+    const auto headway = std::ceil(instance.const_n().get_vertex(v).headway);
+    std::ranges::sort(lower_bounds);
+    for (size_t i = 0; i + 1 < lower_bounds.size(); i += 2) {
+      const auto& [lb1, tr1] = lower_bounds.at(i);
+      const auto& [lb2, tr2] = lower_bounds.at(i + 1);
+      obj += std::min(weights.at(tr2) * std::max(lb1 + headway - lb2, 0.0),
+                      weights.at(tr1) * std::max(lb2 + headway - lb1, 0.0));
+    }
+  }
+
+  return obj;
+}
@@ -3,20 +3,26 @@
 #include "CustomExceptions.hpp"
 #include "Definitions.hpp"
 #include "EOMHelper.hpp"
+#include "MemoryResource.hpp"
 #include "plog/Log.h"
 #include "simulator/GeneralSimulator.hpp"
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
+#include <iterator>
 #include <limits>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -52,8 +58,64 @@ cda_rail::simulator::GreedySimulator::simulate(
    *  - a vector with the braking times and distances due to route ending for
    * every train,
    *  - a vector of doubles with the final vertex headways
+   *
+   * The options are dispatched to a compile-time specialized simulation loop,
+   * see simulate_with_options.
+   */
+
+  // Instantiation i uses bit k of i as the k-th boolean option
+  static constexpr auto simulate_instantiations =
+      []<size_t... Is>(std::index_sequence<Is...> /*options*/) {
+        return std::array{&GreedySimulator::simulate_with_options<
+            (Is & 1U) != 0, (Is & 2U) != 0, (Is & 4U) != 0, (Is & 8U) != 0,
+            (Is & 16U) != 0>...};
+      }(std::make_index_sequence<32>{});
+
+  const size_t options = (late_entry_possible ? 1U : 0U) |
+                         (late_exit_possible ? 2U : 0U) |
+                         (late_stop_possible ? 4U : 0U) |
+                         (limit_speed_by_leaving_edges ? 8U : 0U) |
+                         (save_trajectories ? 16U : 0U);
+  return (this->*simulate_instantiations.at(options))(dt);
+}
+
+std::vector<std::map<double, cda_rail::simulator::PosVel>>
+cda_rail::simulator::GreedySimulator::FlatTrajectoryRecorder::extract(
+    size_t num_tr) const {
+  /**
+   * Converts the recorded entries into one map from time to position and
+   * velocity per train. Entries are recorded in increasing time, hence, every
+   * insertion happens at the end of the respective map.
+   *
+   * @param num_tr: Number of trains
+   *
+   * @return: For every train, a map of time to position and velocity
+   */
+
+  std::vector<std::map<double, PosVel>> train_trajectories(num_tr);
+  for (const auto& entry : entries) {
+    auto& trajectory = train_trajectories.at(entry.tr);
+    trajectory.insert_or_assign(trajectory.end(), entry.t, entry.pos_vel);
+  }
+  return train_trajectories;
+}
+
+template <bool LateEntryPossible, bool LateExitPossible, bool LateStopPossible,
+          bool LimitSpeedByLeavingEdges, bool SaveTrajectories>
+cda_rail::simulator::SimulatorResults
+cda_rail::simulator::GreedySimulator::simulate_with_options(int dt) const {
+  /**
+   * Simulation loop of simulate with the boolean options fixed at compile
+   * time, so that every combination is optimized separately. Trajectories are
+   * recorded by a policy: if they are not saved, recording is a no-op,
+   * otherwise every movement is appended to a preallocated flat buffer.
+   *
+   * @param dt: The time step for the simulation in seconds
+   *
+   * @return: See simulate
    */
 
+
   cda_rail::initialize_plog(false);
 
   // Initialize return values
@@ -67,8 +129,9 @@ cda_rail::simulator::GreedySimulator::simulate(
       instance->get_timetable().get_train_list().size(), -1);
   std::vector<std::vector<double>> stop_times(
       instance->get_timetable().get_train_list().size());
-  std::vector<std::map<double, PosVel>>
-      train_trajectories; // time -> {pos, vel}
+  std::conditional_t<SaveTrajectories, FlatTrajectoryRecorder,
+                     NoTrajectoryRecorder>
+      trajectory_recorder;
 
   // Find first time step
   int min_t              = std::numeric_limits<int>::max();
@@ -84,12 +147,22 @@ cda_rail::simulator::GreedySimulator::simulate(
   }
   const int max_t = instance->get_timetable().max_t();
 
-  // Initialize variables to keep track of positions and velocities
-  if (save_trajectories) {
-    train_trajectories.clear();
-    train_trajectories.resize(
-        instance->get_timetable().get_train_list().size());
+  // Every train is recorded at most once per time step between its earliest
+  // entry and its latest exit
+  size_t expected_trajectory_size = 0;
+  for (size_t tr = 0; tr < instance->get_timetable().get_train_list().size();
+       ++tr) {
+    const auto& tr_schedule = instance->get_timetable().get_schedule(tr);
+    expected_trajectory_size += static_cast<size_t>(
+        std::max(tr_schedule.get_t_n_range().second -
+                     tr_schedule.get_t_0_range().first,
+                 0) /
+            dt +
+        2);
   }
+  trajectory_recorder.reserve(expected_trajectory_size);
+
+  // Initialize variables to keep track of positions and velocities
 
   std::vector<std::pair<double, double>> train_positions(
       instance->get_timetable().get_train_list().size(),
@@ -118,13 +191,32 @@ cda_rail::simulator::GreedySimulator::simulate(
                             .braking_times     = std::move(braking_times),
                             .braking_distances = std::move(braking_distances),
                             .vertex_headways   = vertex_headways_double,
-                            .train_trajectories =
-                                save_trajectories
-                                    ? std::move(train_trajectories)
-                                    : std::vector<std::map<double, PosVel>>()};
+                            .train_trajectories = trajectory_recorder.extract(
+                                instance->get_timetable()
+                                    .get_train_list()
+                                    .size())};
   };
 
-  const auto trains_on_edges = tr_on_edges();
+  // Occupancy of the edges by trains in the network, updated whenever a
+  // train's position or velocity changes. Its memory is released at once
+  // after the simulation.
+  std::pmr::monotonic_buffer_resource occupancy_arena(
+      cda_rail::thread_scratch_pool());
+  EdgeOccupancyIndex occupancy(
+      instance->const_n().number_of_edges(),
+      instance->get_timetable().get_train_list().size(), &occupancy_arena);
+  // Routes do not change during the simulation, hence, their milestones and
+  // speed limits are computed only once
+  std::vector<SpeedLimitProfile> profiles;
+  std::vector<double>            train_lengths;
+  profiles.reserve(instance->get_timetable().get_train_list().size());
+  train_lengths.reserve(instance->get_timetable().get_train_list().size());
+  for (size_t tr = 0; tr < instance->get_timetable().get_train_list().size();
+       ++tr) {
+    profiles.push_back(speed_limit_profile(tr));
+    train_lengths.push_back(
+        instance->get_timetable().get_train_list().get_train(tr).length);
+  }
 
   int t = min_t;
 
@@ -139,13 +231,22 @@ cda_rail::simulator::GreedySimulator::simulate(
     }
   }
 
+  // Trains are moved and enter in index order. The iteration order of the hash
+  // sets depends on their history, hence, it would make the result depend on
+  // how trains are numbered beyond their relative order.
+  cda_rail::index_vector train_order;
+  train_order.reserve(instance->get_timetable().get_train_list().size());
+
   while (t < GREEDY_SIMULATOR_MAX_TIME_FACTOR * max_t) {
     PLOGV << "----------------------------";
     PLOGV << "Current time: " << t;
 
-    bool movement_detected = false;
+    bool                   movement_detected = false;
+    cda_rail::index_vector moved_trains;
 
-    for (const auto& tr : trains_in_network) {
+    train_order.assign(trains_in_network.begin(), trains_in_network.end());
+    std::ranges::sort(train_order);
+    for (const auto& tr : train_order) {
       const auto& train_object = instance->get_train_list().get_train(tr);
 
       if (trains_finished_simulating.contains(tr) ||
@@ -154,7 +255,9 @@ cda_rail::simulator::GreedySimulator::simulate(
         continue;
       }
 
-      // Calculate MAs for every train
+      // Calculate MAs for every train. Conflicts are resolved train by train,
+      // i.e., the MA already accounts for trains moved before in this time
+      // step. Otherwise, two trains could claim the same merging edge at once.
       const auto& tr_schedule = instance->get_timetable().get_schedule(tr);
       auto h = std::max({tr_schedule.get_t_n_range().first - t,
                          vertex_headways.at(tr_schedule.get_exit()) - t, 0});
@@ -167,7 +270,7 @@ cda_rail::simulator::GreedySimulator::simulate(
       const auto tr_ma_data =
           get_ma_and_maxv(tr, train_velocities, tr_next_stop_id.at(tr), h, dt,
                           train_positions, trains_in_network, trains_left,
-                          trains_on_edges, limit_speed_by_leaving_edges);
+                          occupancy, profiles.at(tr), LimitSpeedByLeavingEdges);
       PLOGV << train_object.name << " positioned at "
             << train_positions.at(tr).second
             << " has MA: " << train_positions.at(tr).second + tr_ma_data.ma
@@ -177,31 +280,18 @@ cda_rail::simulator::GreedySimulator::simulate(
             << " and max velocity: " << tr_ma_data.max_v
             << " (without route end this would be: "
             << tr_ma_data.max_v_without_route_end << ")";
-      const auto tr_edge_len = train_edge_length(tr);
+      const auto tr_edge_len = profiles.at(tr).route_length();
 
       PLOGV << "h = " << h;
-      auto tr_new_speed =
-          std::min(tr_ma_data.max_v,
-                   get_v1_from_ma(train_velocities.at(tr), tr_ma_data.ma,
-                                  train_object.deceleration, dt));
-      if (tr_new_speed < V_MIN) {
-        tr_new_speed = 0.0; // Train is stopped
-      }
-      auto tr_new_speed_without_route_end =
-          std::min(tr_ma_data.max_v_without_route_end,
-                   get_v1_from_ma(train_velocities.at(tr),
-                                  tr_ma_data.ma_without_route_end,
-                                  train_object.deceleration, dt));
-      if (tr_new_speed_without_route_end < V_MIN) {
-        tr_new_speed_without_route_end = 0.0;
-      }
+      const auto tr_step = train_step(train_velocities.at(tr), tr_ma_data,
+                                      train_object.deceleration, dt);
 
-      PLOGV << "tr_new_speed = " << tr_new_speed
+      PLOGV << "tr_new_speed = " << tr_step.v_1
             << " (without route end this would be: "
-            << tr_new_speed_without_route_end << ")";
+            << tr_step.v_1_without_route_end << ")";
 
       if ((braking_distances.at(tr) < 0) &&
-          (tr_new_speed < tr_new_speed_without_route_end)) {
+          (tr_step.v_1 < tr_step.v_1_without_route_end)) {
         PLOGV << train_object.name
               << " starts braking due to end of route constraint.";
         braking_times.at(tr)     = t - dt;
@@ -209,25 +299,31 @@ cda_rail::simulator::GreedySimulator::simulate(
       }
 
       // Move trains
-      if (move_train(tr, train_velocities.at(tr), tr_new_speed, tr_ma_data.ma,
-                     dt, train_positions)) {
+      train_positions.at(tr).second += tr_step.displacement;
+      if (tr_step.displacement > 0) {
         movement_detected = true;
+        moved_trains.push_back(tr);
       }
-      train_velocities.at(tr) = tr_new_speed;
+      train_velocities.at(tr) = tr_step.v_1;
+      update_occupancy(occupancy, tr, train_positions.at(tr),
+                       train_velocities.at(tr), profiles.at(tr).milestones);
       PLOGV << "At time " << t << ", " << train_object.name << " moved to "
-            << train_positions.at(tr).second << " with speed " << tr_new_speed
+            << train_positions.at(tr).second << " with speed " << tr_step.v_1
             << " and MA "
             << train_positions.at(tr).second +
-                   cda_rail::braking_distance(tr_new_speed,
+                   cda_rail::braking_distance(tr_step.v_1,
                                               train_object.deceleration);
-      if (save_trajectories) {
-        train_trajectories.at(tr)[t] = {.pos = train_positions.at(tr).second,
-                                        .vel = train_velocities.at(tr)};
-      }
+      trajectory_recorder.record(tr, t, train_positions.at(tr).second,
+                                 train_velocities.at(tr));
     }
 
-    // Update rear positions of trains
-    update_rear_positions(train_positions);
+    // Update rear positions of trains, only moved trains change their
+    // occupancy
+    update_rear_positions(train_positions, train_lengths);
+    for (const auto& tr : moved_trains) {
+      update_occupancy(occupancy, tr, train_positions.at(tr),
+                       train_velocities.at(tr), profiles.at(tr).milestones);
+    }
 
     cda_rail::index_vector trains_to_remove;
     for (const auto& tr : trains_in_network) {
@@ -321,19 +417,22 @@ cda_rail::simulator::GreedySimulator::simulate(
     // Remove trains that have left the network
     for (const auto& tr : trains_to_remove) {
       trains_in_network.erase(tr);
+      occupancy.remove(tr);
     }
 
     // Check for new trains entering the network
     const auto [tr_to_enter_success, tr_to_enter] =
         get_entering_trains(t, trains_in_network, trains_left,
-                            trains_finished_simulating, late_entry_possible);
+                            trains_finished_simulating, LateEntryPossible);
     if (!tr_to_enter_success) {
       PLOGV
           << "Simulation failed: Not all trains can enter the network at time "
           << t;
       return build_results(false);
     }
-    for (const auto& tr : tr_to_enter) {
+    train_order.assign(tr_to_enter.begin(), tr_to_enter.end());
+    std::ranges::sort(train_order);
+    for (const auto& tr : train_order) {
       const auto& train_schedule = instance->get_timetable().get_schedule(tr);
       const auto& entry_vertex =
           instance->const_n().get_vertex(train_schedule.get_entry());
@@ -343,8 +442,8 @@ cda_rail::simulator::GreedySimulator::simulate(
               << " cannot enter the network at " << entry_vertex.name
               << " due to vertex headway constraints until time "
               << vertex_headways.at(train_schedule.get_entry());
-      } else if (!is_ok_to_enter(tr, train_positions, train_velocities,
-                                 trains_in_network, trains_on_edges)) {
+      } else if (!is_ok_to_enter(tr, train_positions, trains_in_network,
+                                 occupancy)) {
         PLOGV << "At time " << t << ", "
               << instance->get_train_list().get_train(tr).name
               << " cannot enter the network at " << entry_vertex.name
@@ -357,6 +456,8 @@ cda_rail::simulator::GreedySimulator::simulate(
             -instance->get_train_list().get_train(tr).length,
             0.0}; // Initialize positions
         train_velocities.at(tr) = train_schedule.get_v_0();
+        update_occupancy(occupancy, tr, train_positions.at(tr),
+                         train_velocities.at(tr), profiles.at(tr).milestones);
         if (!stop_positions.at(tr).empty()) {
           tr_next_stop_id.at(tr) = 0;
         }
@@ -366,10 +467,8 @@ cda_rail::simulator::GreedySimulator::simulate(
               << " entered the network at " << entry_vertex.name;
         PLOGV << "New entry blocked until time "
               << vertex_headways.at(train_schedule.get_entry());
-        if (save_trajectories) {
-          train_trajectories.at(tr)[t] = {.pos = train_positions.at(tr).second,
-                                          .vel = train_velocities.at(tr)};
-        }
+        trajectory_recorder.record(tr, t, train_positions.at(tr).second,
+                                   train_velocities.at(tr));
       }
     }
 
@@ -383,8 +482,8 @@ cda_rail::simulator::GreedySimulator::simulate(
     // Check if the end state can still be reached
     if (!is_feasible_to_schedule(
             t, tr_next_stop_id, train_positions, trains_in_network, trains_left,
-            trains_finished_simulating, late_entry_possible, late_exit_possible,
-            late_stop_possible)) {
+            trains_finished_simulating, LateEntryPossible, LateExitPossible,
+            LateStopPossible)) {
       PLOGV
           << "Simulation failed: Simulation cannot become feasible after time "
           << t;
@@ -632,11 +731,93 @@ bool cda_rail::simulator::GreedySimulator::is_on_ttd(
   return potentially_behind; // Train is not on the TTD section
 }
 
+void cda_rail::simulator::GreedySimulator::EdgeOccupancyIndex::insert(
+    size_t edge_id, const Entry& entry) {
+  /**
+   * Inserts a train on an edge keeping the entries sorted by their rear
+   * position on the edge.
+   *
+   * @param edge_id: The id of the edge.
+   * @param entry: The occupation of the train on the edge.
+   */
+
+  auto& edge_entries = entries.at(edge_id);
+  edge_entries.insert(
+      std::ranges::upper_bound(edge_entries, entry.rear_on_edge(), {},
+                               &Entry::rear_on_edge),
+      entry);
+  indexed_edges.at(entry.tr).push_back(edge_id);
+}
+
+void cda_rail::simulator::GreedySimulator::EdgeOccupancyIndex::remove(
+    size_t tr) {
+  /**
+   * Removes a train from all edges it is currently stored on.
+   *
+   * @param tr: The id of the train to remove.
+   */
+
+  auto& tr_indexed_edges = indexed_edges.at(tr);
+  for (const auto& edge_id : tr_indexed_edges) {
+    std::erase_if(entries.at(edge_id),
+                  [tr](const Entry& entry) { return entry.tr == tr; });
+  }
+  tr_indexed_edges.clear();
+}
+
+void cda_rail::simulator::GreedySimulator::update_occupancy(
+    EdgeOccupancyIndex& occupancy, size_t tr,
+    const std::pair<double, double>& pos, double v,
+    const std::vector<double>& milestones) const {
+  /**
+   * Replaces the occupation of a train in the occupancy index by the one
+   * induced by its current position and velocity.
+   *
+   * @param occupancy: The occupancy index to update.
+   * @param tr: The id of the train.
+   * @param pos: The rear and front position of the train on its route.
+   * @param v: The current velocity of the train.
+   * @param milestones: The milestones of the train's route.
+   */
+
+  occupancy.remove(tr);
+  const double reach = pos.second + tr_braking_distance(tr, v);
+  const auto&  edges = train_edges.at(tr);
+  for (size_t i = 0; i < edges.size() && milestones.at(i) + EPS < reach; ++i) {
+    if (pos.first >= milestones.at(i + 1) - EPS) {
+      continue; // The train has left the edge already
+    }
+    occupancy.insert(edges.at(i), {.tr    = tr,
+                                   .start = milestones.at(i),
+                                   .end   = milestones.at(i + 1),
+                                   .rear  = pos.first,
+                                   .front = pos.second,
+                                   .reach = reach});
+  }
+}
+
+cda_rail::simulator::GreedySimulator::EdgeOccupancyIndex
+cda_rail::simulator::GreedySimulator::build_occupancy_index(
+    const std::vector<std::pair<double, double>>& train_positions,
+    const std::vector<double>&                    train_velocities,
+    const std::unordered_set<size_t>&             trains_in_network) const {
+  /**
+   * Builds the occupancy index of all trains in the network from scratch.
+   */
+
+  EdgeOccupancyIndex occupancy(instance->const_n().number_of_edges(),
+                               instance->get_train_list().size());
+  for (const auto& tr : trains_in_network) {
+    update_occupancy(occupancy, tr, train_positions.at(tr),
+                     train_velocities.at(tr), edge_milestones(tr));
+  }
+  return occupancy;
+}
+
 bool cda_rail::simulator::GreedySimulator::is_ok_to_enter(
     size_t tr, const std::vector<std::pair<double, double>>& train_positions,
-    const std::vector<double>&                     train_velocities,
-    const std::unordered_set<size_t>&              trains_in_network,
-    const std::vector<std::unordered_set<size_t>>& tr_on_edges) const {
+    const std::unordered_set<size_t>& trains_in_network,
+    const EdgeOccupancyIndex&         occupancy) const {
   /**
    * This function checks if it is ok for a train to enter the network, i.e., if
    * all of its initial braking distance is cleared.
@@ -646,6 +827,7 @@ bool cda_rail::simulator::GreedySimulator::is_ok_to_enter(
    * positions of each train in the network.
    * @param trains_in_network: A set of train ids that are currently in the
    * network.
+   * @param occupancy: The occupancy index of all trains in the network.
    */
 
   const auto v0         = instance->get_timetable().get_schedule(tr).get_v_0();
@@ -653,49 +835,34 @@ bool cda_rail::simulator::GreedySimulator::is_ok_to_enter(
   const auto milestones = edge_milestones(tr);
   for (size_t i = 0; i < train_edges.at(tr).size() && milestones[i] + EPS < bd;
        ++i) {
-    const auto& edge_id          = train_edges.at(tr).at(i);
-    const auto& potential_trains = tr_on_edges.at(edge_id);
-    for (const auto& other_tr : potential_trains) {
-      if (other_tr == tr || !trains_in_network.contains(other_tr)) {
-        continue; // Skip the train itself or trains that are not in the network
+    const auto& edge_id = train_edges.at(tr).at(i);
+    // Entries are sorted by their rear, hence, only the first train occupying
+    // the edge has to be checked
+    for (const auto& entry : occupancy.on_edge(edge_id)) {
+      if (entry.tr == tr || !entry.is_occupied()) {
+        continue; // Skip the train itself or trains only braking into the edge
       }
-      const auto& other_pos = train_positions.at(other_tr);
-      [[maybe_unused]] const auto [occ, det_occ, det_pos] =
-          get_position_on_edge(other_tr, other_pos, edge_id);
-      if (occ && det_pos.first <= bd - milestones[i] + EPS) {
+      if (entry.rear_on_edge() <= bd - milestones[i] + EPS) {
         return false; // Other train is occupying the edge within the braking
                       // distance
       }
+      break;
     }
 
     // Potentially train on reverse edge
     const auto reverse_edge_id =
         instance->const_n().get_reverse_edge_index(edge_id);
-    if (reverse_edge_id.has_value()) {
-      const auto& potential_trains_reverse =
-          tr_on_edges.at(reverse_edge_id.value());
-      for (const auto& other_tr : potential_trains_reverse) {
-        if (other_tr == tr || !trains_in_network.contains(other_tr)) {
-          continue; // Skip the train itself or trains that are not in the
-                    // network
-        }
-        // NOLINTBEGIN(bugprone-unchecked-optional-access)
-        // false positive
-        [[maybe_unused]] const auto [occ_rev, det_occ_rev, det_pos_rev] =
-            get_position_on_edge(
-                other_tr,
-                {train_positions.at(other_tr).first,
-                 train_positions.at(other_tr).second +
-                     tr_braking_distance(other_tr,
-                                         train_velocities.at(other_tr))},
-                reverse_edge_id.value());
-        // NOLINTEND(bugprone-unchecked-optional-access)
-        if (occ_rev) {
-          return false; // Other train is occupying the reverse edge within the
-                        // braking distance
-        }
-      }
+    // NOLINTBEGIN(bugprone-unchecked-optional-access)
+    // false positive
+    if (reverse_edge_id.has_value() &&
+        std::ranges::any_of(occupancy.on_edge(reverse_edge_id.value()),
+                            [tr](const EdgeOccupancyIndex::Entry& entry) {
+                              return entry.tr != tr;
+                            })) {
+      return false; // Other train is occupying the reverse edge within the
+                    // braking distance
     }
+    // NOLINTEND(bugprone-unchecked-optional-access)
 
     const auto ttd_sec = get_ttd(edge_id);
     if (ttd_sec.has_value()) {
@@ -733,11 +900,10 @@ double cda_rail::simulator::GreedySimulator::max_displacement(
 
 double cda_rail::simulator::GreedySimulator::get_absolute_distance_ma(
     size_t tr, double max_displacement,
-    const std::vector<std::pair<double, double>>&  train_positions,
-    const std::vector<double>&                     train_velocities,
-    const std::unordered_set<size_t>&              trains_in_network,
-    const std::unordered_set<size_t>&              trains_left,
-    const std::vector<std::unordered_set<size_t>>& tr_on_edges) const {
+    const std::vector<std::pair<double, double>>& train_positions,
+    const std::unordered_set<size_t>&             trains_in_network,
+    const std::unordered_set<size_t>&             trains_left,
+    const EdgeOccupancyIndex&                     occupancy) const {
   /**
    * Calculate the shortest distance of tr to the following train.
    *
@@ -746,13 +912,11 @@ double cda_rail::simulator::GreedySimulator::get_absolute_distance_ma(
    * after this distance).
    * @param train_positions: A vector of pairs containing the rear and front
    * positions of each train in the network.
-   * @param train_velocities: A vector containing the velocities of each train.
-   * This is needed to check for collisions with trains traveling in the
-   * opposite direction.
    * @param trains_in_network: A set of train ids that are currently in the
    * network.
-   * @param tr_on_edges: A vector of unordered sets, where each set contains the
-   * indices of trains that are routed on a specific edge.
+   * @param occupancy: The occupancy index of all trains in the network. Its
+   * braking distances are needed to check for collisions with trains traveling
+   * in the opposite direction.
    *
    * @return: The absolute distance of the train to the next train in the
    * network.
@@ -810,61 +974,42 @@ double cda_rail::simulator::GreedySimulator::get_absolute_distance_ma(
 
       const auto reverse_edge_id =
           instance->const_n().get_reverse_edge_index(edge_id);
-      if (reverse_edge_id.has_value()) {
-        const auto& potential_trains_reverse =
-            tr_on_edges.at(reverse_edge_id.value());
-        for (const auto& other_tr : potential_trains_reverse) {
-          if (other_tr == tr || !trains_in_network.contains(other_tr)) {
-            continue; // Skip the train itself or trains that are not in the
-                      // network
-          }
-          [[maybe_unused]] const auto [occ_rev, det_occ_rev, det_pos_rev] =
-              get_position_on_edge(
-                  other_tr,
-                  {train_positions.at(other_tr).first,
-                   train_positions.at(other_tr).second +
-                       tr_braking_distance(other_tr,
-                                           train_velocities.at(other_tr))},
-                  reverse_edge_id.value());
-          if (occ_rev) {
-            // Other train has already been cleared to enter the reverse edge
-            return milestones.at(i) - train_positions.at(tr).second;
-          }
-        }
+      if (reverse_edge_id.has_value() &&
+          std::ranges::any_of(occupancy.on_edge(reverse_edge_id.value()),
+                              [tr](const EdgeOccupancyIndex::Entry& entry) {
+                                return entry.tr != tr;
+                              })) {
+        // Other train has already been cleared to enter the reverse edge
+        return milestones.at(i) - train_positions.at(tr).second;
       }
     }
 
-    // Absolute distance to trains on edge
-    double      potential_limit   = milestones.at(i + 1) - milestones.at(i);
-    bool        found_other_train = false;
-    const auto& potential_trains  = tr_on_edges.at(edge_id);
-    for (const auto& other_tr : potential_trains) {
-      if (other_tr == tr || !trains_in_network.contains(other_tr)) {
-        continue; // Skip the train itself or trains that are not in the network
+    // Absolute distance to trains on edge. Entries are sorted by their rear,
+    // hence, the first train ahead is the nearest obstacle.
+    const double potential_limit = milestones.at(i + 1) - milestones.at(i);
+
+    std::optional<double> tr_rear_on_edge;
+    if (first_edge) {
+      [[maybe_unused]] const auto [occ_tr, det_occ_tr, det_pos_tr] =
+          get_position_on_route_edge(tr, train_positions.at(tr), i,
+                                     milestones);
+      if (occ_tr) {
+        tr_rear_on_edge = det_pos_tr.first;
       }
-      const auto& other_pos = train_positions.at(other_tr);
-      [[maybe_unused]] const auto [occ, det_occ, det_pos] =
-          get_position_on_edge(other_tr, other_pos, edge_id);
-      bool check_other_tr = occ;
-      if (check_other_tr && first_edge) {
-        // Other train could be behind train on the same edge
-        [[maybe_unused]] const auto [occ_tr, det_occ_tr, det_pos_tr] =
-            get_position_on_route_edge(tr, train_positions.at(tr), i,
-                                       milestones);
-        if (occ_tr && det_pos_tr.first >= det_pos.second) {
-          check_other_tr = false; // Train is not behind the other train
-        }
+    }
+    for (const auto& entry : occupancy.on_edge(edge_id)) {
+      if (entry.tr == tr || !entry.is_occupied()) {
+        continue; // Skip the train itself or trains only braking into the edge
       }
-      if (check_other_tr) {
-        found_other_train = true;
-        potential_limit   = std::min(potential_limit, det_pos.first);
+      if (tr_rear_on_edge.has_value() &&
+          tr_rear_on_edge.value() >= entry.front_on_edge()) {
+        continue; // Other train is behind the train on the same edge
       }
-    }
-    if (found_other_train) {
-      return std::min(
-          max_displacement,
-          milestones.at(i) + potential_limit -
-              train_positions.at(tr).second); // Found a train on the edge
+      // Found a train on the edge
+      return std::min(max_displacement,
+                      milestones.at(i) +
+                          std::min(potential_limit, entry.rear_on_edge()) -
+                          train_positions.at(tr).second);
     }
     first_edge = false; // After the first edge, we do not need to check if
                         // other train might be behind
@@ -873,10 +1018,76 @@ double cda_rail::simulator::GreedySimulator::get_absolute_distance_ma(
                            // range
 }
 
+cda_rail::simulator::GreedySimulator::SpeedLimitProfile::SpeedLimitProfile(
+    std::vector<double> milestones, std::vector<double> speed_limits)
+    : milestones(std::move(milestones)), speed_limits(std::move(speed_limits)) {
+  /**
+   * Builds the sparse table of the speed limits. Level k contains the minimum
+   * of the speed limits of the 2^k consecutive edges starting at every edge.
+   */
+
+  if (!this->speed_limits.empty() &&
+      this->milestones.size() != this->speed_limits.size() + 1) {
+    throw cda_rail::exceptions::InvalidInputException(
+        "Number of milestones does not match number of speed limits.");
+  }
+
+  sparse_table.push_back(this->speed_limits);
+  for (size_t width = 1; 2 * width <= this->speed_limits.size(); width *= 2) {
+    const auto&         prev_level = sparse_table.back();
+    std::vector<double> level(prev_level.size() - width);
+    for (size_t j = 0; j < level.size(); ++j) {
+      level[j] = std::min(prev_level[j], prev_level[j + width]);
+    }
+    sparse_table.push_back(std::move(level));
+  }
+}
+
+size_t cda_rail::simulator::GreedySimulator::SpeedLimitProfile::
+    first_edge_ending_after(double pos) const {
+  const auto it = std::ranges::upper_bound(milestones, pos);
+  const auto j  = static_cast<size_t>(std::distance(milestones.begin(), it));
+  return j == 0 ? 0 : j - 1;
+}
+
+double cda_rail::simulator::GreedySimulator::SpeedLimitProfile::min_speed_limit(
+    size_t first, size_t last) const {
+  if (first >= last || last > speed_limits.size()) {
+    throw cda_rail::exceptions::InvalidInputException(
+        "Invalid edge range [" + std::to_string(first) + ", " +
+        std::to_string(last) + ").");
+  }
+  const auto level = static_cast<size_t>(std::bit_width(last - first) - 1);
+  const auto width = static_cast<size_t>(1) << level;
+  return std::min(sparse_table[level][first],
+                  sparse_table[level][last - width]);
+}
+
+cda_rail::simulator::GreedySimulator::SpeedLimitProfile
+cda_rail::simulator::GreedySimulator::speed_limit_profile(size_t tr) const {
+  /**
+   * Speed limit profile of the current route of a train.
+   *
+   * @param tr: The id of the train.
+   */
+
+  if (!instance->get_timetable().get_train_list().has_train(tr)) {
+    throw cda_rail::exceptions::TrainNotExistentException(tr);
+  }
+  const auto&         edges = train_edges.at(tr);
+  std::vector<double> speed_limits;
+  speed_limits.reserve(edges.size());
+  for (const auto& edge_id : edges) {
+    speed_limits.push_back(instance->const_n().get_edge(edge_id).max_speed);
+  }
+  return {edge_milestones(tr), std::move(speed_limits)};
+}
+
 cda_rail::simulator::GreedySimulator::MaAndMaxVResult
 cda_rail::simulator::GreedySimulator::get_future_max_speed_constraints(
     size_t tr, const cda_rail::Train& train, double pos, double v_0,
-    double max_displacement, int dt, bool also_limit_by_leaving_edges) const {
+    double max_displacement, int dt, bool also_limit_by_leaving_edges,
+    const SpeedLimitProfile& profile) const {
   /**
    * This function calculates the future maximum speed constraints for a train.
    * If an edge is reachable, the trains speed is restricted directly.
@@ -894,6 +1105,7 @@ cda_rail::simulator::GreedySimulator::get_future_max_speed_constraints(
    * @param dt: The time step in seconds.
    * @param also_limit_by_leaving_edges: If true, the speed is limited by the
    * edges the train is leaving, otherwise only by the front of the train.
+   * @param profile: The speed limit profile of the train's route.
    *
    * @return: A pair of doubles representing the:
    * - maximum moving authority from the trains current position and
@@ -913,28 +1125,46 @@ cda_rail::simulator::GreedySimulator::get_future_max_speed_constraints(
   double max_v = std::min(train.max_speed, v_0 + (train.acceleration * dt));
   double ma    = max_displacement;
 
-  const auto milestones = edge_milestones(tr);
-  for (size_t i = 0; i < train_edges.at(tr).size() &&
-                     milestones.at(i) + EPS < pos + max_displacement;
-       ++i) {
-    if (milestones.at(i + 1) <= pos - train.length) {
-      continue; // Train has fully left the edge already
+  const auto& milestones = profile.milestones;
+  const auto  num_edges  = profile.number_of_edges();
+
+  // Edges the train has fully left already are skipped
+  size_t i = profile.first_edge_ending_after(pos - train.length);
+  if (also_limit_by_leaving_edges) {
+    // Edges starting before the train's front restrict its speed directly.
+    // Only edges with speed limit zero additionally restrict the moving
+    // authority, in which case they are handled individually below.
+    const auto behind_end = static_cast<size_t>(std::distance(
+        milestones.begin(),
+        std::partition_point(milestones.begin(), milestones.begin() + num_edges,
+                             [pos, max_displacement](double milestone) {
+                               return milestone <= pos &&
+                                      milestone + EPS < pos + max_displacement;
+                             })));
+    if (i < behind_end) {
+      const double min_v_behind = profile.min_speed_limit(i, behind_end);
+      if (min_v_behind > 0) {
+        max_v = std::min(max_v, min_v_behind);
+        i     = behind_end;
+      }
     }
+  }
+
+  for (; i < num_edges && milestones.at(i) + EPS < pos + max_displacement;
+       ++i) {
     if (!also_limit_by_leaving_edges && milestones.at(i + 1) <= pos) {
       continue; // Train's front has already left the edge
     }
 
-    const auto& edge_id = train_edges.at(tr).at(i);
-    const auto& edge    = instance->const_n().get_edge(edge_id);
-    [[maybe_unused]] const auto [occ, det_occ, det_pos] =
-        get_position_on_route_edge(tr, {pos - train.length, pos}, i,
-                                   milestones);
-    if (det_occ.second || (!also_limit_by_leaving_edges && occ)) {
-      max_v = std::min(max_v, edge.max_speed); // Train is on the edge
+    const double v_m = profile.speed_limits.at(i);
+    const bool   occ = pos > milestones.at(i) + EPS &&
+                     pos - train.length < milestones.at(i + 1) - EPS;
+    if ((occ && pos <= milestones.at(i + 1)) ||
+        (!also_limit_by_leaving_edges && occ)) {
+      max_v = std::min(max_v, v_m); // Train is on the edge
     } else {
-      std::tie(ma, max_v) =
-          speed_restriction_helper(ma, max_v, pos, milestones.at(i), v_0,
-                                   edge.max_speed, train.deceleration, dt);
+      std::tie(ma, max_v) = speed_restriction_helper(
+          ma, max_v, pos, milestones.at(i), v_0, v_m, train.deceleration, dt);
     }
   }
 
@@ -1007,7 +1237,7 @@ double cda_rail::simulator::GreedySimulator::get_next_stop_ma(
 
 double cda_rail::simulator::GreedySimulator::get_max_speed_exit_headway(
     size_t tr, const cda_rail::Train& train, double pos, double v_0, int h,
-    int dt) const {
+    int dt, const SpeedLimitProfile& profile) const {
   /**
    * This function limits the maximum speed so that the exit headway can still
    * be maintained using the exit velocity.
@@ -1018,6 +1248,7 @@ double cda_rail::simulator::GreedySimulator::get_max_speed_exit_headway(
    * @param v_0: The initial velocity of the train in m/s.
    * @param h: The (remaining) exit headway in seconds.
    * @param dt: The time step in seconds.
+   * @param profile: The speed limit profile of the train's route.
    *
    * @return: The maximum speed allowed for the next speed step.
    */
@@ -1040,7 +1271,7 @@ double cda_rail::simulator::GreedySimulator::get_max_speed_exit_headway(
     return v_ub; // No exit headway to consider
   }
 
-  const auto route_len     = train_edge_length(tr);
+  const auto route_len     = profile.route_length();
   const auto exit_distance = std::max(
       0.0,
       route_len + (tr_schedule.get_v_n() < V_MIN ? 0 : train.length) - pos);
@@ -1170,10 +1401,11 @@ cda_rail::simulator::GreedySimulator::MaAndMaxVResult
 cda_rail::simulator::GreedySimulator::get_ma_and_maxv(
     size_t tr, const std::vector<double>& train_velocities,
     std::optional<size_t> next_stop, int h, int dt,
-    const std::vector<std::pair<double, double>>&  train_positions,
-    const std::unordered_set<size_t>&              trains_in_network,
-    const std::unordered_set<size_t>&              trains_left,
-    const std::vector<std::unordered_set<size_t>>& tr_on_edges,
+    const std::vector<std::pair<double, double>>& train_positions,
+    const std::unordered_set<size_t>&             trains_in_network,
+    const std::unordered_set<size_t>&             trains_left,
+    const EdgeOccupancyIndex&                     occupancy,
+    const SpeedLimitProfile&                      profile,
     bool also_limit_speed_by_leaving_edges) const {
   const auto& train = instance->get_timetable().get_train_list().get_train(tr);
   double      ma    = max_displacement(train, train_velocities.at(tr), dt);
@@ -1184,14 +1416,15 @@ cda_rail::simulator::GreedySimulator::get_ma_and_maxv(
   ma = get_exit_vertex_order_ma(tr, train, train_positions.at(tr).second, ma,
                                 trains_in_network, trains_left);
   double max_v = NAN;
-  ma = get_absolute_distance_ma(tr, ma, train_positions, train_velocities,
-                                trains_in_network, trains_left, tr_on_edges);
+  ma = get_absolute_distance_ma(tr, ma, train_positions, trains_in_network,
+                                trains_left, occupancy);
   const auto tmp_ma_data = get_future_max_speed_constraints(
       tr, train, train_positions.at(tr).second, train_velocities.at(tr), ma, dt,
-      also_limit_speed_by_leaving_edges);
+      also_limit_speed_by_leaving_edges, profile);
   ma                            = tmp_ma_data.ma;
-  const double max_speed_exit_h = get_max_speed_exit_headway(
-      tr, train, train_positions.at(tr).second, train_velocities.at(tr), h, dt);
+  const double max_speed_exit_h =
+      get_max_speed_exit_headway(tr, train, train_positions.at(tr).second,
+                                 train_velocities.at(tr), h, dt, profile);
   max_v = std::min(tmp_ma_data.max_v, max_speed_exit_h);
   const double max_v_without_route_end =
       std::min(tmp_ma_data.max_v_without_route_end, max_speed_exit_h);
@@ -1248,6 +1481,63 @@ double cda_rail::simulator::GreedySimulator::get_v1_from_ma(double v_0,
   return 2.0 * b / (a + std::sqrt((a * a) + (4.0 * b)));
 }
 
+double cda_rail::simulator::GreedySimulator::move_distance(double v_0,
+                                                           double v_1,
+                                                           double ma, int dt) {
+  /**
+   * Distance moved by the train's front within one time step assuming linear
+   * movement. Distances below EPS are returned as zero.
+   *
+   * @param v_0: The initial velocity of the train in m/s.
+   * @param v_1: The velocity of the train at the end of the time step in m/s.
+   * @param ma: The moving authority in m.
+   * @param dt: The time step in seconds.
+   *
+   * @return: The distance moved in m.
+   */
+
+  double distance =
+      std::min(ma, (v_0 + v_1) * dt / 2.0); // Distance moved in the time step
+  if (std::abs(distance) < EPS) {
+    return 0.0;
+  }
+  if (v_1 < V_MIN && std::abs(ma - distance) < STOP_TOLERANCE) {
+    distance = ma;
+  }
+  return distance;
+}
+
+cda_rail::simulator::GreedySimulator::TrainStep
+cda_rail::simulator::GreedySimulator::train_step(
+    double v_0, const MaAndMaxVResult& ma_data, double d, int dt) {
+  /**
+   * Kinematics of a train within one time step once its moving authority and
+   * maximal speed are known. It only depends on the train itself, hence, it
+   * is separated from the resolution of conflicts with other trains.
+   *
+   * @param v_0: The initial velocity of the train in m/s.
+   * @param ma_data: The moving authority and maximal speed of the train.
+   * @param d: The deceleration of the train in m/s^2.
+   * @param dt: The time step in seconds.
+   *
+   * @return: The speeds at the end of the time step and the displacement.
+   */
+
+  double v_1 = std::min(ma_data.max_v, get_v1_from_ma(v_0, ma_data.ma, d, dt));
+  if (v_1 < V_MIN) {
+    v_1 = 0.0; // Train is stopped
+  }
+  double v_1_without_route_end =
+      std::min(ma_data.max_v_without_route_end,
+               get_v1_from_ma(v_0, ma_data.ma_without_route_end, d, dt));
+  if (v_1_without_route_end < V_MIN) {
+    v_1_without_route_end = 0.0;
+  }
+  return {.v_1                   = v_1,
+          .v_1_without_route_end = v_1_without_route_end,
+          .displacement          = move_distance(v_0, v_1, ma_data.ma, dt)};
+}
+
 bool cda_rail::simulator::GreedySimulator::move_train(
     size_t tr, double v_0, double v_1, double ma, int dt,
     std::vector<std::pair<double, double>>& train_positions) {
@@ -1270,16 +1560,31 @@ bool cda_rail::simulator::GreedySimulator::move_train(
     throw cda_rail::exceptions::TrainNotExistentException(tr);
   }
 
-  double move_distance =
-      std::min(ma, (v_0 + v_1) * dt / 2.0); // Distance moved in the time step
-  if (std::abs(move_distance) < EPS) {
-    return false;
+  const double distance = move_distance(v_0, v_1, ma, dt);
+  train_positions.at(tr).second += distance; // Update the front position
+  return distance > 0;
+}
+
+void cda_rail::simulator::GreedySimulator::update_rear_positions(
+    std::vector<std::pair<double, double>>& train_positions,
+    const std::vector<double>&              train_lengths) {
+  /**
+   * Update the rear positions of all trains based on their front positions and
+   * the given train lengths. The loop does not depend on the instance and can
+   * be vectorized.
+   *
+   * @param train_positions: A vector of pairs containing the rear and front
+   * @param train_lengths: The length of every train
+   */
+
+  if (train_positions.size() != train_lengths.size()) {
+    throw cda_rail::exceptions::InvalidInputException(
+        "Train positions size does not match the number of train lengths.");
   }
-  if (v_1 < V_MIN && std::abs(ma - move_distance) < STOP_TOLERANCE) {
-    move_distance = ma;
+
+  for (size_t tr = 0; tr < train_positions.size(); ++tr) {
+    train_positions[tr].first = train_positions[tr].second - train_lengths[tr];
   }
-  train_positions.at(tr).second += move_distance; // Update the front position
-  return move_distance > 0;
 }
 
 void cda_rail::simulator::GreedySimulator::update_rear_positions(
@@ -1298,12 +1603,12 @@ void cda_rail::simulator::GreedySimulator::update_rear_positions(
         "Train positions size does not match the number of trains.");
   }
 
-  for (size_t tr = 0; tr < train_positions.size(); ++tr) {
-    const auto& train =
-        instance->get_timetable().get_train_list().get_train(tr);
-    train_positions.at(tr).first =
-        train_positions.at(tr).second - train.length; // Update rear position
+  std::vector<double> train_lengths;
+  train_lengths.reserve(train_positions.size());
+  for (const auto& train : instance->get_timetable().get_train_list()) {
+    train_lengths.push_back(train.length);
   }
+  update_rear_positions(train_positions, train_lengths);
 }
 
 bool cda_rail::simulator::GreedySimulator::is_feasible_to_schedule(
@@ -2,22 +2,37 @@
 
 #include "Definitions.hpp"
 #include "EOMHelper.hpp"
+#include "MemoryResource.hpp"
 #include "plog/Log.h"
 #include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
 #include "simulator/GreedyHeuristic.hpp"
 #include "simulator/GreedySimulator.hpp"
 #include "solver/GeneralSolver.hpp"
+#include "solver/SharedIncumbent.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
-std::unordered_set<cda_rail::solver::astar_based::GreedySimulatorState>
+std::pmr::unordered_set<cda_rail::solver::astar_based::GreedySimulatorState>
 cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
     next_states_single_edge(
-        const cda_rail::simulator::GreedySimulator& simulator) {
+        const cda_rail::simulator::GreedySimulator& simulator,
+        std::pmr::memory_resource*                  resource,
+        const std::vector<StateAction>&             sleep_set) {
   /**
    * This function determines all possible next states. This state could be
    * obtained by:
@@ -25,9 +40,10 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
    * - any single train advancing to a next edge
    * - any single train stopping at the current edge (if it is a valid next stop
    * edge)
+   * Actions contained in sleep_set are skipped.
    */
 
-  std::unordered_set<GreedySimulatorState> next_states;
+  std::pmr::unordered_set<GreedySimulatorState> next_states(resource);
 
   for (size_t tr = 0;
        tr < simulator.get_instance()->get_timetable().get_train_list().size();
@@ -48,6 +64,9 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
                                              tr_obj.deceleration),
                   tr_schedule.get_exit(), {}, true);
       for (const auto& path : entry_paths) {
+        if (is_asleep(sleep_set, tr, path, {})) {
+          continue;
+        }
         GreedySimulatorState new_state{
             .train_edges    = simulator.get_train_edges(),
             .ttd_orders     = simulator.get_ttd_orders(),
@@ -60,7 +79,8 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
         next_states.insert(new_state);
       }
     } else {
-      if (simulator.is_current_pos_valid_stop_position(tr)) {
+      if (simulator.is_current_pos_valid_stop_position(tr) &&
+          !is_asleep(sleep_set, tr, {}, {simulator.train_edge_length(tr)})) {
         // Train can stop at the current edge
         GreedySimulatorState new_state{
             .train_edges    = simulator.get_train_edges(),
@@ -76,6 +96,9 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
           simulator.get_instance()->const_n().get_successors(
               simulator.get_train_edges_of_tr(tr).back());
       for (const auto& next_edge : next_edges) {
+        if (is_asleep(sleep_set, tr, {next_edge}, {})) {
+          continue;
+        }
         GreedySimulatorState new_state{
             .train_edges    = simulator.get_train_edges(),
             .ttd_orders     = simulator.get_ttd_orders(),
@@ -92,18 +115,21 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
   return next_states;
 }
 
-std::unordered_set<cda_rail::solver::astar_based::GreedySimulatorState>
+std::pmr::unordered_set<cda_rail::solver::astar_based::GreedySimulatorState>
 cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
     next_states_next_ttd(
-        const cda_rail::simulator::GreedySimulator& simulator) {
+        const cda_rail::simulator::GreedySimulator& simulator,
+        std::pmr::memory_resource*                  resource,
+        const std::vector<StateAction>&             sleep_set) {
   /** This function determines all possible next states. This state could be
    * obtained by:
    * - a new train entering the network
    * - a single train advancing on a path to the next TTD section
    * - a single train advancing to a edge of its next stop and halting
+   * Actions contained in sleep_set are skipped.
    */
 
-  std::unordered_set<GreedySimulatorState> next_states;
+  std::pmr::unordered_set<GreedySimulatorState> next_states(resource);
   for (size_t tr = 0;
        tr < simulator.get_instance()->get_timetable().get_train_list().size();
        ++tr) {
@@ -132,13 +158,18 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
         new_state.vertex_orders.at(tr_schedule.get_entry()).emplace_back(tr);
         next_state_ttd_helper(tr, new_state, simulator, path);
         next_state_exit_vertex_helper(tr, new_state, simulator);
-        next_states.insert(new_state);
+        if (!is_asleep(sleep_set, tr, path, {})) {
+          next_states.insert(new_state);
+        }
 
         if (simulator.is_route_end_valid_stop_pos(tr, path)) {
           // Train can stop at the current edge
-          new_state.stop_positions.at(tr).emplace_back(
-              simulator.get_instance()->const_n().length_of_path(path));
-          next_states.insert(new_state);
+          const auto stop_pos =
+              simulator.get_instance()->const_n().length_of_path(path);
+          if (!is_asleep(sleep_set, tr, path, {stop_pos})) {
+            new_state.stop_positions.at(tr).emplace_back(stop_pos);
+            next_states.insert(new_state);
+          }
         }
       }
     } else {
@@ -156,22 +187,29 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
         for (size_t e_idx = 0; e_idx < path.size(); ++e_idx) {
           const auto& e = path.at(e_idx);
           new_state.train_edges.at(tr).emplace_back(e);
-          if (simulator.is_route_end_valid_stop_pos(
+          if (!simulator.is_route_end_valid_stop_pos(
                   tr, new_state.train_edges.at(tr))) {
-            GreedySimulatorState new_state_stop = new_state;
-            new_state_stop.stop_positions.at(tr).emplace_back(
-                simulator.get_instance()->const_n().length_of_path(
-                    new_state_stop.train_edges.at(tr)));
-            next_state_ttd_helper(
-                tr, new_state_stop, simulator,
-                cda_rail::index_vector(
-                    path.begin(),
-                    path.begin() +
-                        static_cast<cda_rail::index_vector::difference_type>(
-                            e_idx + 1)));
-            next_state_exit_vertex_helper(tr, new_state_stop, simulator);
-            next_states.insert(new_state_stop);
+            continue;
+          }
+          const cda_rail::index_vector path_prefix(
+              path.begin(),
+              path.begin() +
+                  static_cast<cda_rail::index_vector::difference_type>(e_idx +
+                                                                       1));
+          const auto stop_pos =
+              simulator.get_instance()->const_n().length_of_path(
+                  new_state.train_edges.at(tr));
+          if (is_asleep(sleep_set, tr, path_prefix, {stop_pos})) {
+            continue;
           }
+          GreedySimulatorState new_state_stop = new_state;
+          new_state_stop.stop_positions.at(tr).emplace_back(stop_pos);
+          next_state_ttd_helper(tr, new_state_stop, simulator, path_prefix);
+          next_state_exit_vertex_helper(tr, new_state_stop, simulator);
+          next_states.insert(new_state_stop);
+        }
+        if (is_asleep(sleep_set, tr, path, {})) {
+          continue;
         }
         next_state_ttd_helper(tr, new_state, simulator, path);
         next_state_exit_vertex_helper(tr, new_state, simulator);
@@ -182,6 +220,17 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
   return next_states;
 }
 
+bool cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::is_asleep(
+    const std::vector<StateAction>& sleep_set, size_t tr,
+    const cda_rail::index_vector& new_edges,
+    const std::vector<double>&    new_stop_positions) {
+  // The successor of an action is determined by the extension of its train
+  return std::ranges::any_of(sleep_set, [&](const StateAction& action) {
+    return action.train == tr && action.new_edges == new_edges &&
+           action.new_stop_positions == new_stop_positions;
+  });
+}
+
 void cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
     next_state_ttd_helper(
         size_t tr, cda_rail::solver::astar_based::GreedySimulatorState& state,
@@ -224,6 +273,390 @@ void cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
   }
 }
 
+void cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
+    publish_incumbent(double obj, const GreedySimulatorState& state) const {
+  /**
+   * Shares a feasible final state with concurrently running solvers. Routes
+   * are referenced by vertex names.
+   */
+
+  if (shared_incumbent == nullptr) {
+    return;
+  }
+
+  std::vector<SharedIncumbent::NamedRoute> routes;
+  routes.reserve(state.train_edges.size());
+  for (const auto& tr_edges : state.train_edges) {
+    auto& route = routes.emplace_back();
+    route.reserve(tr_edges.size());
+    for (const auto& e : tr_edges) {
+      const auto& edge = instance.const_n().get_edge(e);
+      route.emplace_back(instance.const_n().get_vertex(edge.source).name,
+                         instance.const_n().get_vertex(edge.target).name);
+    }
+  }
+  shared_incumbent->update_upper_bound(obj, std::move(routes));
+}
+
+void cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
+    publish_optimality_proof(double lower_bound) const {
+  /**
+   * Every open state is bounded by the shared incumbent, which is therefore
+   * optimal. The bound is shared and all concurrent solvers are stopped.
+   */
+
+  if (shared_incumbent == nullptr) {
+    return;
+  }
+
+  PLOGD << "Shared incumbent is proven optimal with lower bound "
+        << lower_bound;
+  shared_incumbent->update_lower_bound(lower_bound);
+  shared_incumbent->request_stop();
+}
+
+cda_rail::solver::astar_based::GreedySimulatorState
+cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::canonical_state(
+    const GreedySimulatorState& state) const {
+  /**
+   * Renumbers interchangeable trains, such that within every group the trains
+   * without a route come first. The simulator moves trains in index order and
+   * every train already sees the moves of the trains before it. Hence, a
+   * renumbered state is simulated exactly like the original one only if all
+   * routed trains keep their relative order. Otherwise, the state is returned
+   * unchanged. States that only differ by such a renumbering have the same
+   * canonical state.
+   */
+
+  std::vector<size_t> new_to_old(state.train_edges.size());
+  std::iota(new_to_old.begin(), new_to_old.end(), 0);
+  bool permuted = false;
+
+  for (const auto& group : symmetric_train_groups) {
+    auto sorted_group = group;
+    std::ranges::stable_partition(sorted_group, [&state](size_t tr) {
+      return state.train_edges.at(tr).empty();
+    });
+    for (size_t i = 0; i < group.size(); ++i) {
+      if (group.at(i) != sorted_group.at(i)) {
+        new_to_old.at(group.at(i)) = sorted_group.at(i);
+        permuted                   = true;
+      }
+    }
+  }
+
+  if (!permuted) {
+    return state;
+  }
+
+  std::optional<size_t> previous_routed;
+  for (const auto old_tr : new_to_old) {
+    if (state.train_edges.at(old_tr).empty()) {
+      continue;
+    }
+    if (previous_routed.has_value() && old_tr < previous_routed.value()) {
+      return state;
+    }
+    previous_routed = old_tr;
+  }
+
+  std::vector<size_t> old_to_new(new_to_old.size());
+  for (size_t tr = 0; tr < new_to_old.size(); ++tr) {
+    old_to_new.at(new_to_old.at(tr)) = tr;
+  }
+
+  GreedySimulatorState canonical{.train_edges    = {},
+                                 .ttd_orders     = state.ttd_orders,
+                                 .vertex_orders  = state.vertex_orders,
+                                 .stop_positions = {}};
+  canonical.train_edges.reserve(new_to_old.size());
+  canonical.stop_positions.reserve(new_to_old.size());
+  for (const auto old_tr : new_to_old) {
+    canonical.train_edges.push_back(state.train_edges.at(old_tr));
+    canonical.stop_positions.push_back(state.stop_positions.at(old_tr));
+  }
+  for (auto& order : canonical.ttd_orders) {
+    for (auto& tr : order) {
+      tr = old_to_new.at(tr);
+    }
+  }
+  for (auto& order : canonical.vertex_orders) {
+    for (auto& tr : order) {
+      tr = old_to_new.at(tr);
+    }
+  }
+  return canonical;
+}
+
+cda_rail::solver::astar_based::StateAction
+cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::state_action(
+    const GreedySimulatorState& state, const GreedySimulatorState& next_state) {
+  /**
+   * Extracts the action leading from state to next_state. Next states extend
+   * the route or stops of a single train and only append to orders.
+   */
+
+  StateAction action{.train              = state.train_edges.size(),
+                     .new_edges          = {},
+                     .new_stop_positions = {},
+                     .ttd_sections       = {},
+                     .vertices           = {}};
+  for (size_t tr = 0; tr < state.train_edges.size(); ++tr) {
+    const auto& edges      = state.train_edges.at(tr);
+    const auto& next_edges = next_state.train_edges.at(tr);
+    const auto& stops      = state.stop_positions.at(tr);
+    const auto& next_stops = next_state.stop_positions.at(tr);
+    if (edges != next_edges || stops != next_stops) {
+      action.train = tr;
+      action.new_edges.assign(
+          next_edges.begin() + static_cast<std::ptrdiff_t>(edges.size()),
+          next_edges.end());
+      action.new_stop_positions.assign(
+          next_stops.begin() + static_cast<std::ptrdiff_t>(stops.size()),
+          next_stops.end());
+      break;
+    }
+  }
+  if (action.train == state.train_edges.size()) {
+    throw cda_rail::exceptions::ConsistencyException(
+        "Next state does not extend any train.");
+  }
+
+  for (size_t ttd = 0; ttd < state.ttd_orders.size(); ++ttd) {
+    if (state.ttd_orders.at(ttd).size() !=
+        next_state.ttd_orders.at(ttd).size()) {
+      action.ttd_sections.push_back(ttd);
+    }
+  }
+  for (size_t v = 0; v < state.vertex_orders.size(); ++v) {
+    if (state.vertex_orders.at(v).size() !=
+        next_state.vertex_orders.at(v).size()) {
+      action.vertices.push_back(v);
+    }
+  }
+
+  return action;
+}
+
+cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
+    HashDistributedSearchResult
+    cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::
+        hash_distributed_search(
+            const ModelDetail&           model_detail_input,
+            const SolverStrategyMBAStar& solver_strategy_input, int time_limit,
+            const GreedySimulatorState& init_state) {
+  /**
+   * Hash-distributed A* (HDA*). Every state is owned by the worker
+   * std::hash(state) % num_threads. Only the owner detects duplicates,
+   * simulates the state, and stores it in its open list. Successors are sent
+   * to their owners in batches.
+   *
+   * open_states counts the states that are either in an inbox or in an open
+   * list. Successors are counted before their parent is removed. Hence, the
+   * counter only reaches zero once every state has been expanded or pruned by
+   * the incumbent, which proves its optimality.
+   *
+   * @param init_state: State the search is started from, it is evaluated by
+   * its owner
+   *
+   * @return: Incumbent, number of expansions, and whether the search space
+   * was exhausted
+   */
+
+  struct Inbox {
+    std::mutex                        mutex;
+    std::vector<GreedySimulatorState> states;
+  };
+
+  const size_t num_workers  = solver_strategy_input.num_threads;
+  const auto   ttd_sections = instance.const_n().unbreakable_sections();
+  const auto   owner        = [num_workers](const GreedySimulatorState& s) {
+    return std::hash<GreedySimulatorState>{}(s) % num_workers;
+  };
+
+  std::vector<Inbox>  inboxes(num_workers);
+  std::atomic<size_t> open_states         = 1;
+  std::atomic<size_t> expansions          = 0;
+  std::atomic<size_t> generated_states    = 0;
+  std::atomic<size_t> simulations         = 0;
+  std::atomic<bool>   stop                = false;
+  std::atomic<bool>   pruned_by_shared_ub = false;
+
+  // Incumbent, best_obj can be read without locking
+  std::mutex           incumbent_mutex;
+  std::atomic<double>  best_obj = cda_rail::INF;
+  GreedySimulatorState best_state;
+
+  inboxes.at(owner(init_state)).states.push_back(init_state);
+
+  const auto worker = [&](size_t w) {
+    simulator::GreedySimulator simulator(instance, ttd_sections);
+    // The cache is not thread-safe, hence, every worker uses its own
+    simulator::RemainingTimeHeuristicCache         heuristic_cache;
+    std::unordered_set<GreedySimulatorState>       explored_states;
+    MinPriorityQueue                               pq;
+    std::vector<GreedySimulatorState>              received;
+    std::vector<std::vector<GreedySimulatorState>> outboxes(num_workers);
+
+    const auto set_simulator_state = [&simulator](
+                                         const GreedySimulatorState& s) {
+      simulator.set_train_edges(s.train_edges);
+      simulator.set_ttd_orders(s.ttd_orders);
+      simulator.set_vertex_orders(s.vertex_orders);
+      simulator.set_stop_positions(s.stop_positions);
+    };
+
+    while (open_states > 0 && !stop) {
+      if (time_limit > 0) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+                                 std::chrono::high_resolution_clock::now() -
+                                 start)
+                                 .count();
+        if (elapsed >= time_limit) {
+          PLOGD << "Worker " << w << ": timeout reached after " << elapsed
+                << " seconds, stopping search.";
+          stop = true;
+          break;
+        }
+      }
+      if (shared_incumbent != nullptr &&
+          shared_incumbent->is_stop_requested()) {
+        PLOGD << "Worker " << w << ": stop requested by concurrent solver.";
+        stop = true;
+        break;
+      }
+
+      const double shared_ub = shared_incumbent != nullptr
+                                   ? shared_incumbent->get_upper_bound()
+                                   : cda_rail::INF;
+
+      // Evaluate states received from other workers
+      {
+        const std::lock_guard<std::mutex> lock(inboxes.at(w).mutex);
+        received.swap(inboxes.at(w).states);
+      }
+      for (const auto& s : received) {
+        if (!explored_states.insert(s).second) {
+          --open_states;
+          continue;
+        }
+        set_simulator_state(s);
+        ++simulations;
+        const auto sim_res = simulator.simulate(
+            model_detail_input.dt, model_detail_input.late_entry_possible,
+            model_detail_input.late_exit_possible,
+            model_detail_input.late_stop_possible,
+            model_detail_input.limit_speed_by_leaving_edges);
+        if (!sim_res.success) {
+          --open_states;
+          continue;
+        }
+        const auto obj =
+            simulator::objective_val(simulator, sim_res.exit_times);
+        const auto [heuristic_feas, heuristic_val] =
+            simulator::full_greedy_heuristic(
+                solver_strategy_input.braking_time_heuristic_type,
+                solver_strategy_input.remaining_time_heuristic_type, simulator,
+                sim_res, model_detail_input.late_stop_possible,
+                model_detail_input.late_exit_possible,
+                solver_strategy_input.consider_earliest_exit,
+                &heuristic_cache);
+        const auto new_obj = obj + heuristic_val;
+        if (simulator.is_final_state()) {
+          // Final states are not expanded, they only update the incumbent
+          const std::lock_guard<std::mutex> lock(incumbent_mutex);
+          if (new_obj < best_obj) {
+            PLOGD << "Worker " << w
+                  << ": explored new best final state with objective = "
+                  << new_obj;
+            best_obj   = new_obj;
+            best_state = s;
+            publish_incumbent(new_obj, s);
+          }
+        } else if (heuristic_feas && new_obj > shared_ub + GRB_EPS) {
+          pruned_by_shared_ub = true;
+        } else if (heuristic_feas && new_obj < best_obj - GRB_EPS) {
+          pq.push({{new_obj, false}, s});
+          continue;
+        }
+        --open_states;
+      }
+      received.clear();
+
+      if (pq.empty()) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      const auto [current_obj, current_state] = pq.top();
+      pq.pop();
+
+      const bool exceeds_shared_ub = current_obj.first > shared_ub + GRB_EPS;
+      if (exceeds_shared_ub || current_obj.first >= best_obj - GRB_EPS) {
+        // All states of this worker are bounded by an incumbent
+        if (exceeds_shared_ub) {
+          pruned_by_shared_ub = true;
+        }
+        open_states -= pq.size() + 1;
+        pq = MinPriorityQueue();
+        continue;
+      }
+
+      if (++expansions % DEBUG_LOGGING_RATE == 0) {
+        PLOGD << "Worker " << w << ": " << expansions
+              << " expansions, queue size: " << pq.size()
+              << ", current lower bound: " << current_obj.first
+              << ", best objective so far: " << best_obj;
+      }
+
+      set_simulator_state(current_state);
+      std::pmr::monotonic_buffer_resource expansion_arena(
+          cda_rail::thread_scratch_pool());
+      const auto next_states_set =
+          next_states(simulator, solver_strategy_input.next_state_strategy,
+                      &expansion_arena);
+      for (const auto& s : next_states_set) {
+        auto canonical = canonical_state(s);
+        outboxes.at(owner(canonical)).push_back(std::move(canonical));
+      }
+      open_states += next_states_set.size();
+      generated_states += next_states_set.size();
+      for (size_t dest = 0; dest < num_workers; ++dest) {
+        auto& outbox = outboxes.at(dest);
+        if (outbox.empty()) {
+          continue;
+        }
+        const std::lock_guard<std::mutex> lock(inboxes.at(dest).mutex);
+        auto& inbox = inboxes.at(dest).states;
+        inbox.insert(inbox.end(), std::make_move_iterator(outbox.begin()),
+                     std::make_move_iterator(outbox.end()));
+        outbox.clear();
+      }
+      --open_states;
+    }
+  };
+
+  PLOGI << "Starting hash-distributed A* search with " << num_workers
+        << " workers";
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(num_workers);
+  for (size_t w = 0; w < num_workers; ++w) {
+    futures.push_back(std::async(std::launch::async, worker, w));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  return {.exhausted           = open_states == 0,
+          .pruned_by_shared_ub = pruned_by_shared_ub,
+          .expansions          = expansions,
+          .generated_states    = generated_states,
+          .simulations         = simulations,
+          .best_obj            = best_obj,
+          .best_state          = std::move(best_state)};
+}
+
 // NOLINTBEGIN (cppcoreguidelines-pro-type-reinterpret-cast)
 cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
     cda_rail::instances::GeneralPerformanceOptimizationInstance>
@@ -237,6 +670,19 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::solve(
 
   const auto ttd_section = instance.const_n().unbreakable_sections();
   simulator::GreedySimulator simulator(instance, ttd_section);
+  // Remaining travel times of trains are shared among all states
+  simulator::RemainingTimeHeuristicCache heuristic_cache;
+  num_expansions       = 0;
+  num_generated_states = 0;
+  num_simulations      = 1; // Initial state
+
+  symmetric_train_groups = solver_strategy_input.symmetry_reduction
+                               ? instance.get_symmetric_train_groups()
+                               : std::vector<cda_rail::index_vector>{};
+  if (!symmetric_train_groups.empty()) {
+    PLOGD << "Found " << symmetric_train_groups.size()
+          << " groups of interchangeable trains";
+  }
 
   std::unordered_set<GreedySimulatorState> explored_states;
   MinPriorityQueue                         pq;
@@ -266,7 +712,7 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::solve(
           solver_strategy_input.remaining_time_heuristic_type, simulator,
           init_simulator_result, model_detail_input.late_stop_possible,
           model_detail_input.late_exit_possible,
-          solver_strategy_input.consider_earliest_exit);
+          solver_strategy_input.consider_earliest_exit, &heuristic_cache);
 
   PLOGD << "Initial state: final = "
         << (simulator.is_final_state() ? "yes" : "no")
@@ -287,10 +733,149 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::solve(
     explored_states.insert(init_state);
   }
 
-  size_t               iteration = 0;
-  double               best_obj  = cda_rail::INF;
+  size_t               iteration           = 0;
+  double               best_obj            = cda_rail::INF;
+  bool                 pruned_by_shared_ub = false;
   GreedySimulatorState best_state;
 
+  // With multiple threads, the search starting from the initial state is
+  // distributed among workers and the sequential loop below is skipped.
+  const bool hash_distributed           = solver_strategy_input.num_threads > 1;
+  bool       hash_distributed_exhausted = false;
+  if (hash_distributed && !pq.empty()) {
+    auto result = hash_distributed_search(
+        model_detail_input, solver_strategy_input, time_limit, pq.top().second);
+    pq.pop();
+    iteration                  = result.expansions;
+    num_expansions             = result.expansions;
+    num_generated_states       = result.generated_states;
+    num_simulations            = 1 + result.simulations;
+    pruned_by_shared_ub        = result.pruned_by_shared_ub;
+    hash_distributed_exhausted = result.exhausted;
+    if (result.exhausted && result.pruned_by_shared_ub) {
+      publish_optimality_proof(shared_incumbent->get_upper_bound());
+    }
+    if (result.best_obj < cda_rail::INF) {
+      best_obj   = result.best_obj;
+      best_state = std::move(result.best_state);
+      sol_object.set_obj(best_obj);
+      sol_object.set_solution_found();
+      sol_object.set_status(result.exhausted && !result.pruned_by_shared_ub
+                                ? cda_rail::SolutionStatus::Optimal
+                                : cda_rail::SolutionStatus::Feasible);
+    } else if (!result.exhausted) {
+      sol_object.set_status(cda_rail::SolutionStatus::Timeout);
+    }
+  }
+
+  // Screened states are queued with a key obtained by simulating with
+  // screening_dt, lowered by one coarse time step per train. The errors of a
+  // coarse simulation can accumulate over several events, hence, this key is
+  // not a proven lower bound. Screened states are never pruned by it and final
+  // states are only reported as feasible.
+  const bool screening =
+      solver_strategy_input.screening_dt > model_detail_input.dt;
+  std::unordered_set<GreedySimulatorState> unrefined_states;
+  double                                   screening_slack = 0.0;
+  if (screening) {
+    for (const auto& weight : instance.get_train_weights()) {
+      screening_slack += weight * solver_strategy_input.screening_dt;
+    }
+  }
+
+  const auto set_simulator_state = [&simulator](const GreedySimulatorState& s) {
+    simulator.set_train_edges(s.train_edges);
+    simulator.set_ttd_orders(s.ttd_orders);
+    simulator.set_vertex_orders(s.vertex_orders);
+    simulator.set_stop_positions(s.stop_positions);
+  };
+
+  const auto simulate_and_evaluate = [&](int dt) {
+    num_simulations++;
+    const auto sim_res = simulator.simulate(
+        dt, model_detail_input.late_entry_possible,
+        model_detail_input.late_exit_possible,
+        model_detail_input.late_stop_possible,
+        model_detail_input.limit_speed_by_leaving_edges);
+    if (!sim_res.success) {
+      return std::make_tuple(false, false, 0.0, 0.0);
+    }
+    const auto obj = simulator::objective_val(simulator, sim_res.exit_times);
+    const auto [heuristic_feas, heuristic_val] =
+        simulator::full_greedy_heuristic(
+            solver_strategy_input.braking_time_heuristic_type,
+            solver_strategy_input.remaining_time_heuristic_type, simulator,
+            sim_res, model_detail_input.late_stop_possible,
+            model_detail_input.late_exit_possible,
+            solver_strategy_input.consider_earliest_exit, &heuristic_cache);
+    return std::make_tuple(true, heuristic_feas, obj, heuristic_val);
+  };
+
+  // Simulates the state currently set in the simulator with the model's time
+  // step, updates the incumbent, and queues the state if it is promising.
+  const auto evaluate_and_push = [&](const GreedySimulatorState& s,
+                                     double                      shared_ub) {
+    const auto [success, heuristic_feas, obj, heuristic_val] =
+        simulate_and_evaluate(model_detail_input.dt);
+    if (!success) {
+      PLOGV << "State is infeasible, skipping.";
+      return;
+    }
+    const auto new_obj = obj + heuristic_val;
+    const auto final   = simulator.is_final_state();
+    PLOGV << "Objective = " << obj << ", heuristic = " << heuristic_val
+          << ", total = " << new_obj << ", feasibility = "
+          << (heuristic_feas ? "feasible" : "infeasible")
+          << ", final = " << (final ? "yes" : "no");
+    if (final && new_obj < best_obj) {
+      PLOGD << "Explored new best final state with objective = " << new_obj
+            << " after " << iteration << " iterations, "
+            << std::chrono::duration_cast<std::chrono::seconds>(
+                   std::chrono::high_resolution_clock::now() - start)
+                   .count()
+            << " seconds.";
+      best_obj   = new_obj;
+      best_state = s;
+      sol_object.set_obj(best_obj);
+      sol_object.set_solution_found();
+      sol_object.set_status(cda_rail::SolutionStatus::Feasible);
+      publish_incumbent(best_obj, best_state);
+    }
+    if (heuristic_feas && new_obj > shared_ub + GRB_EPS) {
+      PLOGV << "State exceeds shared incumbent, skipping.";
+      pruned_by_shared_ub = true;
+    } else if (heuristic_feas) {
+      pq.push({{new_obj, final}, s});
+      explored_states.insert(s);
+      PLOGV << "State added to priority queue.";
+    }
+  };
+
+  // With partial order reduction, every queued state stores the actions that
+  // need not be taken from it, since they are taken in another interleaving.
+  const bool por = solver_strategy_input.partial_order_reduction;
+  std::unordered_map<GreedySimulatorState, std::vector<StateAction>>
+                                           sleep_sets;
+  std::unordered_set<GreedySimulatorState> expanded_states;
+
+  // Sleep sets of states reached along several paths are intersected. If
+  // actions are woken up in an already expanded state, it is queued again.
+  const auto update_sleep_set = [&](const GreedySimulatorState&     s,
+                                    const std::vector<StateAction>& new_sleep,
+                                    double                          shared_ub) {
+    const auto it = sleep_sets.find(s);
+    if (it == sleep_sets.end()) {
+      return;
+    }
+    const auto removed = std::erase_if(it->second, [&](const auto& a) {
+      return !std::ranges::contains(new_sleep, a);
+    });
+    if (removed > 0 && expanded_states.erase(s) > 0) {
+      PLOGV << "Actions woken up in expanded state, reevaluating.";
+      evaluate_and_push(s, shared_ub);
+    }
+  };
+
   // A* iteration
   while (!pq.empty()) {
     // If timeout is reached break the loop
@@ -307,12 +892,48 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::solve(
         break;
       }
     }
+    if (shared_incumbent != nullptr && shared_incumbent->is_stop_requested()) {
+      PLOGD << "Stop requested by concurrent solver.";
+      if (!sol_object.has_solution()) {
+        sol_object.set_status(cda_rail::SolutionStatus::Timeout);
+      }
+      break;
+    }
 
     iteration++;
 
     const auto [current_obj, current_state] = pq.top();
     pq.pop();
 
+    if (unrefined_states.erase(current_state) > 0) {
+      // The key of a screened state is replaced by its exact value
+      PLOGV << "Refining screened state.";
+      set_simulator_state(current_state);
+      evaluate_and_push(current_state,
+                        shared_incumbent != nullptr
+                            ? shared_incumbent->get_upper_bound()
+                            : cda_rail::INF);
+      continue;
+    }
+
+    // Incumbents of concurrent solvers are upper bounds for the search
+    const double shared_ub = shared_incumbent != nullptr
+                                 ? shared_incumbent->get_upper_bound()
+                                 : cda_rail::INF;
+    if (current_obj.first > shared_ub + GRB_EPS) {
+      PLOGD << "Lower bound " << current_obj.first
+            << " exceeds shared incumbent " << shared_ub
+            << ", stopping search.";
+      // Screened keys are no proven bounds, see above
+      if (!screening) {
+        publish_optimality_proof(std::min(current_obj.first, shared_ub));
+      }
+      if (!sol_object.has_solution()) {
+        sol_object.set_status(cda_rail::SolutionStatus::Timeout);
+      }
+      break;
+    }
+
     if (iteration % DEBUG_LOGGING_RATE == 0) {
       PLOGD << "----------------------------";
       PLOGD << "Iteration " << iteration << ", queue size: " << pq.size();
@@ -336,75 +957,99 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::solve(
       best_state = current_state;
       sol_object.set_obj(best_obj);
       sol_object.set_solution_found();
-      sol_object.set_status(cda_rail::SolutionStatus::Optimal);
+      // Keys of screened states might have been too high
+      sol_object.set_status(screening ? cda_rail::SolutionStatus::Feasible
+                                      : cda_rail::SolutionStatus::Optimal);
+      publish_incumbent(best_obj, best_state);
       break;
     }
 
-    simulator.set_train_edges(current_state.train_edges);
-    simulator.set_ttd_orders(current_state.ttd_orders);
-    simulator.set_vertex_orders(current_state.vertex_orders);
-    simulator.set_stop_positions(current_state.stop_positions);
+    set_simulator_state(current_state);
+
+    std::vector<StateAction> current_sleep_set;
+    std::vector<StateAction> taken_actions;
+    if (por) {
+      current_sleep_set = sleep_sets[current_state];
+      expanded_states.insert(current_state);
+    }
 
+    // Memory of the next states is released at once after the expansion.
+    // Sleeping actions are not generated at all.
+    num_expansions++;
+    std::pmr::monotonic_buffer_resource expansion_arena(
+        cda_rail::thread_scratch_pool());
     const auto next_states_set =
-        next_states(simulator, solver_strategy_input.next_state_strategy);
+        next_states(simulator, solver_strategy_input.next_state_strategy,
+                    &expansion_arena, current_sleep_set);
+    num_generated_states += next_states_set.size();
     PLOGV << "Found " << next_states_set.size() << " next states.";
     size_t i = 0;
-    for (const auto& s : next_states_set) {
+    for (const auto& next_state : next_states_set) {
       i++;
       PLOGV << "Processing next state " << i << "/" << next_states_set.size();
-      simulator.set_train_edges(s.train_edges);
-      simulator.set_ttd_orders(s.ttd_orders);
-      simulator.set_vertex_orders(s.vertex_orders);
-      simulator.set_stop_positions(s.stop_positions);
+      const auto s = canonical_state(next_state);
+
+      std::optional<StateAction> action;
+      std::vector<StateAction>   s_sleep_set;
+      if (por) {
+        action = state_action(current_state, next_state);
+        // Train indices of actions change if the successor is renumbered
+        if (s == next_state) {
+          for (const auto* actions : {&current_sleep_set, &taken_actions}) {
+            std::ranges::copy_if(*actions, std::back_inserter(s_sleep_set),
+                                 [&action](const StateAction& a) {
+                                   return a.is_independent_of(*action);
+                                 });
+          }
+        }
+      }
+
+      set_simulator_state(s);
       if (explored_states.contains(s)) {
         PLOGV << "State already explored, skipping.";
+        if (por) {
+          update_sleep_set(s, s_sleep_set, shared_ub);
+          taken_actions.push_back(std::move(*action));
+        }
         continue;
       }
 
-      const auto sim_res = simulator.simulate(
-          model_detail_input.dt, model_detail_input.late_entry_possible,
-          model_detail_input.late_exit_possible,
-          model_detail_input.late_stop_possible,
-          model_detail_input.limit_speed_by_leaving_edges);
-      if (!sim_res.success) {
-        PLOGV << "State is infeasible, skipping.";
-        continue;
-      }
-      const auto obj = simulator::objective_val(simulator, sim_res.exit_times);
-      const auto [heuristic_feas, heuristic_val] =
-          simulator::full_greedy_heuristic(
-              solver_strategy_input.braking_time_heuristic_type,
-              solver_strategy_input.remaining_time_heuristic_type, simulator,
-              sim_res, model_detail_input.late_stop_possible,
-              model_detail_input.late_exit_possible,
-              solver_strategy_input.consider_earliest_exit);
-      const auto new_obj = obj + heuristic_val;
-      const auto final   = simulator.is_final_state();
-      PLOGV << "Objective = " << obj << ", heuristic = " << heuristic_val
-            << ", total = " << new_obj << ", feasibility = "
-            << (heuristic_feas ? "feasible" : "infeasible")
-            << ", final = " << (final ? "yes" : "no");
-      if (final && new_obj < best_obj) {
-        PLOGD << "Explored new best final state with objective = " << new_obj
-              << " after " << iteration << " iterations, "
-              << std::chrono::duration_cast<std::chrono::seconds>(
-                     std::chrono::high_resolution_clock::now() - start)
-                     .count()
-              << " seconds.";
-        best_obj   = new_obj;
-        best_state = s;
-        sol_object.set_obj(best_obj);
-        sol_object.set_solution_found();
-        sol_object.set_status(cda_rail::SolutionStatus::Feasible);
+      if (screening) {
+        const auto [success, heuristic_feas, obj, heuristic_val] =
+            simulate_and_evaluate(solver_strategy_input.screening_dt);
+        if (success && heuristic_feas) {
+          const auto screened_obj = obj + heuristic_val - screening_slack;
+          PLOGV << "Screened objective = " << obj
+                << ", heuristic = " << heuristic_val
+                << ", screened total = " << screened_obj;
+          pq.push({{screened_obj, false}, s});
+          explored_states.insert(s);
+          unrefined_states.insert(s);
+          PLOGV << "Screened state added to priority queue.";
+          if (por) {
+            sleep_sets.emplace(s, std::move(s_sleep_set));
+            taken_actions.push_back(std::move(*action));
+          }
+          continue;
+        }
+        // A coarse time step can miss feasible behavior, hence, screening
+        // failures are decided with the model's time step.
+        PLOGV << "Screening inconclusive, simulating with model time step.";
       }
-      if (heuristic_feas) {
-        pq.push({{new_obj, final}, s});
-        explored_states.insert(s);
-        PLOGV << "State added to priority queue.";
+
+      evaluate_and_push(s, shared_ub);
+      if (por && explored_states.contains(s)) {
+        sleep_sets.emplace(s, std::move(s_sleep_set));
+        taken_actions.push_back(std::move(*action));
       }
     }
   }
 
+  if (!hash_distributed && pq.empty() && pruned_by_shared_ub && !screening) {
+    // The search space is exhausted by the shared incumbent
+    publish_optimality_proof(shared_incumbent->get_upper_bound());
+  }
+
   model_solved =
       std::chrono::high_resolution_clock::now(); // Finished model solving
 
@@ -414,6 +1059,15 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::solve(
                 .count() /
             1000.0)
         << " seconds.";
+  PLOGD << "Expanded " << num_expansions << ", generated "
+        << num_generated_states << ", and simulated " << num_simulations
+        << " states.";
+  PLOGD << "Remaining travel times cached for " << heuristic_cache.size()
+        << " train positions, reused " << heuristic_cache.get_hits()
+        << " times.";
+  const auto scratch_counters = cda_rail::scratch_allocation_counters();
+  PLOGD << "Scratch pools requested " << scratch_counters.allocations
+        << " allocations (" << scratch_counters.bytes << " bytes) in total.";
 
   PLOGI << "Extracting solution object...";
 
@@ -458,8 +1112,16 @@ cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver::solve(
     }
   }
 
-  if (pq.empty() && !sol_object.has_solution()) {
-    sol_object.set_status(cda_rail::SolutionStatus::Infeasible);
+  if (pq.empty() && !sol_object.has_solution() &&
+      (!hash_distributed || hash_distributed_exhausted)) {
+    // Pruning by a concurrent incumbent does not prove infeasibility
+    sol_object.set_status(pruned_by_shared_ub
+                              ? cda_rail::SolutionStatus::Timeout
+                              : cda_rail::SolutionStatus::Infeasible);
+  }
+
+  if (sol_object.get_status() == cda_rail::SolutionStatus::Optimal) {
+    publish_optimality_proof(sol_object.get_obj());
   }
 
   PLOGI << "DONE! Solution extracted.";
@@ -0,0 +1,73 @@
+#include "solver/mip-based/GRBEnvPool.hpp"
+
+#include "gurobi_c++.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <plog/Log.h>
+#include <utility>
+
+cda_rail::solver::mip_based::GRBEnvPool&
+cda_rail::solver::mip_based::GRBEnvPool::get_instance() {
+  static GRBEnvPool instance;
+  return instance;
+}
+
+std::shared_ptr<GRBEnv> cda_rail::solver::mip_based::GRBEnvPool::acquire() {
+  /**
+   * Returns a started environment, either from the pool or newly created.
+   * Parameters of reused environments are reset to their default values so
+   * that no settings leak from one solve into the next one.
+   */
+
+  std::unique_ptr<GRBEnv> env;
+  bool                    reset_params = false;
+  {
+    const std::lock_guard<std::mutex> lock(pool_mutex);
+    if (!available_envs.empty()) {
+      env = std::move(available_envs.back());
+      available_envs.pop_back();
+      num_reused_envs++;
+      reset_params = reset_params_on_reuse;
+    }
+  }
+
+  if (env == nullptr) {
+    // Starting the environment is the expensive part, do not hold the lock
+    PLOGD << "Start new Gurobi environment";
+    env = std::make_unique<GRBEnv>(true);
+    env->start();
+    const std::lock_guard<std::mutex> lock(pool_mutex);
+    num_created_envs++;
+  } else if (reset_params) {
+    env->resetParams();
+  }
+
+  return {env.release(), [this](GRBEnv* env_ptr) { release(env_ptr); }};
+}
+
+void cda_rail::solver::mip_based::GRBEnvPool::release(GRBEnv* env) {
+  std::unique_ptr<GRBEnv> env_ptr(env);
+
+  const std::lock_guard<std::mutex> lock(pool_mutex);
+  if (available_envs.size() < max_pool_size) {
+    available_envs.push_back(std::move(env_ptr));
+  }
+  // Otherwise, the environment is destroyed when env_ptr goes out of scope
+}
+
+void cda_rail::solver::mip_based::GRBEnvPool::clear() {
+  // Environments that are currently borrowed are unaffected
+  const std::lock_guard<std::mutex> lock(pool_mutex);
+  available_envs.clear();
+}
+
+void cda_rail::solver::mip_based::GRBEnvPool::set_max_pool_size(
+    size_t max_size) {
+  const std::lock_guard<std::mutex> lock(pool_mutex);
+  max_pool_size = max_size;
+  if (available_envs.size() > max_pool_size) {
+    available_envs.resize(max_pool_size);
+  }
+}
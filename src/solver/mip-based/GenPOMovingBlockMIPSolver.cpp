@@ -13,12 +13,16 @@
 #include "solver/mip-based/GeneralMIPSolver.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <limits>
+#include <map>
+#include <memory>
 #include <numeric>
 #include <optional>
 #include <string>
@@ -50,11 +54,15 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
    * @return: respective solution object
    */
 
-  std::optional<LazyCallback> cb;
-  if (solver_strategy_input.use_lazy_constraints) {
-    cb = LazyCallback(this);
+  // A model retained from a previous solve is replaced
+  release_model();
+
+  if (solver_strategy_input.use_lazy_constraints ||
+      shared_incumbent != nullptr) {
+    // The callback is a member so that it outlives a retained model
+    lazy_callback = LazyCallback(this);
     this->solve_init_general_mip(time_limit, debug_input, overwrite_severity,
-                                 &(cb.value()));
+                                 &(lazy_callback.value()));
   } else {
     this->solve_init_general_mip(time_limit, debug_input, overwrite_severity);
   }
@@ -73,8 +81,12 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
   this->initialize_variables(solution_settings_input, solver_strategy_input,
                              model_detail_input);
 
+  coefficient_tolerance = model->getEnv().get(GRB_DoubleParam_IntFeasTol);
+
   PLOGD << "Create variables";
   create_variables();
+  // Variable indices are needed to merge terms of constraints
+  model->update();
   PLOGD << "Set objective";
   set_objective();
   PLOGD << "Create constraints";
@@ -82,27 +94,12 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
 
   model->update();
 
-  PLOGD << "Fix numerical issues with small coefficients";
-  // TODO: Can we prevent this from being necessary by rounding at the source.
-  // On the other hand, this does not take long to fix.
-  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-  size_t       num_fixed   = 0;
-  const double integer_tol = model->getEnv().get(GRB_DoubleParam_IntFeasTol);
-  auto*        vars_tmp    = model->getVars();
-  const int    num_vars    = model->get(GRB_IntAttr_NumVars);
-  for (size_t i = 0; i < num_vars; i++) {
-    auto col_v = model->getCol(vars_tmp[i]);
-    for (size_t j = 0; j < col_v.size(); j++) {
-      if (std::abs(col_v.getCoeff(static_cast<int>(j))) < integer_tol &&
-          col_v.getCoeff(static_cast<int>(j)) != 0) {
-        auto c = col_v.getConstr(static_cast<int>(j));
-        model->chgCoeff(c, vars_tmp[i], 0);
-        num_fixed++;
-      }
-    }
+  if (solver_strategy.use_lazy_constraints) {
+    add_promoted_lazy_cuts();
   }
-  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-  PLOGD << "Fixed " << num_fixed << " coefficients";
+
+  PLOGD << "Dropped " << num_dropped_coefficients
+        << " coefficients below tolerance";
 
   PLOGI << "Model created. Optimize.";
   if (plog::get()->checkSeverity(plog::debug) || time_limit > 0) {
@@ -137,6 +134,27 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
 
   model->optimize();
 
+  // The simplified headway constraints restrict the solution space, hence,
+  // optimality does not carry over to the original problem.
+  if (shared_incumbent != nullptr &&
+      model->get(GRB_IntAttr_Status) == GRB_OPTIMAL &&
+      !model_detail.simplify_headway_constraints) {
+    PLOGD << "Optimal solution stops all concurrent solvers";
+    shared_incumbent->update_upper_bound(
+        absolute_objective(instance, model->get(GRB_DoubleAttr_ObjVal)));
+    shared_incumbent->update_lower_bound(
+        absolute_objective(instance, model->get(GRB_DoubleAttr_ObjBound)));
+    shared_incumbent->request_stop();
+  }
+
+  if (solver_strategy.use_lazy_constraints) {
+    PLOGD << "Lazy cut pool contains " << lazy_cut_pool.size()
+          << " constraints after " << num_lazy_callbacks << " callbacks";
+    if (solver_strategy.promote_lazy_cuts_after > 0) {
+      promote_frequent_lazy_cuts();
+    }
+  }
+
   IF_PLOG(plog::debug) {
     model_solved = std::chrono::high_resolution_clock::now();
     solve_time   = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -196,6 +214,13 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::solve(
     solution.export_solution(path, export_instance);
   }
 
+  if (solver_strategy.retain_model) {
+    PLOGD << "Retain model for incremental re-solves";
+    retained_instance         = old_instance;
+    incumbent_stored_as_start = false;
+    return solution;
+  }
+
   cleanup();
 
   this->instance = old_instance;
@@ -417,158 +442,262 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::set_objective() {
   model->setObjective(obj_expr, GRB_MINIMIZE);
 }
 
+double cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    absolute_objective(
+        const instances::GeneralPerformanceOptimizationInstance& instance,
+        double                                                   obj) {
+  double tr_weight_sum = 0;
+  double offset        = 0;
+  for (size_t tr = 0; tr < instance.get_train_list().size(); tr++) {
+    const auto& tr_weight = instance.get_train_weights().at(tr);
+    tr_weight_sum += tr_weight;
+    offset += tr_weight * instance.get_schedule(tr).get_t_n_range().first;
+  }
+  return (obj * tr_weight_sum) + offset;
+}
+
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     create_constraints() {
-  PLOGD << "Create general path constraints";
-  create_general_path_constraints();
-  PLOGD << "Create travel times constraints";
-  create_travel_times_constraints();
-  PLOGD << "Create basic TTD constraints";
-  create_basic_ttd_constraints();
-  PLOGD << "Create train rear constraints";
-  create_train_rear_constraints();
-  PLOGD << "Create stopping constraints";
-  create_stopping_constraints();
+  /**
+   * Creates all constraint families. If parallel_model_building is set, the
+   * stopping constraints, which also add variables, are created first. All
+   * other families only add linear constraints and are built concurrently.
+   */
+
+  const bool parallel = solver_strategy.parallel_model_building;
+  if (parallel) {
+    PLOGD << "Create stopping constraints";
+    create_stopping_constraints();
+  }
+
+  std::vector<std::function<void()>> families;
+  families.emplace_back([this]() {
+    PLOGD << "Create general path constraints";
+    create_general_path_constraints();
+  });
+  families.emplace_back([this]() {
+    PLOGD << "Create travel times constraints";
+    create_travel_times_constraints();
+  });
+  families.emplace_back([this]() {
+    PLOGD << "Create basic TTD constraints";
+    create_basic_ttd_constraints();
+  });
+  families.emplace_back([this]() {
+    PLOGD << "Create train rear constraints";
+    create_train_rear_constraints();
+  });
+  if (!parallel) {
+    families.emplace_back([this]() {
+      PLOGD << "Create stopping constraints";
+      create_stopping_constraints();
+    });
+  }
+  if (solver_strategy.break_train_symmetries) {
+    families.emplace_back([this]() {
+      PLOGD << "Create symmetry breaking constraints";
+      create_symmetry_breaking_constraints();
+    });
+  }
   if (!solver_strategy.use_lazy_constraints) {
-    PLOGD << "Create basic order constraints";
-    create_basic_order_constraints();
-    PLOGD << "Create vertex headway constraints";
-    create_vertex_headway_constraints();
-    PLOGD << "Create reverse edge constraints";
-    create_reverse_edge_constraints();
+    families.emplace_back([this]() {
+      PLOGD << "Create basic order constraints";
+      create_basic_order_constraints();
+    });
+    families.emplace_back([this]() {
+      PLOGD << "Create vertex headway constraints";
+      create_vertex_headway_constraints();
+    });
+    families.emplace_back([this]() {
+      PLOGD << "Create reverse edge constraints";
+      create_reverse_edge_constraints();
+    });
     if (this->model_detail.simplify_headway_constraints) {
-      PLOGD << "Create simplified headway constraints";
-      create_simplified_headway_constraints();
+      families.emplace_back([this]() {
+        PLOGD << "Create simplified headway constraints";
+        create_simplified_headway_constraints();
+      });
     } else {
-      PLOGD << "Create headway constraints";
-      create_headway_constraints();
+      families.emplace_back([this]() {
+        PLOGD << "Create headway constraints";
+        create_headway_constraints();
+      });
     }
   }
+
+  build_constraint_families(families, parallel);
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    fill_train_classes() {
+  /**
+   * Groups trains with identical physics and identical usable edges into
+   * classes. All preprocessing that only depends on these properties is done
+   * once per class.
+   */
+  train_classes.clear();
+  train_class_representatives.clear();
+  train_class_edges.clear();
+  train_classes.reserve(num_tr);
+
+  const auto physics_classes = instance.get_train_list().get_train_classes();
+  std::map<std::pair<size_t, cda_rail::index_vector>, size_t> class_indices;
+  for (size_t tr = 0; tr < num_tr; tr++) {
+    auto tr_edges =
+        instance.edges_used_by_train(tr, model_detail.fix_routes, false);
+    auto sorted_edges = tr_edges;
+    std::ranges::sort(sorted_edges);
+    const auto [class_it, is_new_class] = class_indices.try_emplace(
+        {physics_classes.at(tr), std::move(sorted_edges)},
+        class_indices.size());
+    if (is_new_class) {
+      train_class_representatives.push_back(tr);
+      train_class_edges.push_back(std::move(tr_edges));
+    }
+    train_classes.push_back(class_it->second);
+  }
+
+  PLOGD << "Grouped " << num_tr << " trains into "
+        << train_class_representatives.size() << " classes";
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     fill_tr_stop_data() {
   tr_stop_data.clear();
-  tr_stop_data.reserve(num_tr);
+  tr_stop_data.resize(num_tr);
 
+  // Possible stops only depend on the train class and the station
+  std::map<std::pair<size_t, std::string>, std::shared_ptr<const StopData>>
+      class_stop_data;
   for (size_t tr = 0; tr < num_tr; tr++) {
-    std::vector<
-        std::vector<std::pair<size_t, std::vector<cda_rail::index_vector>>>>
-        tr_data;
-    tr_data.reserve(instance.get_schedule(tr).get_stops().size());
-    for (const auto& stop : instance.get_schedule(tr).get_stops()) {
-      tr_data.emplace_back(instance.possible_stop_vertices(
-          tr, stop.get_station_name(),
-          instance.edges_used_by_train(tr, model_detail.fix_routes, false)));
+    const auto& tr_class = train_classes.at(tr);
+    const auto& stops    = instance.get_schedule(tr).get_stops();
+    tr_stop_data.at(tr).reserve(stops.size());
+    for (const auto& stop : stops) {
+      auto& stop_data =
+          class_stop_data[{tr_class, stop.get_station_name()}];
+      if (stop_data == nullptr) {
+        stop_data = std::make_shared<const StopData>(
+            instance.possible_stop_vertices(
+                train_class_representatives.at(tr_class),
+                stop.get_station_name(), train_class_edges.at(tr_class)));
+      }
+      tr_stop_data.at(tr).push_back(stop_data);
     }
-    tr_stop_data.emplace_back(tr_data);
   }
 }
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     fill_velocity_extensions() {
   velocity_extensions.clear();
-  if (model_detail.velocity_refinement_strategy ==
-      VelocityRefinementStrategy::None) {
-    fill_velocity_extensions_using_none_strategy();
-  } else if (model_detail.velocity_refinement_strategy ==
-             VelocityRefinementStrategy::MinOneStep) {
-    fill_velocity_extensions_using_min_one_step_strategy();
-  } else {
+  const bool min_one_step = model_detail.velocity_refinement_strategy ==
+                            VelocityRefinementStrategy::MinOneStep;
+  if (!min_one_step && model_detail.velocity_refinement_strategy !=
+                           VelocityRefinementStrategy::None) {
     throw exceptions::InvalidInputException(
         "Velocity refinement strategy not implemented.");
   }
-}
 
-void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
-    fill_velocity_extensions_using_none_strategy() {
-  velocity_extensions.reserve(num_tr);
-  for (size_t tr = 0; tr < num_tr; tr++) {
-    std::vector<std::vector<double>> tr_velocity_extensions;
-    tr_velocity_extensions.reserve(num_vertices);
-    const auto& tr_max_speed =
-        instance.get_train_list().get_train(tr).max_speed;
+  // Class tables, the entry and exit vertices are handled per train
+  std::vector<std::vector<std::shared_ptr<const std::vector<double>>>>
+      class_velocity_extensions;
+  class_velocity_extensions.reserve(train_class_representatives.size());
+  for (size_t c = 0; c < train_class_representatives.size(); c++) {
+    const auto& tr       = train_class_representatives.at(c);
+    const auto& tr_edges = train_class_edges.at(c);
+    auto&       c_velocity_extensions =
+        class_velocity_extensions.emplace_back();
+    c_velocity_extensions.reserve(num_vertices);
     for (size_t v = 0; v < num_vertices; v++) {
-      if (instance.get_schedule(tr).get_entry() == v) {
-        tr_velocity_extensions.emplace_back(
-            std::vector<double>{instance.get_schedule(tr).get_v_0()});
-        continue;
-      }
-
-      std::vector<double> v_velocity_extensions = {0};
-      const double        max_vertex_speed      = std::min(
-          instance.const_n().maximal_vertex_speed(
-              v,
-              instance.edges_used_by_train(tr, model_detail.fix_routes, false)),
-          tr_max_speed);
-      double speed = 0;
-      while (speed < max_vertex_speed) {
-        speed += model_detail.max_velocity_delta;
-        speed = std::min(speed, max_vertex_speed);
-        v_velocity_extensions.emplace_back(speed);
-      }
-      tr_velocity_extensions.emplace_back(v_velocity_extensions);
+      auto v_velocity_extensions =
+          min_one_step ? velocity_extensions_using_min_one_step_strategy(
+                             tr, v, tr_edges, false)
+                       : velocity_extensions_using_none_strategy(tr, v,
+                                                                 tr_edges);
+      c_velocity_extensions.push_back(
+          std::make_shared<const std::vector<double>>(
+              std::move(v_velocity_extensions)));
     }
-    velocity_extensions.emplace_back(tr_velocity_extensions);
   }
-}
 
-void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
-    fill_velocity_extensions_using_min_one_step_strategy() {
-  velocity_extensions.reserve(num_tr);
+  velocity_extensions.resize(num_tr);
   for (size_t tr = 0; tr < num_tr; tr++) {
-    std::vector<std::vector<double>> tr_velocity_extensions;
+    const auto& tr_class               = train_classes.at(tr);
+    const auto& schedule               = instance.get_schedule(tr);
+    auto&       tr_velocity_extensions = velocity_extensions.at(tr);
     tr_velocity_extensions.reserve(num_vertices);
-    const auto& tr_object = instance.get_train_list().get_train(tr);
-    const auto  tr_speed_change =
-        std::min(tr_object.acceleration, tr_object.deceleration);
-    const auto& tr_max_speed = tr_object.max_speed;
-    const auto& tr_length    = tr_object.length;
     for (size_t v = 0; v < num_vertices; v++) {
-      if (instance.get_schedule(tr).get_entry() == v) {
-        tr_velocity_extensions.emplace_back(
-            std::vector<double>{instance.get_schedule(tr).get_v_0()});
-        continue;
+      if (schedule.get_entry() == v) {
+        tr_velocity_extensions.push_back(
+            std::make_shared<const std::vector<double>>(
+                std::vector<double>{schedule.get_v_0()}));
+      } else if (min_one_step && schedule.get_exit() == v) {
+        tr_velocity_extensions.push_back(
+            std::make_shared<const std::vector<double>>(
+                velocity_extensions_using_min_one_step_strategy(
+                    tr, v, train_class_edges.at(tr_class), true)));
+      } else {
+        tr_velocity_extensions.push_back(
+            class_velocity_extensions.at(tr_class).at(v));
       }
+    }
+  }
+}
 
-      const double max_vertex_speed = std::min(
-          instance.const_n().maximal_vertex_speed(
-              v,
-              instance.edges_used_by_train(tr, model_detail.fix_routes, false)),
-          tr_max_speed);
-      double min_n_length =
-          instance.const_n().minimal_neighboring_edge_length(v);
-
-      if (min_n_length > tr_length &&
-          instance.get_schedule(tr).get_exit() == v) {
-        min_n_length = tr_length;
-      }
+std::vector<double> cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    velocity_extensions_using_none_strategy(
+        size_t tr, size_t v, const index_vector& tr_edges) const {
+  const double max_vertex_speed =
+      std::min(instance.const_n().maximal_vertex_speed(v, tr_edges),
+               instance.get_train_list().get_train(tr).max_speed);
+
+  std::vector<double> v_velocity_extensions = {0};
+  double              speed                 = 0;
+  while (speed < max_vertex_speed) {
+    speed += model_detail.max_velocity_delta;
+    speed = std::min(speed, max_vertex_speed);
+    v_velocity_extensions.emplace_back(speed);
+  }
+  return v_velocity_extensions;
+}
 
-      std::vector<double> v_velocity_extensions = {0};
-      double              speed                 = 0;
-      while (speed < max_vertex_speed) {
-        // Buffer, because due to numerics some values might be slightly too
-        // big.
-        const auto sqrt_tmp = std::max(
-            std::sqrt((speed * speed) + (2 * tr_speed_change * min_n_length)) -
-                V_MIN,
-            speed + V_MIN);
-        speed = std::min({speed + model_detail.max_velocity_delta, sqrt_tmp,
-                          max_vertex_speed});
-        v_velocity_extensions.emplace_back(speed);
-      }
-      tr_velocity_extensions.emplace_back(v_velocity_extensions);
-    }
-    velocity_extensions.emplace_back(tr_velocity_extensions);
+std::vector<double> cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    velocity_extensions_using_min_one_step_strategy(
+        size_t tr, size_t v, const index_vector& tr_edges, bool is_exit) const {
+  const auto& tr_object = instance.get_train_list().get_train(tr);
+  const auto  tr_speed_change =
+      std::min(tr_object.acceleration, tr_object.deceleration);
+  const double max_vertex_speed =
+      std::min(instance.const_n().maximal_vertex_speed(v, tr_edges),
+               tr_object.max_speed);
+  double min_n_length = instance.const_n().minimal_neighboring_edge_length(v);
+
+  if (min_n_length > tr_object.length && is_exit) {
+    min_n_length = tr_object.length;
   }
+
+  std::vector<double> v_velocity_extensions = {0};
+  double              speed                 = 0;
+  while (speed < max_vertex_speed) {
+    // Buffer, because due to numerics some values might be slightly too
+    // big.
+    const auto sqrt_tmp = std::max(
+        std::sqrt((speed * speed) + (2 * tr_speed_change * min_n_length)) -
+            V_MIN,
+        speed + V_MIN);
+    speed = std::min(
+        {speed + model_detail.max_velocity_delta, sqrt_tmp, max_vertex_speed});
+    v_velocity_extensions.emplace_back(speed);
+  }
+  return v_velocity_extensions;
 }
 
 size_t cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     get_maximal_velocity_extension_size() const {
   size_t max_size = 0;
   for (const auto& tr_velocity_extensions : velocity_extensions) {
-    for (const auto& v_velocity_extensions : tr_velocity_extensions) {
-      max_size = std::max(max_size, v_velocity_extensions.size());
+    for (size_t v = 0; v < tr_velocity_extensions.size(); v++) {
+      max_size = std::max(max_size, tr_velocity_extensions.at(v).size());
     }
   }
   return max_size;
@@ -601,6 +730,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
   this->model_detail      = model_detail_input;
   this->ttd_sections      = instance.n().unbreakable_sections();
   this->num_ttd           = this->ttd_sections.size();
+  this->fill_train_classes();
   this->fill_tr_stop_data();
   this->fill_velocity_extensions();
   this->fill_relevant_reverse_edges();
@@ -617,7 +747,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
       const auto&      target_obj = instance.const_n().get_vertex(edge.target);
       const auto&      v1_values  = velocity_extensions.at(tr).at(edge.source);
       const auto&      v2_values  = velocity_extensions.at(tr).at(edge.target);
-      const GRBLinExpr lhs        = vars["x"](tr, e);
+      const GRBLinExpr lhs        = vars.at("x")(tr, e);
       GRBLinExpr       rhs        = 0;
       const auto tmp_max_speed = std::min(tr_object.max_speed, edge.max_speed);
       for (size_t i = 0; i < v1_values.size(); i++) {
@@ -631,14 +761,14 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
           if (cda_rail::possible_by_eom(v1_values.at(i), v2_values.at(j),
                                         tr_object.acceleration,
                                         tr_object.deceleration, edge.length)) {
-            rhs += vars["y"](tr, e, i, j);
+            rhs += vars.at("y")(tr, e, i, j);
           }
         }
       }
       // Edge is used if one of the velocity extended arcs is used
-      model->addConstr(lhs == rhs, "aggregate_edge_velocity_extension_" +
-                                       tr_object.name + "_" + source_obj.name +
-                                       "-" + target_obj.name);
+      this->add_constr(lhs, GRB_EQUAL, rhs,
+                       "aggregate_edge_velocity_extension_" + tr_object.name +
+                           "_" + source_obj.name + "-" + target_obj.name);
     }
     const auto& schedule = instance.get_schedule(tr);
     const auto& entry    = schedule.get_entry();
@@ -651,40 +781,42 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
         GRBLinExpr lhs = 0;
         for (const auto& e : instance.const_n().out_edges(v)) {
           if (std::ranges::contains(edges_used_by_train, e)) {
-            lhs += vars["x"](tr, e);
+            lhs += vars.at("x")(tr, e);
           }
         }
         // The entry vertex is only left but not entered
-        model->addConstr(lhs == 1, "entry_vertex_" + tr_object.name + "_" +
-                                       instance.const_n().get_vertex(v).name);
+        this->add_constr(lhs, GRB_EQUAL, 1,
+                         "entry_vertex_" + tr_object.name + "_" +
+                             instance.const_n().get_vertex(v).name);
       } else if (v == exit) {
         GRBLinExpr lhs = 0;
         for (const auto& e : instance.const_n().in_edges(v)) {
           if (std::ranges::contains(edges_used_by_train, e)) {
-            lhs += vars["x"](tr, e);
+            lhs += vars.at("x")(tr, e);
           }
         }
         // The exit vertex is only entered but not left
-        model->addConstr(lhs == 1, "exit_vertex_" + tr_object.name + "_" +
-                                       instance.const_n().get_vertex(v).name);
+        this->add_constr(lhs, GRB_EQUAL, 1,
+                         "exit_vertex_" + tr_object.name + "_" +
+                             instance.const_n().get_vertex(v).name);
       } else {
         GRBLinExpr x_in_edges  = 0;
         GRBLinExpr x_out_edges = 0;
         for (const auto& e : instance.const_n().in_edges(v)) {
           if (std::ranges::contains(edges_used_by_train, e)) {
-            x_in_edges += vars["x"](tr, e);
+            x_in_edges += vars.at("x")(tr, e);
           }
         }
         for (const auto& e : instance.const_n().out_edges(v)) {
           if (std::ranges::contains(edges_used_by_train, e)) {
-            x_out_edges += vars["x"](tr, e);
+            x_out_edges += vars.at("x")(tr, e);
           }
         }
         // All other vertices are entered and left at most once
-        model->addConstr(x_in_edges <= 1,
+        this->add_constr(x_in_edges, GRB_LESS_EQUAL, 1,
                          "in_edges_" + tr_object.name + "_" +
                              instance.const_n().get_vertex(v).name);
-        model->addConstr(x_out_edges <= 1,
+        this->add_constr(x_out_edges, GRB_LESS_EQUAL, 1,
                          "out_edges_" + tr_object.name + "_" +
                              instance.const_n().get_vertex(v).name);
         const auto& v1_values = velocity_extensions.at(tr).at(v);
@@ -709,7 +841,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                                               tr_object.acceleration,
                                               tr_object.deceleration,
                                               edge.length)) {
-                  lhs += vars["y"](tr, e, j, i);
+                  lhs += vars.at("y")(tr, e, j, i);
                 }
               }
             }
@@ -732,13 +864,13 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                                               tr_object.acceleration,
                                               tr_object.deceleration,
                                               edge.length)) {
-                  rhs += vars["y"](tr, e, i, j);
+                  rhs += vars.at("y")(tr, e, i, j);
                 }
               }
             }
           }
           // And they fulfill a flow condition
-          model->addConstr(lhs == rhs,
+          this->add_constr(lhs, GRB_EQUAL, rhs,
                            "vertex_velocity_extension_flow_condition_" +
                                tr_object.name + "_" +
                                instance.const_n().get_vertex(v).name + "_" +
@@ -762,7 +894,8 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
               instance.const_n()
                   .get_vertex(instance.const_n().get_edge(e2).target)
                   .name;
-          model->addConstr(vars["x"](tr, e) + vars["x"](tr, e2) <= 1,
+          this->add_constr(vars.at("x")(tr, e) + vars.at("x")(tr, e2),
+                           GRB_LESS_EQUAL, 1,
                            "illegal_path_" + tr_object.name + "_" + v1_name +
                                "-" + v2_name + "-" + v3_name);
         }
@@ -781,6 +914,11 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
       const auto& v1_values     = velocity_extensions.at(tr).at(edge.source);
       const auto& v2_values     = velocity_extensions.at(tr).at(edge.target);
       const auto  tmp_max_speed = std::min(tr_object.max_speed, edge.max_speed);
+
+      // Travel times of all possible arcs are evaluated as one batch
+      std::vector<std::pair<size_t, size_t>> arcs;
+      std::vector<double>                    arcs_v1;
+      std::vector<double>                    arcs_v2;
       for (size_t i = 0; i < v1_values.size(); i++) {
         if (v1_values.at(i) > tmp_max_speed) {
           continue;
@@ -792,44 +930,57 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
           if (cda_rail::possible_by_eom(v1_values.at(i), v2_values.at(j),
                                         tr_object.acceleration,
                                         tr_object.deceleration, edge.length)) {
-            // t_front_arrival >= t_rear_departure + minimal travel time if arc
-            // is used
-            const auto& min_t_arc = cda_rail::min_travel_time(
-                v1_values.at(i), v2_values.at(j), tmp_max_speed,
-                tr_object.acceleration, tr_object.deceleration, edge.length);
-            const auto& max_t_arc = cda_rail::max_travel_time(
-                v1_values.at(i), v2_values.at(j), V_MIN, tr_object.acceleration,
-                tr_object.deceleration, edge.length, edge.breakable);
-            model->addConstr(
-                vars["t_front_arrival"](tr, edge.target) +
-                        (ub_timing_variable(tr) + min_t_arc) *
-                            (1 - vars["y"](tr, e, i, j)) >=
-                    vars["t_front_departure"](tr, edge.source) + min_t_arc,
-                "edge_minimal_travel_time_" + tr_object.name + "_" +
-                    instance.const_n().get_vertex(edge.source).name + "-" +
-                    instance.const_n().get_vertex(edge.target).name + "_" +
-                    std::to_string(v1_values.at(i)) + "-" +
-                    std::to_string(v2_values.at(j)));
-
-            if (max_t_arc >= std::numeric_limits<double>::infinity()) {
-              continue;
-            }
-
-            // t_front_arrival <= t_rear_departure + maximal travel time if arc
-            // is used
-            model->addConstr(
-                vars["t_front_arrival"](tr, edge.target) <=
-                    vars["t_front_departure"](tr, edge.source) + max_t_arc +
-                        (ub_timing_variable(tr) - max_t_arc) *
-                            (1 - vars["y"](tr, e, i, j)),
-                "edge_maximal_travel_time_" + tr_object.name + "_" +
-                    instance.const_n().get_vertex(edge.source).name + "-" +
-                    instance.const_n().get_vertex(edge.target).name + "_" +
-                    std::to_string(v1_values.at(i)) + "-" +
-                    std::to_string(v2_values.at(j)));
+            arcs.emplace_back(i, j);
+            arcs_v1.emplace_back(v1_values.at(i));
+            arcs_v2.emplace_back(v2_values.at(j));
           }
         }
       }
+      std::vector<double> min_t_arcs(arcs.size());
+      std::vector<double> max_t_arcs(arcs.size());
+      cda_rail::min_travel_time_batch(arcs_v1, arcs_v2, tmp_max_speed,
+                                      tr_object.acceleration,
+                                      tr_object.deceleration, edge.length,
+                                      min_t_arcs);
+      cda_rail::max_travel_time_batch(
+          arcs_v1, arcs_v2, V_MIN, tr_object.acceleration,
+          tr_object.deceleration, edge.length, edge.breakable, max_t_arcs);
+
+      for (size_t k = 0; k < arcs.size(); k++) {
+        const auto& [i, j]    = arcs.at(k);
+        const auto& min_t_arc = min_t_arcs.at(k);
+        const auto& max_t_arc = max_t_arcs.at(k);
+
+        // t_front_arrival >= t_rear_departure + minimal travel time if arc is
+        // used
+        this->add_constr(
+            vars.at("t_front_arrival")(tr, edge.target) +
+                (ub_timing_variable(tr) + min_t_arc) *
+                    (1 - vars.at("y")(tr, e, i, j)), GRB_GREATER_EQUAL,
+            vars.at("t_front_departure")(tr, edge.source) + min_t_arc,
+            "edge_minimal_travel_time_" + tr_object.name + "_" +
+                instance.const_n().get_vertex(edge.source).name + "-" +
+                instance.const_n().get_vertex(edge.target).name + "_" +
+                std::to_string(v1_values.at(i)) + "-" +
+                std::to_string(v2_values.at(j)));
+
+        if (max_t_arc >= std::numeric_limits<double>::infinity()) {
+          continue;
+        }
+
+        // t_front_arrival <= t_rear_departure + maximal travel time if arc is
+        // used
+        this->add_constr(
+            vars.at("t_front_arrival")(tr, edge.target), GRB_LESS_EQUAL,
+            vars.at("t_front_departure")(tr, edge.source) + max_t_arc +
+                (ub_timing_variable(tr) - max_t_arc) *
+                    (1 - vars.at("y")(tr, e, i, j)),
+            "edge_maximal_travel_time_" + tr_object.name + "_" +
+                instance.const_n().get_vertex(edge.source).name + "-" +
+                instance.const_n().get_vertex(edge.target).name + "_" +
+                std::to_string(v1_values.at(i)) + "-" +
+                std::to_string(v2_values.at(j)));
+      }
     }
 
     const auto e_used_tr =
@@ -837,8 +988,8 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     for (const auto& v :
          instance.vertices_used_by_train(tr, model_detail.fix_routes, false)) {
       // t_front_departure >= t_front_arrival
-      model->addConstr(vars["t_front_departure"](tr, v) >=
-                           vars["t_front_arrival"](tr, v),
+      this->add_constr(vars.at("t_front_departure")(tr, v), GRB_GREATER_EQUAL,
+                       vars.at("t_front_arrival")(tr, v),
                        "tr_dep_after_arrival_" + tr_object.name + "_" +
                            instance.const_n().get_vertex(v).name);
 
@@ -864,7 +1015,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             if (cda_rail::possible_by_eom(
                     v1_velocities.at(i), 0, tr_object.acceleration,
                     tr_object.deceleration, e_in_object.length)) {
-              speed_0_arcs += vars["y"](tr, e_in, i, 0);
+              speed_0_arcs += vars.at("y")(tr, e_in, i, 0);
             }
           }
         }
@@ -884,14 +1035,14 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             if (cda_rail::possible_by_eom(
                     0, v2_velocities.at(i), tr_object.acceleration,
                     tr_object.deceleration, e_out_object.length)) {
-              speed_0_arcs += vars["y"](tr, e_out, 0, i);
+              speed_0_arcs += vars.at("y")(tr, e_out, 0, i);
             }
           }
         }
       }
-      model->addConstr(vars["t_front_departure"](tr, v) <=
-                           vars["t_front_arrival"](tr, v) +
-                               ub_timing_variable(tr) * speed_0_arcs,
+      this->add_constr(vars.at("t_front_departure")(tr, v), GRB_LESS_EQUAL,
+                       vars.at("t_front_arrival")(tr, v) +
+                           ub_timing_variable(tr) * speed_0_arcs,
                        "tr_might_stop_at_vertex_" + tr_object.name + "_" +
                            instance.const_n().get_vertex(v).name);
     }
@@ -918,16 +1069,16 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
           continue;
         }
 
-        model->addConstr(
-            vars["order"](tr1, tr2, e) + vars["order"](tr2, tr1, e) <=
-                0.5 * (vars["x"](tr1, e) + vars["x"](tr2, e)),
+        this->add_constr(
+            vars.at("order")(tr1, tr2, e) + vars.at("order")(tr2, tr1, e),
+            GRB_LESS_EQUAL, 0.5 * (vars.at("x")(tr1, e) + vars.at("x")(tr2, e)),
             "edge_order_1_" + instance.get_train_list().get_train(tr1).name +
                 "_" + instance.get_train_list().get_train(tr2).name + "_" +
                 v1.name + "-" + v2.name);
 
-        model->addConstr(
-            vars["order"](tr1, tr2, e) + vars["order"](tr2, tr1, e) >=
-                vars["x"](tr1, e) + vars["x"](tr2, e) - 1,
+        this->add_constr(
+            vars.at("order")(tr1, tr2, e) + vars.at("order")(tr2, tr1, e),
+            GRB_GREATER_EQUAL, vars.at("x")(tr1, e) + vars.at("x")(tr2, e) - 1,
             "edge_order_2_" + instance.get_train_list().get_train(tr1).name +
                 "_" + instance.get_train_list().get_train(tr2).name + "_" +
                 v1.name + "-" + v2.name);
@@ -998,9 +1149,9 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                         tr_object.acceleration, tr_object.deceleration,
                         e_in_object.length)) {
                   min_travel_time_expr +=
-                      vars["y"](tr, e_in, j, i) * min_t_to_full_exit;
+                      vars.at("y")(tr, e_in, j, i) * min_t_to_full_exit;
                   max_travel_time_expr +=
-                      vars["y"](tr, e_in, j, i) * max_t_to_full_exit;
+                      vars.at("y")(tr, e_in, j, i) * max_t_to_full_exit;
                 }
               }
             }
@@ -1025,8 +1176,8 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                         v1_velocities.at(j), v_exit_velocity,
                         tr_object.acceleration, tr_object.deceleration,
                         e_in_object.length)) {
-                  model->addConstr(
-                      vars["y"](tr, e_in, j, i) == 0,
+                  this->add_constr(
+                      vars.at("y")(tr, e_in, j, i), GRB_EQUAL, 0,
                       "y_exit_velocity_" + std::to_string(v_exit_velocity) +
                           "_not_possible_from_" +
                           std::to_string(v1_velocities.at(j)) + "_at_" +
@@ -1036,14 +1187,14 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             }
           }
         }
-        model->addConstr(vars["t_rear_departure"](tr, v) >=
-                             vars["t_front_departure"](tr, v) +
-                                 min_travel_time_expr,
+        this->add_constr(vars.at("t_rear_departure")(tr, v), GRB_GREATER_EQUAL,
+                         vars.at("t_front_departure")(tr, v) +
+                             min_travel_time_expr,
                          "rear_departure_vertex_c1_" + tr_object.name + "_" +
                              instance.const_n().get_vertex(v).name);
-        model->addConstr(vars["t_rear_departure"](tr, v) <=
-                             vars["t_front_departure"](tr, v) +
-                                 max_travel_time_expr,
+        this->add_constr(vars.at("t_rear_departure")(tr, v), GRB_LESS_EQUAL,
+                         vars.at("t_front_departure")(tr, v) +
+                             max_travel_time_expr,
                          "rear_departure_vertex_c2_" + tr_object.name + "_" +
                              instance.const_n()
                                  .get_vertex(v)
@@ -1066,10 +1217,10 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
           const auto& last_edge     = p.back();
           const auto& last_edge_obj = instance.const_n().get_edge(last_edge);
 
-          GRBLinExpr lhs = vars["t_rear_departure"](tr, v) +
+          GRBLinExpr lhs = vars.at("t_rear_departure")(tr, v) +
                            M * static_cast<double>(p.size());
           for (const auto& e_p : p) {
-            lhs -= M * vars["x"](tr, e_p);
+            lhs -= M * vars.at("x")(tr, e_p);
           }
 
           if (last_edge_obj.target == exit &&
@@ -1120,22 +1271,23 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                           v1_velocities.at(j), v_exit_velocity,
                           tr_object.acceleration, tr_object.deceleration,
                           last_edge_obj.length)) {
-                    min_travel_time_expr +=
-                        vars["y"](tr, last_edge, j, i) * min_t_to_required_pos;
-                    max_travel_time_expr +=
-                        vars["y"](tr, last_edge, j, i) * max_t_to_required_pos;
+                    min_travel_time_expr += vars.at("y")(tr, last_edge, j, i) *
+                                            min_t_to_required_pos;
+                    max_travel_time_expr += vars.at("y")(tr, last_edge, j, i) *
+                                            max_t_to_required_pos;
                   }
                 }
               }
             }
 
-            model->addConstr(lhs >= vars["t_front_departure"](tr, exit) +
-                                        min_travel_time_expr,
+            this->add_constr(lhs, GRB_GREATER_EQUAL,
+                             vars.at("t_front_departure")(tr, exit) +
+                                 min_travel_time_expr,
                              "rear_departure_half_leaving_1_" + tr_object.name +
                                  "_" + instance.const_n().get_vertex(v).name +
                                  "_" + std::to_string(p_ind));
             // Removed one constraint since t_rear is pushed down anyway
-            /**model->addConstr(lhs - bigM <= vars["t_front_departure"](tr,
+            /**this->add_constr(lhs - bigM <= vars.at("t_front_departure")(tr,
                exit) + max_travel_time_expr, "rear_departure_half_leaving_2_" +
                tr_object.name +
                                  "_" + instance.const_n().get_vertex(v).name +
@@ -1154,8 +1306,9 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
             if (rel_pt_on_edge + 1e-6 >= last_edge_obj.length) {
               // Directly use corresponding variable
-              model->addConstr(
-                  lhs >= vars["t_front_departure"](tr, last_edge_obj.target),
+              this->add_constr(
+                  lhs, GRB_GREATER_EQUAL,
+                  vars.at("t_front_departure")(tr, last_edge_obj.target),
                   "rear_departure_2_" + tr_object.name + "_" +
                       instance.const_n().get_vertex(v).name + "_" +
                       std::to_string(p_ind));
@@ -1163,9 +1316,9 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
               // Only in this case there is no corresponding variable. Note that
               // objective pushes rear departure down.
               GRBLinExpr t_ref_1 =
-                  vars["t_front_departure"](tr, last_edge_obj.source);
+                  vars.at("t_front_departure")(tr, last_edge_obj.source);
               GRBLinExpr t_ref_2 =
-                  vars["t_front_arrival"](tr, last_edge_obj.target);
+                  vars.at("t_front_arrival")(tr, last_edge_obj.target);
               const auto v_max_rel_e =
                   std::min(last_edge_obj.max_speed, tr_object.max_speed);
               for (size_t i = 0; i < v_0_velocities.size(); i++) {
@@ -1180,7 +1333,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                           v_0_velocities.at(i), v_1_velocities.at(j),
                           tr_object.acceleration, tr_object.deceleration,
                           last_edge_obj.length)) {
-                    t_ref_1 += vars["y"](tr, last_edge, i, j) *
+                    t_ref_1 += vars.at("y")(tr, last_edge, i, j) *
                                cda_rail::min_travel_time_from_start(
                                    v_0_velocities.at(i), v_1_velocities.at(j),
                                    v_max_rel_e, tr_object.acceleration,
@@ -1192,7 +1345,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                             tr_object.acceleration, tr_object.deceleration,
                             last_edge_obj.length, rel_pt_on_edge,
                             last_edge_obj.breakable);
-                    t_ref_2 -= vars["y"](tr, last_edge, i, j) *
+                    t_ref_2 -= vars.at("y")(tr, last_edge, i, j) *
                                (max_travel_time >=
                                         std::numeric_limits<double>::infinity()
                                     ? M
@@ -1201,11 +1354,11 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                 }
               }
 
-              model->addConstr(lhs >= t_ref_1,
+              this->add_constr(lhs, GRB_GREATER_EQUAL, t_ref_1,
                                "rear_departure_1_" + tr_object.name + "_" +
                                    instance.const_n().get_vertex(v).name + "_" +
                                    std::to_string(p_ind));
-              model->addConstr(lhs >= t_ref_2,
+              this->add_constr(lhs, GRB_GREATER_EQUAL, t_ref_2,
                                "rear_departure_2_" + tr_object.name + "_" +
                                    instance.const_n().get_vertex(v).name + "_" +
                                    std::to_string(p_ind));
@@ -1237,24 +1390,25 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
         // If stopped then t_front_departure - t_front_arrival >= stop_time,
         // otherwise unconstrained Hence, >= stop_time * stop
-        model->addConstr(
-            vars["t_front_departure"](tr, v) - vars["t_front_arrival"](tr, v) >=
-                stop_object.get_min_stopping_time() * vars["stop"](tr, stop, v),
+        this->add_constr(
+            vars["t_front_departure"](tr, v) - vars["t_front_arrival"](tr, v),
+            GRB_GREATER_EQUAL,
+            stop_object.get_min_stopping_time() * vars["stop"](tr, stop, v),
             "min_stop_time_" + tr_object.name + "_" + stop_station_name +
                 "_vertex_" + instance.const_n().get_vertex(v).name);
 
         // If stopped then t_front_arrival is within desired arrival interval
         const auto t_0_interval = stop_object.get_begin_range();
         // t >= t_0 * stop
-        model->addConstr(vars["t_front_arrival"](tr, v) >=
-                             t_0_interval.first * vars["stop"](tr, stop, v),
+        this->add_constr(vars["t_front_arrival"](tr, v), GRB_GREATER_EQUAL,
+                         t_0_interval.first * vars["stop"](tr, stop, v),
                          "min_arrival_time_" + tr_object.name + "_" +
                              stop_station_name + "_vertex_" +
                              instance.const_n().get_vertex(v).name);
         // t <= t_0 + M * (1 - stop)
-        model->addConstr(
-            vars["t_front_arrival"](tr, v) <=
-                t_0_interval.second + M * (1 - vars["stop"](tr, stop, v)),
+        this->add_constr(
+            vars["t_front_arrival"](tr, v), GRB_LESS_EQUAL,
+            t_0_interval.second + M * (1 - vars["stop"](tr, stop, v)),
             "max_arrival_time_" + tr_object.name + "_" + stop_station_name +
                 "_vertex_" + instance.const_n().get_vertex(v).name);
 
@@ -1262,15 +1416,15 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
         // interval
         const auto t_n_interval = stop_object.get_end_range();
         // t >= t_n * stop
-        model->addConstr(vars["t_front_departure"](tr, v) >=
-                             t_n_interval.first * vars["stop"](tr, stop, v),
+        this->add_constr(vars["t_front_departure"](tr, v), GRB_GREATER_EQUAL,
+                         t_n_interval.first * vars["stop"](tr, stop, v),
                          "min_departure_time_" + tr_object.name + "_" +
                              stop_station_name + "_vertex_" +
                              instance.const_n().get_vertex(v).name);
         // t <= t_n + M * (1 - stop)
-        model->addConstr(
-            vars["t_front_departure"](tr, v) <=
-                t_n_interval.second + M * (1 - vars["stop"](tr, stop, v)),
+        this->add_constr(
+            vars["t_front_departure"](tr, v), GRB_LESS_EQUAL,
+            t_n_interval.second + M * (1 - vars["stop"](tr, stop, v)),
             "max_departure_time_" + tr_object.name + "_" + stop_station_name +
                 "_vertex_" + instance.const_n().get_vertex(v).name);
 
@@ -1287,25 +1441,26 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                   "_path_" + std::to_string(p_index));
           path_expr += tmp_var;
           for (const auto& e : p) {
-            model->addConstr(tmp_var <= vars["x"](tr, e),
+            this->add_constr(tmp_var, GRB_LESS_EQUAL, vars["x"](tr, e),
                              "stop_path_" + tr_object.name + "_" +
                                  stop_station_name + "_vertex_" +
                                  instance.const_n().get_vertex(v).name +
                                  "_path_" + std::to_string(p_index) + "_edge_" +
                                  std::to_string(e));
           }
-          model->addConstr(vars["stop"](tr, stop, v) >= tmp_var,
+          this->add_constr(vars["stop"](tr, stop, v), GRB_GREATER_EQUAL,
+                           tmp_var,
                            "use_path_only_if_stopped_" + tr_object.name + "_" +
                                stop_station_name + "_vertex_" +
                                instance.const_n().get_vertex(v).name +
                                "_path_" + std::to_string(p_index));
         }
-        model->addConstr(vars["stop"](tr, stop, v) <= path_expr,
+        this->add_constr(vars["stop"](tr, stop, v), GRB_LESS_EQUAL, path_expr,
                          "stop_only_if_path_is_used_" + tr_object.name + "_" +
                              stop_station_name + "_vertex_" +
                              instance.const_n().get_vertex(v).name);
       }
-      model->addConstr(lhs == 1,
+      this->add_constr(lhs, GRB_EQUAL, 1,
                        "stop_at_one_vertex_" +
                            instance.get_train_list().get_train(tr).name + "_" +
                            stop_station_name);
@@ -1313,20 +1468,20 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
     // Initial
     const auto& t0_range = tr_schedule.get_t_0_range();
-    model->addConstr(vars["t_front_arrival"](tr, tr_schedule.get_entry()) >=
-                         t0_range.first,
+    this->add_constr(vars["t_front_arrival"](tr, tr_schedule.get_entry()),
+                     GRB_GREATER_EQUAL, t0_range.first,
                      "initial_arrival_time_lb_" + tr_object.name);
-    model->addConstr(vars["t_front_arrival"](tr, tr_schedule.get_entry()) <=
-                         t0_range.second,
+    this->add_constr(vars["t_front_arrival"](tr, tr_schedule.get_entry()),
+                     GRB_LESS_EQUAL, t0_range.second,
                      "initial_arrival_time_ub_" + tr_object.name);
 
     // Final
     const auto& tn_range = tr_schedule.get_t_n_range();
-    model->addConstr(vars["t_rear_departure"](tr, tr_schedule.get_exit()) >=
-                         tn_range.first,
+    this->add_constr(vars["t_rear_departure"](tr, tr_schedule.get_exit()),
+                     GRB_GREATER_EQUAL, tn_range.first,
                      "final_departure_time_lb_" + tr_object.name);
-    model->addConstr(vars["t_rear_departure"](tr, tr_schedule.get_exit()) <=
-                         tn_range.second,
+    this->add_constr(vars["t_rear_departure"](tr, tr_schedule.get_exit()),
+                     GRB_LESS_EQUAL, tn_range.second,
                      "final_departure_time_ub_" + tr_object.name);
   }
 }
@@ -1386,16 +1541,16 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             const auto t_bound_tmp = std::max(t_bound, ub_timing_variable(tr2));
 
             const GRBLinExpr lhs =
-                vars["t_front_arrival"](tr, v) +
+                vars.at("t_front_arrival")(tr, v) +
                 t_bound_tmp * (static_cast<double>(p.size()) - edge_path_expr) +
-                t_bound_tmp * (1 - vars["order"](tr, tr2, p.back()));
+                t_bound_tmp * (1 - vars.at("order")(tr, tr2, p.back()));
             std::vector<GRBLinExpr> rhs;
             if (p_len + EPS >= bd && p_len - EPS <= bd) {
               // Target vertex is exactly the desired moving authority
               // t_front_departure(tr, v) >= t_rear_departure(tr2, target) if
               // order(tr, tr2, e) = 1 and path p chosen.
               rhs.emplace_back(
-                  vars["t_rear_departure"](tr2, last_edge_object.target));
+                  vars.at("t_rear_departure")(tr2, last_edge_object.target));
             } else {
               assert(p_len > bd && p_len - last_edge_object.length <= bd);
               const auto  target_point = bd - p_len + last_edge_object.length;
@@ -1404,9 +1559,9 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
               const auto& v_tr2_target_velocities =
                   velocity_extensions.at(tr2).at(last_edge_object.target);
               rhs.emplace_back(
-                  vars["t_rear_departure"](tr2, last_edge_object.source));
+                  vars.at("t_rear_departure")(tr2, last_edge_object.source));
               rhs.emplace_back(
-                  vars["t_rear_departure"](tr2, last_edge_object.target));
+                  vars.at("t_rear_departure")(tr2, last_edge_object.target));
               const auto& tr2_object = instance.get_train_list().get_train(tr2);
               const auto  max_speed =
                   std::min(tr2_object.max_speed, last_edge_object.max_speed);
@@ -1433,8 +1588,8 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                     // first: += y * min_t
                     // second: -= y * max_t
                     rhs.at(0) +=
-                        vars["y"](tr2, p.back(), v_tr2_source_index,
-                                  v_tr2_target_index) *
+                        vars.at("y")(tr2, p.back(), v_tr2_source_index,
+                                     v_tr2_target_index) *
                         cda_rail::min_travel_time_from_start(
                             vel_tr2_source, vel_tr2_target, max_speed,
                             tr2_object.acceleration, tr2_object.deceleration,
@@ -1446,8 +1601,8 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                             last_edge_object.length, target_point,
                             last_edge_object.breakable);
                     rhs.at(1) -=
-                        vars["y"](tr2, p.back(), v_tr2_source_index,
-                                  v_tr2_target_index) *
+                        vars.at("y")(tr2, p.back(), v_tr2_source_index,
+                                     v_tr2_target_index) *
                         (max_travel_time > t_bound_tmp ? t_bound_tmp
                                                        : max_travel_time);
                   }
@@ -1455,8 +1610,8 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
               }
             }
             for (size_t rhs_idx = 0; rhs_idx < rhs.size(); rhs_idx++) {
-              model->addConstr(
-                  lhs >= rhs.at(rhs_idx),
+              this->add_constr(
+                  lhs, GRB_GREATER_EQUAL, rhs.at(rhs_idx),
                   "headway_" + std::to_string(rhs_idx) + "-" +
                       std::to_string(rhs.size()) + "_" + tr_object.name + "_" +
                       instance.get_train_list().get_train(tr2).name + "_" +
@@ -1478,7 +1633,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                 });
             GRBLinExpr edge_tmp_path_expr = 0;
             for (const auto& e_tmp : p_tmp) {
-              edge_tmp_path_expr += vars["x"](tr, e_tmp);
+              edge_tmp_path_expr += vars.at("x")(tr, e_tmp);
             }
 
             const auto obd = bd - p_tmp_len;
@@ -1496,12 +1651,12 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                   std::max(t_bound, ub_timing_variable(tr2));
 
               GRBLinExpr lhs_from_rear =
-                  vars["t_front_arrival"](tr, v) +
+                  vars.at("t_front_arrival")(tr, v) +
                   t_bound_tmp *
                       (static_cast<double>(p_tmp.size()) - edge_tmp_path_expr);
               const GRBLinExpr rhs =
-                  vars["t_ttd_departure"](tr2, ttd_index) +
-                  t_bound_tmp * (vars["order_ttd"](tr, tr2, ttd_index) - 1);
+                  vars.at("t_ttd_departure")(tr2, ttd_index) +
+                  t_bound_tmp * (vars.at("order_ttd")(tr, tr2, ttd_index) - 1);
 
               bool is_relevant = obd < GRB_EPS;
 
@@ -1550,8 +1705,8 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                               vel_before_v, vel, tr_object.acceleration,
                               tr_object.deceleration, e_before_v_obj.length)) {
                         lhs_from_rear -=
-                            vars["y"](tr, e_before_v, v_before_v_index,
-                                      v_source_index) *
+                            vars.at("y")(tr, e_before_v, v_before_v_index,
+                                         v_source_index) *
                             cda_rail::min_time_from_rear_to_ma_point(
                                 vel_before_v, vel, V_MIN, e_before_v_tmp_max,
                                 tr_object.acceleration, tr_object.deceleration,
@@ -1565,15 +1720,16 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                                 e_before_v_obj.length, obd,
                                 e_before_v_obj.breakable);
                         const GRBLinExpr lhs_from_front =
-                            vars["t_front_departure"](tr, v_before_v) +
+                            vars.at("t_front_departure")(tr, v_before_v) +
                             std::min(max_from_front, t_bound_tmp) +
                             t_bound_tmp *
                                 (static_cast<double>(p_tmp.size()) + 1 -
-                                 vars["y"](tr, e_before_v, v_before_v_index,
-                                           v_source_index) -
+                                 vars.at("y")(tr, e_before_v,
+                                              v_before_v_index,
+                                              v_source_index) -
                                  edge_tmp_path_expr);
-                        model->addConstr(
-                            lhs_from_front >= rhs,
+                        this->add_constr(
+                            lhs_from_front, GRB_GREATER_EQUAL, rhs,
                             "headway_ttd_" + std::to_string(ttd_index) +
                                 "from_front_" + tr_object.name + "_" +
                                 instance.get_train_list().get_train(tr2).name +
@@ -1588,8 +1744,8 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
                 }
               }
               if (is_relevant) {
-                model->addConstr(
-                    lhs_from_rear >= rhs,
+                this->add_constr(
+                    lhs_from_rear, GRB_GREATER_EQUAL, rhs,
                     "headway_ttd_" + tr_object.name + "_" +
                         instance.get_train_list().get_train(tr2).name + "_" +
                         instance.const_n().get_vertex(v).name + "_" +
@@ -1629,7 +1785,7 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
       // departure because ma might move forward, otherwise arrival and
       // departure are equal due to non-zero velocity
       // NOLINTNEXTLINE(misc-const-correctness)
-      GRBVar tr_t_var = vars["t_front_departure"](tr, v_source);
+      GRBVar tr_t_var = vars.at("t_front_departure")(tr, v_source);
 
       const auto tr_on_e = instance.trains_on_edge_mixed_routing(
           e, model_detail.fix_routes, false);
@@ -1638,12 +1794,13 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
           continue;
         }
         const auto t_bound_tmp = std::max(t_bound, ub_timing_variable(tr2));
-        const auto tr2_t_var   = vars["t_rear_departure"](tr2, v_target);
+        const auto tr2_t_var   = vars.at("t_rear_departure")(tr2, v_target);
 
-        model->addConstr(
+        this->add_constr(
             tr_t_var - tr2_t_var +
-                    (t_bound_tmp + hw_max) * (1 - vars["order"](tr, tr2, e)) >=
-                headway_tr_on_e,
+                (t_bound_tmp + hw_max) *
+                    (1 - vars.at("order")(tr, tr2, e)), GRB_GREATER_EQUAL,
+            headway_tr_on_e,
             "headway_simplified_" + tr_object.name + "_" +
                 instance.get_train_list().get_train(tr2).name + "_" +
                 v_source_object.name + "_" + v_target_object.name);
@@ -1672,12 +1829,12 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
               continue;
             }
             const auto t_bound_tmp = std::max(t_bound, ub_timing_variable(tr2));
-            const auto tr2_t_var   = vars["t_ttd_departure"](tr2, ttd_index);
-            model->addConstr(
+            const auto tr2_t_var   = vars.at("t_ttd_departure")(tr2, ttd_index);
+            this->add_constr(
                 tr_t_var - tr2_t_var +
-                        (t_bound_tmp + hw_max_ttd) *
-                            (1 - vars["order_ttd"](tr, tr2, ttd_index)) >=
-                    headway_tr_on_ttd,
+                    (t_bound_tmp + hw_max_ttd) *
+                        (1 - vars.at("order_ttd")(tr, tr2, ttd_index)),
+                GRB_GREATER_EQUAL, headway_tr_on_ttd,
                 "headway_simplified_ttd_" + tr_object.name + "_" +
                     instance.get_train_list().get_train(tr2).name + "_" +
                     v_source_object.name + "_" + v_target_object.name + "_ttd" +
@@ -1718,12 +1875,13 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
             instance.const_n().get_vertex(e_object.source).name;
         const auto v2_name =
             instance.const_n().get_vertex(e_object.target).name;
-        model->addConstr(vars["x_ttd"](tr, i) >= vars["x"](tr, e),
+        this->add_constr(vars.at("x_ttd")(tr, i), GRB_GREATER_EQUAL,
+                         vars.at("x")(tr, e),
                          "aggregate_edge_ttd_1_" +
                              instance.get_train_list().get_train(tr).name +
                              "_" + std::to_string(i) + "_" + v1_name + "-" +
                              v2_name);
-        rhs += vars["x"](tr, e);
+        rhs += vars.at("x")(tr, e);
 
         // Moreover bound t_ttd_departure
         // >= t_rear_departure(v2) * x(e)
@@ -1734,15 +1892,15 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
         // t_ttd >= 0 (already by definition)
         // Because we are only interested in bounding the time from below no
         // other constraints are needed.
-        model->addConstr(vars["t_ttd_departure"](tr, i) >=
-                             vars["t_rear_departure"](tr, e_object.target) -
-                                 t_bound * (1 - vars["x"](tr, e)),
+        this->add_constr(vars.at("t_ttd_departure")(tr, i), GRB_GREATER_EQUAL,
+                         vars.at("t_rear_departure")(tr, e_object.target) -
+                             t_bound * (1 - vars.at("x")(tr, e)),
                          "ttd_departure_bound_" +
                              instance.get_train_list().get_train(tr).name +
                              "_" + std::to_string(i) + "_" + v1_name + "-" +
                              v2_name);
       }
-      model->addConstr(vars["x_ttd"](tr, i) <= rhs,
+      this->add_constr(vars.at("x_ttd")(tr, i), GRB_LESS_EQUAL, rhs,
                        "aggregate_edge_ttd_2_" +
                            instance.get_train_list().get_train(tr).name + "_" +
                            std::to_string(i));
@@ -1754,30 +1912,32 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
         const auto& tr2_name    = instance.get_train_list().get_train(tr2).name;
 
         // Order constraints as usual
-        model->addConstr(
-            vars["order_ttd"](tr, tr2, i) + vars["order_ttd"](tr2, tr, i) <=
-                0.5 * (vars["x_ttd"](tr, i) + vars["x_ttd"](tr2, i)),
+        this->add_constr(
+            vars.at("order_ttd")(tr, tr2, i) +
+                vars.at("order_ttd")(tr2, tr, i), GRB_LESS_EQUAL,
+            0.5 * (vars.at("x_ttd")(tr, i) + vars.at("x_ttd")(tr2, i)),
             "ttd_order_1_" + tr_name + "_" + tr2_name + "_" +
                 std::to_string(i));
-        model->addConstr(vars["order_ttd"](tr, tr2, i) +
-                                 vars["order_ttd"](tr2, tr, i) >=
-                             vars["x_ttd"](tr, i) - vars["x_ttd"](tr2, i) - 1,
-                         "ttd_order_2_" + tr_name + "_" + tr2_name + "_" +
-                             std::to_string(i));
+        this->add_constr(
+            vars.at("order_ttd")(tr, tr2, i) +
+                vars.at("order_ttd")(tr2, tr, i), GRB_GREATER_EQUAL,
+            vars.at("x_ttd")(tr, i) - vars.at("x_ttd")(tr2, i) - 1,
+            "ttd_order_2_" + tr_name + "_" + tr2_name + "_" +
+                std::to_string(i));
 
         // If tr1 follows tr2 then t_ttd_departure(tr1) >= t_ttd_departure(tr2)
-        model->addConstr(vars["t_ttd_departure"](tr, i) +
-                                 t_bound_tmp *
-                                     (1 - vars["order_ttd"](tr, tr2, i)) >=
-                             vars["t_ttd_departure"](tr2, i),
+        this->add_constr(vars.at("t_ttd_departure")(tr, i) +
+                             t_bound_tmp *
+                                 (1 - vars.at("order_ttd")(tr, tr2, i)),
+                         GRB_GREATER_EQUAL, vars.at("t_ttd_departure")(tr2, i),
                          "ttd_order_3_time_" + tr_name + "_" + tr2_name + "_" +
                              std::to_string(i));
 
         // If tr2 follows tr1 then t_ttd_departure(tr2) >= t_ttd_departure(tr1)
-        model->addConstr(vars["t_ttd_departure"](tr2, i) +
-                                 t_bound_tmp *
-                                     (1 - vars["order_ttd"](tr2, tr, i)) >=
-                             vars["t_ttd_departure"](tr, i),
+        this->add_constr(vars.at("t_ttd_departure")(tr2, i) +
+                             t_bound_tmp *
+                                 (1 - vars.at("order_ttd")(tr2, tr, i)),
+                         GRB_GREATER_EQUAL, vars.at("t_ttd_departure")(tr, i),
                          "ttd_order_4_time_" + tr2_name + "_" + tr_name + "_" +
                              std::to_string(i));
       }
@@ -1808,32 +1968,33 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
         const auto& tr2_name = instance.get_train_list().get_train(tr2).name;
         const auto  ub_val_2 = ub_timing_variable(tr2);
         const auto  t_bound  = std::max(ub_val_1, ub_val_2);
-        model->addConstr(vars["reverse_order"](tr1, tr2, idx) +
-                                 vars["reverse_order"](tr2, tr1, idx) >=
-                             vars["x"](tr1, e1) + vars["x"](tr2, e2) - 1,
+        this->add_constr(vars.at("reverse_order")(tr1, tr2, idx) +
+                             vars.at("reverse_order")(tr2, tr1, idx),
+                         GRB_GREATER_EQUAL,
+                         vars.at("x")(tr1, e1) + vars.at("x")(tr2, e2) - 1,
                          "reverse_order_lb_" + tr1_name + "_" + tr2_name + "_" +
                              v1_name + "-" + v2_name);
-        model->addConstr(vars["reverse_order"](tr1, tr2, idx) +
-                                 vars["reverse_order"](tr2, tr1, idx) <=
-                             1,
+        this->add_constr(vars.at("reverse_order")(tr1, tr2, idx) +
+                             vars.at("reverse_order")(tr2, tr1, idx),
+                         GRB_LESS_EQUAL, 1,
                          "reverse_order_ub_" + tr1_name + "_" + tr2_name + "_" +
                              v1_name + "-" + v2_name);
 
         // If tr1 follows tr2 then front of tr1 >= rear of tr2 at source vertex
         // (of e1)
-        model->addConstr(
-            vars["t_front_arrival"](tr1, e_obj.source) +
-                    t_bound * (1 - vars["reverse_order"](tr1, tr2, idx)) >=
-                vars["t_rear_departure"](tr2, e_obj.source),
+        this->add_constr(
+            vars.at("t_front_arrival")(tr1, e_obj.source) +
+                t_bound * (1 - vars.at("reverse_order")(tr1, tr2, idx)),
+            GRB_GREATER_EQUAL, vars.at("t_rear_departure")(tr2, e_obj.source),
             "reverse_order_1_" + tr1_name + "_" + tr2_name + "_" + v1_name +
                 "-" + v2_name);
 
         // If tr2 follows tr1 then front of tr2 >= rear of tr1 at source vertex
         // of e2, hence, target vertex of e1
-        model->addConstr(
-            vars["t_front_arrival"](tr2, e_obj.target) +
-                    t_bound * (1 - vars["reverse_order"](tr2, tr1, idx)) >=
-                vars["t_rear_departure"](tr1, e_obj.target),
+        this->add_constr(
+            vars.at("t_front_arrival")(tr2, e_obj.target) +
+                t_bound * (1 - vars.at("reverse_order")(tr2, tr1, idx)),
+            GRB_GREATER_EQUAL, vars.at("t_rear_departure")(tr1, e_obj.target),
             "reverse_order_2_" + tr2_name + "_" + tr1_name + "_" + v1_name +
                 "-" + v2_name);
       }
@@ -1877,31 +2038,35 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
 
         // Add headway constraints to both source and target vertices depending
         // on train order
-        model->addConstr(vars["t_front_arrival"](tr1, source_v) +
-                                 (t_bound + hw_s1_max) *
-                                     (1 - vars["order"](tr1, tr2, e)) >=
-                             vars["t_rear_departure"](tr2, source_v) + hw_s1,
+        this->add_constr(vars.at("t_front_arrival")(tr1, source_v) +
+                             (t_bound + hw_s1_max) *
+                                 (1 - vars.at("order")(tr1, tr2, e)),
+                         GRB_GREATER_EQUAL,
+                         vars.at("t_rear_departure")(tr2, source_v) + hw_s1,
                          "headway_vertex_source_1_" + tr1_object.name + "_" +
                              tr2_object.name + "_" + source_v_object.name +
                              "-" + target_v_object.name);
-        model->addConstr(vars["t_front_arrival"](tr2, source_v) +
-                                 (t_bound + hw_s2_max) *
-                                     (1 - vars["order"](tr2, tr1, e)) >=
-                             vars["t_rear_departure"](tr1, source_v) + hw_s2,
+        this->add_constr(vars.at("t_front_arrival")(tr2, source_v) +
+                             (t_bound + hw_s2_max) *
+                                 (1 - vars.at("order")(tr2, tr1, e)),
+                         GRB_GREATER_EQUAL,
+                         vars.at("t_rear_departure")(tr1, source_v) + hw_s2,
                          "headway_vertex_source_2_" + tr1_object.name + "_" +
                              tr2_object.name + "_" + source_v_object.name +
                              "-" + target_v_object.name);
-        model->addConstr(vars["t_front_arrival"](tr1, target_v) +
-                                 (t_bound + hw_t1_max) *
-                                     (1 - vars["order"](tr1, tr2, e)) >=
-                             vars["t_rear_departure"](tr2, target_v) + hw_t1,
+        this->add_constr(vars.at("t_front_arrival")(tr1, target_v) +
+                             (t_bound + hw_t1_max) *
+                                 (1 - vars.at("order")(tr1, tr2, e)),
+                         GRB_GREATER_EQUAL,
+                         vars.at("t_rear_departure")(tr2, target_v) + hw_t1,
                          "headway_vertex_target_1_" + tr1_object.name + "_" +
                              tr2_object.name + "_" + source_v_object.name +
                              "-" + target_v_object.name);
-        model->addConstr(vars["t_front_arrival"](tr2, target_v) +
-                                 (t_bound + hw_t2_max) *
-                                     (1 - vars["order"](tr2, tr1, e)) >=
-                             vars["t_rear_departure"](tr1, target_v) + hw_t2,
+        this->add_constr(vars.at("t_front_arrival")(tr2, target_v) +
+                             (t_bound + hw_t2_max) *
+                                 (1 - vars.at("order")(tr2, tr1, e)),
+                         GRB_GREATER_EQUAL,
+                         vars.at("t_rear_departure")(tr1, target_v) + hw_t2,
                          "headway_vertex_target_2_" + tr1_object.name + "_" +
                              tr2_object.name + "_" + source_v_object.name +
                              "-" + target_v_object.name);
@@ -1910,6 +2075,33 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
   }
 }
 
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    create_symmetry_breaking_constraints() {
+  /**
+   * Exchanging two interchangeable trains maps every solution to a solution
+   * with the same objective. Hence, it can be assumed that within every group
+   * of interchangeable trains, a train with a smaller index does not enter
+   * after a train with a larger index.
+   */
+
+  for (const auto& group : instance.get_symmetric_train_groups()) {
+    const auto  entry      = instance.get_schedule(group.front()).get_entry();
+    const auto& entry_name = instance.const_n().get_vertex(entry).name;
+    for (size_t i = 1; i < group.size(); i++) {
+      const auto  tr1      = group.at(i - 1);
+      const auto  tr2      = group.at(i);
+      const auto& tr1_name = instance.get_train_list().get_train(tr1).name;
+      const auto& tr2_name = instance.get_train_list().get_train(tr2).name;
+      const auto  name     = "symmetry_breaking_" + tr1_name + "_" + tr2_name +
+                             "_" + entry_name;
+      this->add_constr(vars.at("t_front_arrival")(tr1, entry), GRB_LESS_EQUAL,
+                       vars.at("t_front_arrival")(tr2, entry),
+                       name);
+      symmetry_breaking_constraints.emplace_back(tr1, tr2, name);
+    }
+  }
+}
+
 GRBLinExpr
 cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::get_edge_path_expr(
     size_t tr, const cda_rail::index_vector& p, double initial_velocity,
@@ -1947,19 +2139,88 @@ cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::get_edge_path_expr(
       if (cda_rail::possible_by_eom(vel_source, vel_target,
                                     tr_object.acceleration,
                                     tr_object.deceleration, e_1_obj.length)) {
-        edge_path_expr += vars["y"](tr, e_1, v_source_index, v_target_index);
+        edge_path_expr += vars.at("y")(tr, e_1, v_source_index, v_target_index);
       }
     }
   }
   for (const auto& e_p : p) {
     if (e_p != e_1) {
-      edge_path_expr += vars["x"](tr, e_p);
+      edge_path_expr += vars.at("x")(tr, e_p);
     }
   }
 
   return edge_path_expr;
 }
 
+GRBLinExpr
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::checked_expr(
+    const GRBLinExpr& expr) {
+  /**
+   * Returns expr with the terms of every variable merged. Merged coefficients
+   * within the integer feasibility tolerance are rounded to 0, since Gurobi
+   * might otherwise run into numerical issues. Variables added since the last
+   * model update have no index yet and are not merged.
+   */
+
+  std::vector<std::pair<int, unsigned int>> term_order;
+  term_order.reserve(expr.size());
+  for (unsigned int i = 0; i < expr.size(); i++) {
+    term_order.emplace_back(expr.getVar(static_cast<int>(i)).index(), i);
+  }
+  std::ranges::sort(term_order);
+
+  std::vector<GRBVar> checked_vars;
+  std::vector<double> checked_coeffs;
+  size_t              num_dropped = 0;
+  for (size_t k = 0; k < term_order.size();) {
+    const auto [var_index, term] = term_order.at(k);
+    double coeff                 = expr.getCoeff(static_cast<int>(term));
+    for (k++; var_index >= 0 && k < term_order.size() &&
+              term_order.at(k).first == var_index;
+         k++) {
+      coeff += expr.getCoeff(static_cast<int>(term_order.at(k).second));
+    }
+    if (coeff == 0) {
+      continue;
+    }
+    if (std::abs(coeff) < coefficient_tolerance) {
+      num_dropped++;
+      continue;
+    }
+    checked_vars.push_back(expr.getVar(static_cast<int>(term)));
+    checked_coeffs.push_back(coeff);
+  }
+
+  if (num_dropped > 0) {
+    // Constraint families might be built concurrently
+    std::atomic_ref<size_t>(num_dropped_coefficients) += num_dropped;
+  }
+
+  GRBLinExpr checked = expr.getConstant();
+  checked.addTerms(checked_coeffs.data(), checked_vars.data(),
+                   static_cast<int>(checked_vars.size()));
+  return checked;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::add_constr(
+    const GRBLinExpr& lhs, char sense, const GRBLinExpr& rhs,
+    const std::string& name) {
+  GeneralMIPSolver::add_constr(to_temp_constr(checked_expr(lhs - rhs), sense),
+                               name);
+}
+
+GRBTempConstr
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::to_temp_constr(
+    const GRBLinExpr& expr, char sense) {
+  if (sense == GRB_LESS_EQUAL) {
+    return expr <= 0;
+  }
+  if (sense == GRB_GREATER_EQUAL) {
+    return expr >= 0;
+  }
+  return expr == 0;
+}
+
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
     fill_relevant_reverse_edges() {
   const auto relevant_breakable_edges =
@@ -2044,11 +2305,11 @@ std::tuple<double, GRBLinExpr, double, GRBLinExpr> cda_rail::solver::mip_based::
           // Add more headway if velocity headway is larger than vertex
           // required headway
           if (source_velocity_headway > source_v_object.headway) {
-            hw_s1 += vars["y"](tr, e, s_vel_idx, t_vel_idx) *
+            hw_s1 += vars.at("y")(tr, e, s_vel_idx, t_vel_idx) *
                      (source_velocity_headway - source_v_object.headway);
           }
           if (target_velocity_headway > target_v_object.headway) {
-            hw_t1 += vars["y"](tr, e, s_vel_idx, t_vel_idx) *
+            hw_t1 += vars.at("y")(tr, e, s_vel_idx, t_vel_idx) *
                      (target_velocity_headway - target_v_object.headway);
           }
         }
@@ -2108,10 +2369,10 @@ std::tuple<double, GRBLinExpr, double, GRBLinExpr> cda_rail::solver::mip_based::
         hw_max_ttd = std::max(hw_tmp_ttd, hw_max_ttd);
 
         headway_tr_on_e +=
-            vars["y"](tr, e, v_source_index, v_target_index) * hw_tmp;
+            vars.at("y")(tr, e, v_source_index, v_target_index) * hw_tmp;
 
         headway_tr_on_ttd +=
-            vars["y"](tr, e, v_source_index, v_target_index) * hw_tmp_ttd;
+            vars.at("y")(tr, e, v_source_index, v_target_index) * hw_tmp_ttd;
       }
     }
   }
@@ -2121,6 +2382,7 @@ std::tuple<double, GRBLinExpr, double, GRBLinExpr> cda_rail::solver::mip_based::
 
 void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::cleanup() {
   GeneralMIPSolver::cleanup();
+  lazy_callback.reset();
   solution_settings = {};
   model_detail      = {};
   solver_strategy   = {};
@@ -2130,9 +2392,86 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::cleanup() {
   num_ttd           = 0;
   max_t             = 0;
   ttd_sections.clear();
+  train_classes.clear();
+  train_class_representatives.clear();
+  train_class_edges.clear();
   tr_stop_data.clear();
   velocity_extensions.clear();
   relevant_reverse_edges.clear();
+  lazy_cut_pool.clear();
+  num_lazy_callbacks       = 0;
+  coefficient_tolerance    = 0;
+  num_dropped_coefficients = 0;
+  retained_instance.reset();
+  incumbent_stored_as_start = false;
+  symmetry_breaking_constraints.clear();
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    add_promoted_lazy_cuts() {
+  /**
+   * Adds lazy constraints that were separated frequently in previous solves as
+   * hard constraints. They are only valid if the model detail has not changed.
+   * Moreover, they are inserted into the cut pool so that the callback does not
+   * add them a second time.
+   */
+
+  if (promoted_lazy_cuts.empty()) {
+    return;
+  }
+  if (promoted_lazy_cuts_model_detail != model_detail) {
+    PLOGD << "Model detail changed, discard promoted lazy constraints";
+    clear_lazy_cut_pool();
+    return;
+  }
+
+  size_t num_added = 0;
+  for (const auto& [key, promoted_cut] : promoted_lazy_cuts) {
+    GRBLinExpr expr          = -promoted_cut.rhs;
+    bool       all_vars_used = true;
+    for (const auto& [var_name, coeff] : promoted_cut.terms) {
+      try {
+        expr += coeff * model->getVarByName(var_name);
+      } catch (GRBException&) {
+        all_vars_used = false;
+        break;
+      }
+    }
+    if (!all_vars_used) {
+      continue;
+    }
+    expr = checked_expr(expr);
+    GeneralMIPSolver::add_constr(to_temp_constr(expr, promoted_cut.sense),
+                                 "promoted_lazy_" + std::to_string(num_added));
+    lazy_cut_pool.try_emplace(key, PooledLazyCut{expr, promoted_cut.sense});
+    num_added++;
+  }
+  PLOGD << "Added " << num_added << " promoted lazy constraints";
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    promote_frequent_lazy_cuts() {
+  // Store cuts that were separated often by variable names, since the
+  // corresponding Gurobi objects do not survive cleanup
+  size_t num_promoted = 0;
+  for (const auto& [key, cut] : lazy_cut_pool) {
+    if (cut.num_separations < solver_strategy.promote_lazy_cuts_after ||
+        promoted_lazy_cuts.contains(key)) {
+      continue;
+    }
+    PromotedLazyCut promoted_cut{{}, cut.sense, -cut.expr.getConstant()};
+    promoted_cut.terms.reserve(cut.expr.size());
+    for (unsigned int i = 0; i < cut.expr.size(); i++) {
+      promoted_cut.terms.emplace_back(
+          cut.expr.getVar(static_cast<int>(i)).get(GRB_StringAttr_VarName),
+          cut.expr.getCoeff(static_cast<int>(i)));
+    }
+    promoted_lazy_cuts.emplace(key, std::move(promoted_cut));
+    num_promoted++;
+  }
+  promoted_lazy_cuts_model_detail = model_detail;
+  PLOGD << "Promoted " << num_promoted
+        << " lazy constraints to hard constraints for subsequent solves";
 }
 
 // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,performance-inefficient-string-concatenation,bugprone-unchecked-optional-access)
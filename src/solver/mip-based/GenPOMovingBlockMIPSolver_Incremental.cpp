@@ -0,0 +1,281 @@
+#include "CustomExceptions.hpp"
+#include "datastructure/GeneralTimetable.hpp"
+#include "gurobi_c++.h"
+#include "gurobi_c.h"
+#include "plog/Log.h"
+#include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
+#include "solver/mip-based/GenPOMovingBlockMIPSolver.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::size_t;
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,performance-inefficient-string-concatenation,bugprone-unchecked-optional-access)
+
+namespace {
+size_t get_stop_index(
+    const cda_rail::instances::GeneralPerformanceOptimizationInstance& instance,
+    size_t tr, const std::string& station_name) {
+  const auto& stops = instance.get_schedule(tr).get_stops();
+  const auto  it    = std::ranges::find_if(stops, [&](const auto& stop) {
+    return stop.get_station_name() == station_name;
+  });
+  if (it == stops.end()) {
+    throw cda_rail::exceptions::InvalidInputException(
+        "Train " + instance.get_train_list().get_train(tr).name +
+        " does not stop at station " + station_name);
+  }
+  return static_cast<size_t>(std::distance(stops.begin(), it));
+}
+
+void replace_stop(
+    cda_rail::instances::GeneralPerformanceOptimizationInstance& instance,
+    size_t tr, const cda_rail::GeneralScheduledStop& new_stop) {
+  // Stops are not sorted again, since stop variables are indexed by position
+  const auto stop_index =
+      get_stop_index(instance, tr, new_stop.get_station_name());
+  auto stops = instance.get_schedule(tr).get_stops();
+  for (size_t i = 0; i < stops.size(); i++) {
+    if (i != stop_index && stops.at(i).conflicts(new_stop)) {
+      throw cda_rail::exceptions::ConsistencyException(
+          "Stop conflicts with existing stop");
+    }
+  }
+  stops.at(stop_index) = new_stop;
+  instance.editable_schedule(tr).set_stops(stops);
+}
+} // namespace
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::release_model() {
+  /**
+   * Releases a model retained for incremental re-solves and restores the
+   * original instance (including all changes applied in the meantime).
+   */
+
+  if (!retained_instance.has_value()) {
+    return;
+  }
+  auto original_instance = std::move(retained_instance.value());
+  cleanup();
+  this->instance = std::move(original_instance);
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    prepare_model_modification() {
+  if (!has_retained_model()) {
+    PLOGE << "No retained model to modify";
+    throw exceptions::ConsistencyException(
+        "No retained model to modify. Solve with retain_model first.");
+  }
+  store_incumbent_as_start();
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    remove_symmetry_breaking_constraints(size_t tr) {
+  /**
+   * Symmetry breaking constraints are only valid for interchangeable trains.
+   * Hence, all of them involving train tr are removed before tr is modified.
+   * Closing edges affects all trains of a group alike and keeps them.
+   */
+
+  const auto removed = std::ranges::remove_if(
+      symmetry_breaking_constraints, [&](const auto& constr) {
+        const auto& [tr1, tr2, name] = constr;
+        if (tr1 != tr && tr2 != tr) {
+          return false;
+        }
+        PLOGD << "Remove symmetry breaking constraint " << name;
+        model->remove(model->getConstrByName(name));
+        return true;
+      });
+  symmetry_breaking_constraints.erase(removed.begin(), removed.end());
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    store_incumbent_as_start() {
+  /**
+   * Gurobi discards the solution once the model is modified. Hence, the
+   * incumbent is stored as MIP start before the first modification after an
+   * optimization. If it is infeasible for the modified model, Gurobi tries to
+   * repair it.
+   */
+
+  if (incumbent_stored_as_start || model->get(GRB_IntAttr_SolCount) == 0) {
+    return;
+  }
+
+  // NOLINTBEGIN(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+  const int                       num_vars = model->get(GRB_IntAttr_NumVars);
+  const std::unique_ptr<GRBVar[]> grb_vars(model->getVars());
+  const std::unique_ptr<double[]> values(
+      model->get(GRB_DoubleAttr_X, grb_vars.get(), num_vars));
+  model->set(GRB_DoubleAttr_Start, grb_vars.get(), values.get(), num_vars);
+  // NOLINTEND(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+
+  incumbent_stored_as_start = true;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    set_train_entry_time_range(size_t tr, std::pair<int, int> t_0) {
+  /**
+   * Changes the interval in which train tr enters the network. Only the right
+   * hand sides of the respective constraints are updated.
+   */
+
+  prepare_model_modification();
+  if (t_0.first < 0 || t_0.second < t_0.first) {
+    throw exceptions::InvalidInputException("Invalid entry time interval");
+  }
+  // The big M of the timing constraints is the latest exit time of tr
+  if (t_0.second > ub_timing_variable(tr)) {
+    PLOGE << "Entry time interval exceeds the exit time interval";
+    throw exceptions::ConsistencyException(
+        "Train cannot enter after its latest exit time " +
+        std::to_string(instance.get_schedule(tr).get_t_n_range().second));
+  }
+  remove_symmetry_breaking_constraints(tr);
+
+  const auto& tr_name = instance.get_train_list().get_train(tr).name;
+  model->getConstrByName("initial_arrival_time_lb_" + tr_name)
+      .set(GRB_DoubleAttr_RHS, t_0.first);
+  model->getConstrByName("initial_arrival_time_ub_" + tr_name)
+      .set(GRB_DoubleAttr_RHS, t_0.second);
+
+  instance.editable_schedule(tr).set_t_0_range(t_0);
+  retained_instance->editable_schedule(tr).set_t_0_range(t_0);
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    set_stop_time_ranges(size_t tr, const std::string& station_name,
+                         std::pair<int, int> begin, std::pair<int, int> end) {
+  /**
+   * Changes the arrival and departure intervals of an existing stop of train
+   * tr. The coefficients of the stop variables and the right hand sides of the
+   * respective constraints are updated for every possible stop vertex.
+   */
+
+  prepare_model_modification();
+
+  const auto  stop_index = get_stop_index(instance, tr, station_name);
+  const auto& tr_object  = instance.get_train_list().get_train(tr);
+  const auto& old_stop   = instance.get_schedule(tr).get_stops().at(stop_index);
+  const GeneralScheduledStop new_stop(
+      begin, end, old_stop.get_min_stopping_time(), station_name);
+  replace_stop(instance, tr, new_stop);
+  replace_stop(retained_instance.value(), tr, new_stop);
+  remove_symmetry_breaking_constraints(tr);
+
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  const auto M = ub_timing_variable(tr);
+  for (const auto& [v, paths] : tr_stop_data.at(tr).at(stop_index)) {
+    const auto name_suffix = tr_object.name + "_" + station_name + "_vertex_" +
+                             instance.const_n().get_vertex(v).name;
+    const auto& stop_var = vars["stop"](tr, stop_index, v);
+
+    // t >= t_0 * stop, i.e., t - t_0 * stop >= 0
+    model->chgCoeff(model->getConstrByName("min_arrival_time_" + name_suffix),
+                    stop_var, -begin.first);
+    // t <= t_0 + M * (1 - stop), i.e., t + M * stop <= t_0 + M
+    model->getConstrByName("max_arrival_time_" + name_suffix)
+        .set(GRB_DoubleAttr_RHS, begin.second + M);
+    model->chgCoeff(
+        model->getConstrByName("min_departure_time_" + name_suffix), stop_var,
+        -end.first);
+    model->getConstrByName("max_departure_time_" + name_suffix)
+        .set(GRB_DoubleAttr_RHS, end.second + M);
+  }
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::set_train_weight(
+    size_t tr, double weight) {
+  // The objective is normalized by the sum of weights, hence, rebuild it
+  prepare_model_modification();
+  remove_symmetry_breaking_constraints(tr);
+  instance.set_train_weight(tr, weight);
+  retained_instance->set_train_weight(tr, weight);
+  set_objective();
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    set_edge_upper_bound(const std::string& source, const std::string& target,
+                         double ub) {
+  /**
+   * Closes (ub = 0) or reopens (ub = 1) an edge of the instance network for
+   * all trains that might use it. If the edge has been separated during
+   * discretization, all resulting edges are affected. Only the bounds of the
+   * retained model are changed, the change is not part of the instance.
+   */
+
+  prepare_model_modification();
+
+  const auto& original_network = retained_instance->const_n();
+  if (!original_network.has_vertex(source) ||
+      !original_network.has_vertex(target) ||
+      !original_network.has_edge(source, target)) {
+    throw exceptions::InvalidInputException(
+        "Edge from " + source + " to " + target +
+        " is not part of the instance network");
+  }
+  const auto old_e = original_network.get_edge_index(source, target);
+
+  for (size_t e = 0; e < num_edges; e++) {
+    if (instance.const_n().get_old_edge(e).first != old_e) {
+      continue;
+    }
+    for (size_t tr = 0; tr < num_tr; tr++) {
+      const auto tr_edges =
+          instance.edges_used_by_train(tr, model_detail.fix_routes, false);
+      if (std::ranges::contains(tr_edges, e)) {
+        vars["x"](tr, e).set(GRB_DoubleAttr_UB, ub);
+      }
+    }
+  }
+}
+
+cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+    cda_rail::instances::GeneralPerformanceOptimizationInstance>
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::resolve(
+    int time_limit) {
+  /**
+   * Re-optimizes a retained model after incremental changes. The previous
+   * incumbent is used as MIP start and the lazy cut pool is kept.
+   *
+   * @param time_limit: time limit for the solver in seconds. If -1, no time
+   * limit is set.
+   *
+   * @return: respective solution object
+   */
+
+  if (!has_retained_model()) {
+    PLOGE << "No retained model to re-solve";
+    throw exceptions::ConsistencyException(
+        "No retained model to re-solve. Solve with retain_model first.");
+  }
+
+  model->set(GRB_DoubleParam_TimeLimit, time_limit > 0
+                                            ? static_cast<double>(time_limit)
+                                            : GRB_INFINITY);
+
+  PLOGI << "Re-optimize retained model";
+  model->optimize();
+  incumbent_stored_as_start = false;
+
+  if (solver_strategy.use_lazy_constraints) {
+    PLOGD << "Lazy cut pool contains " << lazy_cut_pool.size()
+          << " constraints after " << num_lazy_callbacks << " callbacks";
+  }
+
+  instances::SolGeneralPerformanceOptimizationInstance solution(
+      retained_instance.value());
+  extract_solution(solution);
+
+  return solution;
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-array-to-pointer-decay,performance-inefficient-string-concatenation,bugprone-unchecked-optional-access)
@@ -13,9 +13,12 @@
 #include <cstdlib>
 #include <exception>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <optional>
+#include <span>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -30,7 +33,25 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
   try {
     if (where == GRB_CB_MESSAGE) {
       MessageCallback::callback();
-    } else if (where == GRB_CB_MIPSOL) {
+    } else if (where == GRB_CB_MIP) {
+      exchange_shared_bounds();
+    } else if (where == GRB_CB_MIPNODE) {
+      inject_shared_routes();
+    } else if (where == GRB_CB_MIPSOL &&
+               solver->solver_strategy.use_lazy_constraints) {
+      solver->num_lazy_callbacks++;
+      if (solver->solver_strategy.use_lazy_cut_pool) {
+        fetch_solution_values();
+        // Solutions found before previous lazy constraints were propagated
+        // might still violate them. Hence, they are re-added if necessary.
+        const auto pooled_cut_added = separate_lazy_cut_pool();
+        if (pooled_cut_added &&
+            solver->solver_strategy.lazy_constraint_selection_strategy ==
+                LazyConstraintSelectionStrategy::OnlyFirstFound) {
+          return;
+        }
+      }
+
       const auto routes                = get_routes();
       const auto train_velocities      = get_train_velocities(routes);
       const auto train_orders_on_edges = get_train_orders_on_edges(routes);
@@ -68,6 +89,329 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
   }
 }
 
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    exchange_shared_bounds() {
+  /**
+   * Publishes the incumbent and bound of this model to concurrently running
+   * solvers. Aborts if a stop was requested or if the shared incumbent cannot
+   * be improved by this model anymore. If the bound is valid for the original
+   * problem, the latter proves optimality and all solvers are stopped.
+   */
+
+  const auto& shared = solver->shared_incumbent;
+  if (shared == nullptr) {
+    return;
+  }
+  if (shared->is_stop_requested()) {
+    PLOGD << "Stop requested by concurrent solver";
+    abort();
+    return;
+  }
+
+  if (getIntInfo(GRB_CB_MIP_SOLCNT) > 0) {
+    shared->update_upper_bound(absolute_objective(
+        solver->instance, getDoubleInfo(GRB_CB_MIP_OBJBST)));
+  }
+
+  const auto bound =
+      absolute_objective(solver->instance, getDoubleInfo(GRB_CB_MIP_OBJBND));
+  // The simplified headway constraints restrict the solution space, hence,
+  // the bound is not valid for the original problem.
+  const bool bound_is_valid =
+      !solver->model_detail.simplify_headway_constraints;
+  if (bound_is_valid) {
+    shared->update_lower_bound(bound);
+  }
+  if (shared->get_upper_bound() <= bound + GRB_EPS) {
+    if (bound_is_valid) {
+      // The shared incumbent, possibly found by another solver, is optimal
+      PLOGD << "Shared incumbent is proven optimal";
+      shared->request_stop();
+    } else {
+      PLOGD << "Shared incumbent cannot be improved by this model";
+    }
+    abort();
+  }
+}
+
+std::optional<std::unordered_set<size_t>>
+cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+    get_discretized_route_edges(
+        size_t tr, const SharedIncumbent::NamedRoute& route) const {
+  /**
+   * Maps a route given by edges of the instance network to the edges of the
+   * discretized network. Edges separated by the stop discretization keep
+   * their index for the last part, all parts map to it via get_old_edge.
+   *
+   * @return The discretized edges of the route, or std::nullopt if the route
+   * cannot be used by train tr in this model.
+   */
+
+  if (route.empty()) {
+    return std::nullopt;
+  }
+
+  const auto& network = instance.const_n();
+  std::unordered_map<size_t, cda_rail::index_vector> discretized_edges;
+  for (size_t e = 0; e < num_edges; e++) {
+    discretized_edges[network.get_old_edge(e).first].push_back(e);
+  }
+
+  std::unordered_set<size_t> route_edges;
+  for (const auto& [source, target] : route) {
+    if (!network.has_vertex(source) || !network.has_vertex(target)) {
+      return std::nullopt;
+    }
+    const auto v_0 = network.get_vertex_index(source);
+    const auto v_1 = network.get_vertex_index(target);
+
+    // The first part of a separated edge starts at the source, the part that
+    // kept the original index ends at the target
+    std::optional<size_t> old_e;
+    for (const auto e : network.out_edges(v_0)) {
+      const auto candidate = network.get_old_edge(e).first;
+      if (network.get_edge(candidate).target == v_1) {
+        old_e = candidate;
+        break;
+      }
+    }
+    if (!old_e.has_value()) {
+      return std::nullopt;
+    }
+
+    for (const auto e : discretized_edges.at(old_e.value())) {
+      if (vars.at("x").at(tr, e).sameAs(GRBVar())) {
+        return std::nullopt;
+      }
+      route_edges.insert(e);
+    }
+  }
+  return route_edges;
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    inject_shared_routes() {
+  /**
+   * Uses routes found by concurrently running solvers as a (partial) start
+   * solution. Only the edge variables are fixed, timing is left to Gurobi.
+   * Trains whose route cannot be used in this model are skipped.
+   */
+
+  const auto& shared = solver->shared_incumbent;
+  if (shared == nullptr) {
+    return;
+  }
+  const auto [version, routes] = shared->get_routes();
+  if (version == injected_routes_version) {
+    return;
+  }
+  injected_routes_version = version;
+
+  bool injected = false;
+  for (size_t tr = 0; tr < std::min(routes.size(), solver->num_tr); tr++) {
+    const auto route_edges =
+        solver->get_discretized_route_edges(tr, routes.at(tr));
+    if (!route_edges.has_value()) {
+      continue;
+    }
+
+    for (size_t e = 0; e < solver->num_edges; e++) {
+      const auto& x_var = solver->vars.at("x").at(tr, e);
+      if (!x_var.sameAs(GRBVar())) {
+        setSolution(x_var, route_edges->contains(e) ? 1.0 : 0.0);
+      }
+    }
+    injected = true;
+  }
+
+  if (injected) {
+    PLOGD << "Inject routes of shared incumbent (version " << version << ")";
+    useSolution();
+  }
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    initialize_solution_vars() {
+  /**
+   * Collects all variables in vars ordered by train. Every variable belongs to
+   * the train given by its first index.
+   */
+
+  std::vector<std::vector<GRBVar>> train_vars(solver->num_tr);
+  for (const auto& [name, var_array] : solver->vars) {
+    assert(var_array.get_shape().front() == solver->num_tr);
+    const auto& data = var_array.get_data();
+    for (size_t i = 0; i < data.size(); i++) {
+      // The first index changes fastest
+      if (!data.at(i).sameAs(GRBVar())) {
+        train_vars.at(i % solver->num_tr).push_back(data.at(i));
+      }
+    }
+  }
+
+  train_var_offsets = {0};
+  for (const auto& vars_tr : train_vars) {
+    solution_vars.insert(solution_vars.end(), vars_tr.begin(), vars_tr.end());
+    train_var_offsets.push_back(solution_vars.size());
+  }
+
+  for (size_t pos = 0; pos < solution_vars.size(); pos++) {
+    const auto var_index = static_cast<size_t>(solution_vars.at(pos).index());
+    if (var_index >= solution_positions.size()) {
+      solution_positions.resize(var_index + 1, -1);
+    }
+    solution_positions.at(var_index) = static_cast<int>(pos);
+  }
+  train_last_changed = std::vector<size_t>(solver->num_tr, 0);
+}
+
+void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    fetch_solution_values() {
+  /**
+   * Fetches the values of all variables in vars with a single call and records
+   * for every train whether any of its values differs from the previous
+   * callback.
+   */
+
+  if (train_var_offsets.empty()) {
+    initialize_solution_vars();
+  }
+
+  const std::unique_ptr<double[]> values_ptr(getSolution(
+      solution_vars.data(), static_cast<int>(solution_vars.size())));
+  const std::span<const double> values(values_ptr.get(), solution_vars.size());
+
+  for (size_t tr = 0; tr < solver->num_tr; tr++) {
+    const auto begin = train_var_offsets.at(tr);
+    const auto count = train_var_offsets.at(tr + 1) - begin;
+    if (solution_values.empty() ||
+        !std::ranges::equal(
+            values.subspan(begin, count),
+            std::span<const double>(solution_values).subspan(begin, count))) {
+      train_last_changed.at(tr) = solver->num_lazy_callbacks;
+    }
+  }
+  solution_values.assign(values.begin(), values.end());
+}
+
+double cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    get_solution_value(const GRBVar& var) {
+  // Variables that are not part of vars are not fetched in advance
+  const auto var_index = static_cast<size_t>(var.index());
+  if (var.index() >= 0 && var_index < solution_positions.size() &&
+      solution_positions.at(var_index) >= 0) {
+    return solution_values.at(
+        static_cast<size_t>(solution_positions.at(var_index)));
+  }
+  return getSolution(var);
+}
+
+double cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    get_cut_violation(const GRBLinExpr& expr, char sense) {
+  /**
+   * Returns by how much the constraint expr (sense) 0 is violated by the
+   * current solution. A non-positive value means that it is satisfied.
+   */
+
+  double val = expr.getConstant();
+  for (unsigned int i = 0; i < expr.size(); i++) {
+    val += expr.getCoeff(static_cast<int>(i)) *
+           get_solution_value(expr.getVar(static_cast<int>(i)));
+  }
+
+  if (sense == GRB_LESS_EQUAL) {
+    return val;
+  }
+  if (sense == GRB_GREATER_EQUAL) {
+    return -val;
+  }
+  return std::abs(val);
+}
+
+bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    is_cut_satisfied(const LazyCutKey& key, PooledLazyCut& cut) {
+  /**
+   * Returns true if the pooled cut is satisfied by the current solution. A cut
+   * only depends on the variables of the two trains of its key. Hence, it is
+   * only evaluated again if one of them changed since it was last satisfied.
+   */
+
+  if (cut.last_satisfied >=
+      std::max(train_last_changed.at(key.indices.at(0)),
+               train_last_changed.at(key.indices.at(1)))) {
+    return true;
+  }
+  if (get_cut_violation(cut.expr, cut.sense) > GRB_EPS) {
+    return false;
+  }
+  cut.last_satisfied = solver->num_lazy_callbacks;
+  return true;
+}
+
+bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    separate_lazy_cut_pool() {
+  // Re-add every pooled cut that is violated by the current solution
+  bool violated_constraint_found = false;
+  for (auto& [key, cut] : solver->lazy_cut_pool) {
+    if (!is_cut_satisfied(key, cut)) {
+      addLazy(to_temp_constr(cut.expr, cut.sense));
+      cut.num_separations++;
+      cut.last_callback         = solver->num_lazy_callbacks;
+      violated_constraint_found = true;
+    }
+  }
+  return violated_constraint_found;
+}
+
+bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
+    add_lazy_constraint(LazyCutKey key, const GRBLinExpr& lhs, char sense,
+                        const GRBLinExpr& rhs) {
+  /**
+   * Adds the lazy constraint lhs (sense) rhs. If the cut pool is used, a
+   * constraint with the same key that is already part of the model is only
+   * added again if it is violated by the current solution.
+   *
+   * @return true if the constraint was added, false otherwise
+   */
+
+  const bool export_lp =
+      solver->solution_settings.export_option == ExportOption::ExportLP ||
+      solver->solution_settings.export_option ==
+          ExportOption::ExportSolutionAndLP ||
+      solver->solution_settings.export_option ==
+          ExportOption::ExportSolutionWithInstanceAndLP;
+
+  if (!solver->solver_strategy.use_lazy_cut_pool) {
+    const auto constr = to_temp_constr(solver->checked_expr(lhs - rhs), sense);
+    addLazy(constr);
+    if (export_lp) {
+      solver->lazy_constraints.push_back(constr);
+    }
+    return true;
+  }
+
+  auto [it, inserted] = solver->lazy_cut_pool.try_emplace(
+      std::move(key), PooledLazyCut{GRBLinExpr(), sense});
+  auto& cut = it->second;
+  if (inserted) {
+    cut.expr = solver->checked_expr(lhs - rhs);
+  }
+  if (!inserted && (cut.last_callback == solver->num_lazy_callbacks ||
+                    is_cut_satisfied(it->first, cut))) {
+    // Already added within this callback or still satisfied
+    return false;
+  }
+
+  cut.num_separations++;
+  cut.last_callback = solver->num_lazy_callbacks;
+  const auto constr = to_temp_constr(cut.expr, cut.sense);
+  addLazy(constr);
+  if (inserted && export_lp) {
+    solver->lazy_constraints.push_back(constr);
+  }
+  return true;
+}
+
 std::vector<std::vector<std::pair<size_t, double>>> cda_rail::solver::
     mip_based::GenPOMovingBlockMIPSolver::LazyCallback::get_routes() {
   /**
@@ -269,6 +613,9 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
       const auto& vel          = train_velocities.at(tr).at(v_idx);
       const auto  bd           = vel * vel / (2 * tr_object.deceleration);
       const auto  ma_pos       = pos + bd;
+      const auto  vel_idx      = static_cast<size_t>(
+          std::ranges::find(solver->velocity_extensions.at(tr).at(v_idx), vel) -
+          solver->velocity_extensions.at(tr).at(v_idx).begin());
 
       const auto& tr_t_var       = solver->vars["t_front_arrival"](tr, v_idx);
       const auto& tr_t_var_value = getSolution(tr_t_var);
@@ -458,17 +805,15 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
             // that the order variable has the correct semantic value is ensured
             // by vertex headway constraints
 
-            for (const auto& rhs_expr : rhs) {
-              addLazy(lhs >= rhs_expr);
-              if (solver->solution_settings.export_option ==
-                      ExportOption::ExportLP ||
-                  solver->solution_settings.export_option ==
-                      ExportOption::ExportSolutionAndLP ||
-                  solver->solution_settings.export_option ==
-                      ExportOption::ExportSolutionWithInstanceAndLP) {
-                solver->lazy_constraints.push_back(lhs >= rhs_expr);
+            for (size_t rhs_idx = 0; rhs_idx < rhs.size(); rhs_idx++) {
+              cda_rail::index_vector key_indices = {tr, tr_other_idx, vel_idx,
+                                                    rhs_idx};
+              key_indices.insert(key_indices.end(), p.begin(), p.end());
+              if (add_lazy_constraint(
+                      {LazyConstraintFamily::EdgeHeadway, key_indices}, lhs,
+                      GRB_GREATER_EQUAL, rhs.at(rhs_idx))) {
+                violated_constraint_found = true;
               }
-              violated_constraint_found = true;
             }
           }
         }
@@ -601,19 +946,20 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
                   t_bound_tmp *
                       (solver->vars["order_ttd"](tr, other_tr, ttd_index) - 1);
               std::vector<GRBLinExpr> lhs;
+              cda_rail::index_vector  key_indices = {
+                  tr, other_tr, ttd_index, v_idx, vel_idx, solver->num_edges,
+                  0};
               if (prev_edge_index.has_value()) {
                 assert(prev_vel.has_value());
-                const auto vel_idx =
-                    std::ranges::find(
-                        solver->velocity_extensions.at(tr).at(v_idx), vel) -
-                    solver->velocity_extensions.at(tr).at(v_idx).begin();
-                const auto prev_vel_idx =
+                const auto prev_vel_idx = static_cast<size_t>(
                     std::ranges::find(solver->velocity_extensions.at(tr).at(
                                           prev_v_idx.value()),
                                       prev_vel.value()) -
                     solver->velocity_extensions.at(tr)
                         .at(prev_v_idx.value())
-                        .begin();
+                        .begin());
+                key_indices.at(5) = prev_edge_index.value();
+                key_indices.at(6) = prev_vel_idx;
                 lhs.emplace_back(
                     tr_t_var - t_reduction +
                     t_bound_tmp *
@@ -640,17 +986,16 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
                                       edge_tmp_path_expr));
               }
 
-              for (const auto& lhs_expr : lhs) {
-                addLazy(lhs_expr >= rhs);
-                if (solver->solution_settings.export_option ==
-                        ExportOption::ExportLP ||
-                    solver->solution_settings.export_option ==
-                        ExportOption::ExportSolutionAndLP ||
-                    solver->solution_settings.export_option ==
-                        ExportOption::ExportSolutionWithInstanceAndLP) {
-                  solver->lazy_constraints.push_back(lhs_expr >= rhs);
+              key_indices.insert(key_indices.end(), p_tmp.begin(),
+                                 p_tmp.end());
+              for (size_t lhs_idx = 0; lhs_idx < lhs.size(); lhs_idx++) {
+                auto key_indices_tmp = key_indices;
+                key_indices_tmp.push_back(lhs_idx);
+                if (add_lazy_constraint(
+                        {LazyConstraintFamily::TTDHeadway, key_indices_tmp},
+                        lhs.at(lhs_idx), GRB_GREATER_EQUAL, rhs)) {
+                  violated_constraint_found = true;
                 }
-                violated_constraint_found = true;
               }
             }
           }
@@ -795,8 +1140,6 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
           // NOLINTNEXTLINE(misc-const-correctness)
           GRBLinExpr edge_expr = solver->vars["x"](tr, edge_index) +
                                  solver->vars["x"](other_tr, edge_index);
-          addLazy(order_expr <= 0.5 * edge_expr);
-          addLazy(order_expr >= edge_expr - 1);
 
           // Add headway constraints
           // NOLINTNEXTLINE(misc-const-correctness)
@@ -837,25 +1180,22 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
           // NOLINTNEXTLINE(misc-const-correctness)
           GRBLinExpr rhs_target_2 = tr_t_var_target_rear + hw_t2;
 
-          addLazy(lhs_source >= rhs_source);
-          addLazy(lhs_target >= rhs_target);
-          addLazy(lhs_source_2 >= rhs_source_2);
-          addLazy(lhs_target_2 >= rhs_target_2);
-          if (solver->solution_settings.export_option ==
-                  ExportOption::ExportLP ||
-              solver->solution_settings.export_option ==
-                  ExportOption::ExportSolutionAndLP ||
-              solver->solution_settings.export_option ==
-                  ExportOption::ExportSolutionWithInstanceAndLP) {
-            // So that the constraint can be exported
-            solver->lazy_constraints.push_back(order_expr <= 0.5 * edge_expr);
-            solver->lazy_constraints.push_back(order_expr >= edge_expr - 1);
-            solver->lazy_constraints.push_back(lhs_source >= rhs_source);
-            solver->lazy_constraints.push_back(lhs_target >= rhs_target);
-            solver->lazy_constraints.push_back(lhs_source_2 >= rhs_source_2);
-            solver->lazy_constraints.push_back(lhs_target_2 >= rhs_target_2);
+          const std::vector<std::tuple<GRBLinExpr, char, GRBLinExpr>>
+              constraints = {
+                  {order_expr, GRB_LESS_EQUAL, 0.5 * edge_expr},
+                  {order_expr, GRB_GREATER_EQUAL, edge_expr - 1},
+                  {lhs_source, GRB_GREATER_EQUAL, rhs_source},
+                  {lhs_target, GRB_GREATER_EQUAL, rhs_target},
+                  {lhs_source_2, GRB_GREATER_EQUAL, rhs_source_2},
+                  {lhs_target_2, GRB_GREATER_EQUAL, rhs_target_2}};
+          for (size_t c_idx = 0; c_idx < constraints.size(); c_idx++) {
+            const auto& [lhs, sense, rhs] = constraints.at(c_idx);
+            if (add_lazy_constraint({LazyConstraintFamily::VertexHeadway,
+                                     {tr, other_tr, edge_index, c_idx}},
+                                    lhs, sense, rhs)) {
+              violated_constraint_found = true;
+            }
           }
-          violated_constraint_found = true;
         }
       }
     }
@@ -952,24 +1292,21 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
             // NOLINTNEXTLINE(misc-const-correctness)
             GRBLinExpr rhs3 = tr1_t_var_rear;
 
-            addLazy(lhs1 >= rhs1);
-            addLazy(lhs1 <= 1);
-            addLazy(lhs2 >= rhs2);
-            addLazy(lhs3 >= rhs3);
-
-            if (solver->solution_settings.export_option ==
-                    ExportOption::ExportLP ||
-                solver->solution_settings.export_option ==
-                    ExportOption::ExportSolutionAndLP ||
-                solver->solution_settings.export_option ==
-                    ExportOption::ExportSolutionWithInstanceAndLP) {
-              solver->lazy_constraints.push_back(lhs1 >= rhs1);
-              solver->lazy_constraints.push_back(lhs1 <= 1);
-              solver->lazy_constraints.push_back(lhs2 >= rhs2);
-              solver->lazy_constraints.push_back(lhs3 >= rhs3);
+            const std::vector<std::tuple<GRBLinExpr, char, GRBLinExpr>>
+                constraints = {{lhs1, GRB_GREATER_EQUAL, rhs1},
+                               {lhs1, GRB_LESS_EQUAL, 1},
+                               {lhs2, GRB_GREATER_EQUAL, rhs2},
+                               {lhs3, GRB_GREATER_EQUAL, rhs3}};
+            for (size_t c_idx = 0; c_idx < constraints.size(); c_idx++) {
+              const auto& [lhs, sense, rhs] = constraints.at(c_idx);
+              if (add_lazy_constraint(
+                      {LazyConstraintFamily::ReverseEdge,
+                       {tr1, tr2, idx, static_cast<size_t>(tr1_direction),
+                        c_idx}},
+                      lhs, sense, rhs)) {
+                violated_constraint_found = true;
+              }
             }
-
-            violated_constraint_found = true;
           }
         }
       }
@@ -1073,16 +1410,11 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
                   (1 - solver->vars["order"](tr, tr_other_idx, edge_index));
           // NOLINTNEXTLINE(misc-const-correctness)
           GRBLinExpr rhs = headway_tr_on_e;
-          addLazy(lhs >= rhs);
-          if (solver->solution_settings.export_option ==
-                  ExportOption::ExportLP ||
-              solver->solution_settings.export_option ==
-                  ExportOption::ExportSolutionAndLP ||
-              solver->solution_settings.export_option ==
-                  ExportOption::ExportSolutionWithInstanceAndLP) {
-            solver->lazy_constraints.push_back(lhs >= rhs);
+          if (add_lazy_constraint({LazyConstraintFamily::SimplifiedEdgeHeadway,
+                                   {tr, tr_other_idx, edge_index}},
+                                  lhs, GRB_GREATER_EQUAL, rhs)) {
+            violated_constraint_found = true;
           }
-          violated_constraint_found = true;
         }
       }
 
@@ -1157,16 +1489,12 @@ bool cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::LazyCallback::
                                             tr, tr_other_ttd, ttd_index));
               // NOLINTNEXTLINE(misc-const-correctness)
               GRBLinExpr rhs = headway_tr_on_ttd;
-              addLazy(lhs >= rhs);
-              if (solver->solution_settings.export_option ==
-                      ExportOption::ExportLP ||
-                  solver->solution_settings.export_option ==
-                      ExportOption::ExportSolutionAndLP ||
-                  solver->solution_settings.export_option ==
-                      ExportOption::ExportSolutionWithInstanceAndLP) {
-                solver->lazy_constraints.push_back(lhs >= rhs);
+              if (add_lazy_constraint(
+                      {LazyConstraintFamily::SimplifiedTTDHeadway,
+                       {tr, tr_other_ttd, ttd_index, edge_index}},
+                      lhs, GRB_GREATER_EQUAL, rhs)) {
+                violated_constraint_found = true;
               }
-              violated_constraint_found = true;
             }
           }
         }
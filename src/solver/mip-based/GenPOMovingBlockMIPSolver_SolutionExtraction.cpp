@@ -37,8 +37,10 @@ void cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::extract_solution(
   } else if (model->get(GRB_IntAttr_SolCount) >= 1) {
     PLOGD << "Solution status: Feasible (optimality unknown)";
     sol.set_status(SolutionStatus::Feasible);
-  } else if (grb_status == GRB_TIME_LIMIT &&
+  } else if ((grb_status == GRB_TIME_LIMIT ||
+              grb_status == GRB_INTERRUPTED) &&
              model->get(GRB_IntAttr_SolCount) == 0) {
+    // Interrupted by a concurrent solver, i.e., feasibility is unknown as well
     PLOGD << "Solution status: Timeout (Feasibility unknown)";
     sol.set_status(SolutionStatus::Timeout);
   } else {
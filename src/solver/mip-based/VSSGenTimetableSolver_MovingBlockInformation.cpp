@@ -277,8 +277,8 @@ void cda_rail::solver::mip_based::
              t <= train_interval[tr_order_on_e.at(tr_i - 1)].second;
              ++t) {
           model->addConstr(
-              vars["b_front"](tr_order_on_e.at(tr_i), t, i, vss) ==
-                  vars["b_rear"](tr_order_on_e.at(tr_i - 1), t, i, vss),
+              sparse_vars["b_front"](tr_order_on_e.at(tr_i), t, i, vss) ==
+                  sparse_vars["b_rear"](tr_order_on_e.at(tr_i - 1), t, i, vss),
               "fix_order_" + tr_object_prev.name + "_" + tr_object.name + "_" +
                   std::to_string(t * dt) + "_" + edge_name + "_" +
                   std::to_string(vss));
@@ -322,7 +322,7 @@ void cda_rail::solver::mip_based::
       GRBLinExpr following_x_expr = 0;
       for (size_t t_idx = tr_following_interval.first;
            t_idx <= tr_following_interval.second; ++t_idx) {
-        following_x_expr += vars["x"](tr_following, t_idx, e);
+        following_x_expr += pruned_var("x", tr_following, t_idx, e);
       }
 
       for (size_t t_idx =
@@ -333,17 +333,18 @@ void cda_rail::solver::mip_based::
         const int t = static_cast<int>(t_idx) * dt;
         if (t_idx >= tr_prev_interval.first &&
             t_idx <= tr_prev_interval.second) {
-          prev_x_expr += vars["x"](tr_prev, t_idx, prev_e);
+          prev_x_expr += pruned_var("x", tr_prev, t_idx, prev_e);
         }
         if (t_idx - 1 >= tr_following_interval.first &&
             t_idx - 1 <= tr_following_interval.second) {
-          following_x_expr -= vars["x"](tr_following, t_idx - 1, e);
+          following_x_expr -= pruned_var("x", tr_following, t_idx - 1, e);
         }
 
         // tr_following can only be on the edge after tr_prev
         if (t_idx >= tr_following_interval.first &&
             t_idx <= tr_following_interval.second) {
-          model->addConstr(vars["x"](tr_following, t_idx, e) <= prev_x_expr,
+          model->addConstr(pruned_var("x", tr_following, t_idx, e) <=
+                               prev_x_expr,
                            "fix_order_type_1_" + tr_prev_obj.name + "_" +
                                tr_following_obj.name + "_" + std::to_string(t) +
                                "_" + edge_name);
@@ -353,7 +354,7 @@ void cda_rail::solver::mip_based::
         // edge
         if (t_idx >= tr_prev_interval.first &&
             t_idx <= tr_prev_interval.second) {
-          model->addConstr(vars["x"](tr_prev, t_idx, prev_e) <=
+          model->addConstr(pruned_var("x", tr_prev, t_idx, prev_e) <=
                                following_x_expr,
                            "fix_order_type_2_" + tr_prev_obj.name + "_" +
                                tr_following_obj.name + "_" + std::to_string(t) +
@@ -0,0 +1,202 @@
+#include "CustomExceptions.hpp"
+#include "Definitions.hpp"
+#include "gurobi_c++.h"
+#include "gurobi_c.h"
+#include "plog/Log.h"
+#include "probleminstances/VSSGenerationTimetable.hpp"
+#include "solver/SharedIncumbent.hpp"
+#include "solver/mip-based/GeneralMIPSolver.hpp"
+#include "solver/mip-based/VSSGenTimetableSolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using std::size_t;
+
+void cda_rail::solver::mip_based::VSSGenTimetableSolver::SharedBoundsCallback::
+    callback() {
+  /**
+   * Publishes the incumbent and bound of this budget level to the concurrently
+   * solved levels. Aborts if a stop was requested or if the shared incumbent
+   * cannot be improved by this budget level anymore.
+   */
+
+  MessageCallback::callback();
+
+  if (where != GRB_CB_MIP) {
+    return;
+  }
+
+  const auto& shared = solver->shared_incumbent;
+  if (shared->is_stop_requested()) {
+    PLOGD << "Stop requested by concurrent budget level";
+    abort();
+    return;
+  }
+
+  if (getIntInfo(GRB_CB_MIP_SOLCNT) > 0) {
+    shared->update_upper_bound(getDoubleInfo(GRB_CB_MIP_OBJBST));
+  }
+
+  // The bound of the restricted model is only valid up to the budget bound
+  const auto bound = getDoubleInfo(GRB_CB_MIP_OBJBND);
+  shared->update_lower_bound(std::min(bound, solver->budget_lower_bound()));
+
+  if (shared->get_upper_bound() <= shared->get_lower_bound() + GRB_EPS) {
+    PLOGD << "Shared incumbent is proven optimal";
+    shared->request_stop();
+    abort();
+  } else if (shared->get_upper_bound() <= bound + GRB_EPS) {
+    PLOGD << "Shared incumbent cannot be improved by this budget level";
+    abort();
+  }
+}
+
+cda_rail::instances::SolVSSGenerationTimetable cda_rail::solver::mip_based::
+    VSSGenTimetableSolver::solve_parallel_budget_levels(
+        const ModelDetail& model_detail, const ModelSettings& model_settings,
+        const SolverStrategy&   solver_strategy,
+        const SolutionSettings& solution_settings, int time_limit,
+        bool debug_input, bool overwrite_severity) {
+  /**
+   * Solves the VSS budget levels of the iterative approach concurrently
+   * instead of one after another. Level k starts the iterative approach with
+   * the budget the sequential approach would use in iteration k. The last
+   * level is the full model. Every level uses its own model, Gurobi
+   * environment, and share of the available threads. Incumbents and proven
+   * lower bounds are exchanged, so that all levels stop once the best
+   * solution is proven optimal.
+   * The Gurobi models are not exported in this mode.
+   *
+   * @return Best solution found by any budget level
+   */
+
+  this->solve_init_general(time_limit, debug_input, overwrite_severity);
+
+  if (solver_strategy.update_strategy == UpdateStrategy::Fixed &&
+      solver_strategy.update_value <= 1) {
+    PLOGE << "iterative_update_value must be greater than 1";
+    throw exceptions::ConsistencyException(
+        "iterative_update_value must be greater than 1");
+  }
+  if (solver_strategy.update_strategy == UpdateStrategy::Relative &&
+      (solver_strategy.update_value <= 0 ||
+       solver_strategy.update_value >= 1)) {
+    PLOGE << "iterative_update_value must be between 0 and 1";
+    throw exceptions::ConsistencyException(
+        "iterative_update_value must be between 0 and 1");
+  }
+
+  int max_vss = 0;
+  for (const auto& e : instance.const_n().relevant_breakable_edges()) {
+    max_vss = std::max(max_vss, instance.const_n().max_vss_on_edge(e));
+  }
+
+  // Iterative levels with increasing initial budget, followed by the full
+  // model. Levels whose initial budget is not restrictive are skipped.
+  std::vector<SolverStrategy> level_strategies;
+  auto                        level_strategy = solver_strategy;
+  level_strategy.parallel_budget_levels      = 1;
+  while (level_strategies.size() + 1 <
+         solver_strategy.parallel_budget_levels) {
+    if ((level_strategy.update_strategy == UpdateStrategy::Fixed &&
+         level_strategy.initial_value >= max_vss) ||
+        (level_strategy.update_strategy == UpdateStrategy::Relative &&
+         level_strategy.initial_value >= 1)) {
+      break;
+    }
+    level_strategies.push_back(level_strategy);
+    // Same update as in the sequential approach
+    if (level_strategy.update_strategy == UpdateStrategy::Fixed) {
+      level_strategy.initial_value =
+          std::max(level_strategy.initial_value + 1,
+                   std::ceil(level_strategy.initial_value *
+                             level_strategy.update_value));
+    } else {
+      level_strategy.initial_value += level_strategy.update_value;
+    }
+  }
+  level_strategy.iterative_approach = false;
+  level_strategies.push_back(level_strategy);
+
+  const auto num_threads = std::max<size_t>(
+      1, std::thread::hardware_concurrency() / level_strategies.size());
+  PLOGI << "Solving " << level_strategies.size()
+        << " VSS budget levels concurrently using " << num_threads
+        << " threads each";
+
+  auto level_solution_settings          = solution_settings;
+  level_solution_settings.export_option = ExportOption::NoExport;
+
+  const auto shared = std::make_shared<SharedIncumbent>();
+
+  std::vector<std::future<instances::SolVSSGenerationTimetable>> futures;
+  futures.reserve(level_strategies.size());
+  for (const auto& strategy : level_strategies) {
+    futures.push_back(std::async(std::launch::async, [&, strategy]() {
+      VSSGenTimetableSolver solver(instance);
+      solver.shared_incumbent = shared;
+      solver.gurobi_threads   = static_cast<int>(num_threads);
+      auto sol = solver.solve(model_detail, model_settings, strategy,
+                              level_solution_settings, time_limit, debug_input,
+                              false);
+      if (sol.get_status() == SolutionStatus::Optimal) {
+        shared->request_stop();
+      }
+      return sol;
+    }));
+  }
+
+  std::optional<instances::SolVSSGenerationTimetable> sol_object;
+  std::exception_ptr                                  level_exception;
+  bool                                                infeasible = false;
+  for (auto& future : futures) {
+    try {
+      auto sol = future.get();
+      if (sol.get_status() == SolutionStatus::Infeasible) {
+        infeasible = true;
+      }
+      if (sol.has_solution() &&
+          (!sol_object.has_value() || !sol_object->has_solution() ||
+           sol.get_mip_obj() < sol_object->get_mip_obj())) {
+        sol_object = std::move(sol);
+      } else if (!sol_object.has_value()) {
+        sol_object = std::move(sol);
+      }
+    } catch (...) {
+      // Remaining levels are stopped, the exception is rethrown afterwards
+      shared->request_stop();
+      if (level_exception == nullptr) {
+        level_exception = std::current_exception();
+      }
+    }
+  }
+  if (level_exception != nullptr) {
+    std::rethrow_exception(level_exception);
+  }
+
+  if (sol_object->has_solution()) {
+    if (sol_object->get_mip_obj() <= shared->get_lower_bound() + GRB_EPS) {
+      sol_object->set_status(SolutionStatus::Optimal);
+    }
+  } else if (infeasible) {
+    // A level only reports infeasibility once its budget reached the full
+    // model
+    sol_object->set_status(SolutionStatus::Infeasible);
+  } else {
+    sol_object->set_status(SolutionStatus::Timeout);
+  }
+
+  export_option = solution_settings.export_option;
+  export_solution_if_applicable(sol_object, solution_settings);
+
+  return sol_object.value();
+}
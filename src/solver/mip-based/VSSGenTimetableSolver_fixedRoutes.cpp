@@ -193,13 +193,21 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
                          "x_lda_only_if_" + tr_name + "_" + std::to_string(t) +
                              "_" + std::to_string(edge_id));
 
-        // x = x_lda AND x_mu
+        // x = x_lda AND x_mu, where x = 0 if the edge is unreachable
+        if (!sparse_vars["x"].contains(tr, t, edge_id)) {
+          model->addConstr(vars["x_lda"](tr, t, edge_id) +
+                                   vars["x_mu"](tr, t, edge_id) <=
+                               1,
+                           "x_" + tr_name + "_" + std::to_string(t) + "_" +
+                               std::to_string(edge_id));
+          continue;
+        }
         // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
         GRBVar clause[2];
         clause[0] = vars["x_lda"](tr, t, edge_id);
         clause[1] = vars["x_mu"](tr, t, edge_id);
         // NOLINTBEGIN(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
-        model->addGenConstrAnd(vars["x"](tr, t, edge_id), clause, 2,
+        model->addGenConstrAnd(sparse_vars["x"](tr, t, edge_id), clause, 2,
                                "x_" + tr_name + "_" + std::to_string(t) + "_" +
                                    std::to_string(edge_id));
         // NOLINTEND(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
@@ -332,14 +340,16 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
           const auto m1 = mu_ub;
           model->addConstr(vars["mu"](tr, t) - edge_pos.first, GRB_LESS_EQUAL,
                            vars["b_pos"](e_index, vss) +
-                               m1 * (1 - vars["b_front"](tr, t, e_index, vss)),
+                               m1 * (1 - sparse_vars["b_front"](tr, t, e_index,
+                                                                vss)),
                            "b_pos_front_" + std::to_string(tr) + "_" +
                                std::to_string(t) + "_" + std::to_string(e) +
                                "_" + std::to_string(vss));
           if (instance.get_train_list().get_train(tr).tim) {
             const auto m2 = r_len + tr_len + e_len;
             model->addConstr(vars["lda"](tr, t) - edge_pos.first +
-                                 m2 * (1 - vars["b_rear"](tr, t, e_index, vss)),
+                                 m2 * (1 - sparse_vars["b_rear"](tr, t,
+                                                                 e_index, vss)),
                              GRB_GREATER_EQUAL, vars["b_pos"](e_index, vss),
                              "b_pos_rear_" + std::to_string(tr) + "_" +
                                  std::to_string(t) + "_" + std::to_string(e) +
@@ -434,14 +444,16 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
           model->addConstr(vars["mu"](tr, t - 1) - edge_pos.first,
                            GRB_GREATER_EQUAL,
                            vars["b_pos"](i, vss) - STOP_TOLERANCE -
-                               r_len * (1 - vars["b_tight"](tr, t, i, vss)),
+                               r_len *
+                                   (1 - sparse_vars["b_tight"](tr, t, i, vss)),
                            "tight_vss_border_constraint_1_" + tr_name + "_" +
                                std::to_string(t * dt) + "_" + edge_name + "_" +
                                std::to_string(vss));
           model->addConstr(vars["mu"](tr, t - 1) - edge_pos.first,
                            GRB_LESS_EQUAL,
                            vars["b_pos"](i, vss) +
-                               mu_ub * (1 - vars["b_tight"](tr, t, i, vss)),
+                               mu_ub *
+                                   (1 - sparse_vars["b_tight"](tr, t, i, vss)),
                            "tight_vss_border_constraint_2_" + tr_name + "_" +
                                std::to_string(t * dt) + "_" + edge_name + "_" +
                                std::to_string(vss));
@@ -20,14 +20,16 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    * This method creates the variables needed if the routes are not fixed.
    */
 
-  vars["overlap"] = MultiArray<GRBVar>(num_tr, num_t - 1, num_edges);
-  vars["x_v"]     = MultiArray<GRBVar>(num_tr, num_t, num_vertices);
-  vars["len_in"]  = MultiArray<GRBVar>(num_tr, num_t);
-  vars["x_in"]    = MultiArray<GRBVar>(num_tr, num_t);
-  vars["len_out"] = MultiArray<GRBVar>(num_tr, num_t);
-  vars["x_out"]   = MultiArray<GRBVar>(num_tr, num_t);
-  vars["e_lda"]   = MultiArray<GRBVar>(num_tr, num_t, num_edges);
-  vars["e_mu"]    = MultiArray<GRBVar>(num_tr, num_t, num_edges);
+  // Position variables are only stored for reachable combinations
+  sparse_vars["overlap"] =
+      SparseMultiArray<GRBVar>(num_tr, num_t - 1, num_edges);
+  sparse_vars["x_v"]   = SparseMultiArray<GRBVar>(num_tr, num_t, num_vertices);
+  vars["len_in"]       = MultiArray<GRBVar>(num_tr, num_t);
+  vars["x_in"]         = MultiArray<GRBVar>(num_tr, num_t);
+  vars["len_out"]      = MultiArray<GRBVar>(num_tr, num_t);
+  vars["x_out"]        = MultiArray<GRBVar>(num_tr, num_t);
+  sparse_vars["e_lda"] = SparseMultiArray<GRBVar>(num_tr, num_t, num_edges);
+  sparse_vars["e_mu"]  = SparseMultiArray<GRBVar>(num_tr, num_t, num_edges);
 
   const auto& train_list = instance.get_train_list();
   for (size_t tr = 0; tr < num_tr; ++tr) {
@@ -40,27 +42,36 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
          ++t) {
       for (size_t e = 0; e < num_edges; ++e) {
+        // No variables are created if the edge cannot be occupied
+        const bool reachable = is_reachable(tr, t, e);
+        const bool overlap_reachable = reachable && is_reachable(tr, t + 1, e);
+        if (!reachable) {
+          continue;
+        }
         const auto& edge = instance.n().get_edge(e);
         const auto& edge_name =
             "[" + instance.n().get_vertex(edge.source).name + "," +
             instance.n().get_vertex(edge.target).name + "]";
-        if (t < train_interval[tr].second) {
-          vars["overlap"](tr, t, e) = model->addVar(
+        if (t < train_interval[tr].second && overlap_reachable) {
+          sparse_vars["overlap"](tr, t, e) = model->addVar(
               0, instance.n().get_edge(e).length, 0, GRB_CONTINUOUS,
               "overlap_" + tr_name + "_" + std::to_string(t * dt) + "_" +
                   edge_name);
         }
-        vars["e_lda"](tr, t, e) =
+        sparse_vars["e_lda"](tr, t, e) =
             model->addVar(0, instance.n().get_edge(e).length, 0, GRB_CONTINUOUS,
                           "e_lda_" + tr_name + "_" + std::to_string(t * dt) +
                               "_" + edge_name);
-        vars["e_mu"](tr, t, e) = model->addVar(
+        sparse_vars["e_mu"](tr, t, e) = model->addVar(
             0, instance.n().get_edge(e).length, 0, GRB_CONTINUOUS,
             "e_mu_" + tr_name + "_" + std::to_string(t * dt) + "_" + edge_name);
       }
       for (size_t v = 0; v < num_vertices; ++v) {
-        const auto& v_name    = instance.n().get_vertex(v).name;
-        vars["x_v"](tr, t, v) = model->addVar(
+        if (!is_vertex_reachable(tr, t, v)) {
+          continue;
+        }
+        const auto& v_name           = instance.n().get_vertex(v).name;
+        sparse_vars["x_v"](tr, t, v) = model->addVar(
             0, 1, 0, GRB_BINARY,
             "x_v_" + tr_name + "_" + std::to_string(t * dt) + "_" + v_name);
       }
@@ -114,7 +125,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       // v(t+1))/2 * dt + brakelen (if applicable)
       GRBLinExpr lhs = vars["len_in"](tr, t) + vars["len_out"](tr, t);
       for (size_t e = 0; e < num_edges; ++e) {
-        lhs += vars["e_mu"](tr, t, e) - vars["e_lda"](tr, t, e);
+        lhs += pruned_var("e_mu", tr, t, e) - pruned_var("e_lda", tr, t, e);
       }
       GRBLinExpr rhs =
           tr_len + (vars["v"](tr, t) + vars["v"](tr, t + 1)) * dt / 2;
@@ -129,16 +140,20 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       // x_v >= sum_(e in delta_in_v) x_e
       // x_v >= sum_(e in delta_out_v) x_e
       for (size_t v = 0; v < num_vertices; ++v) {
+        if (!is_vertex_reachable(tr, t, v)) {
+          // All incident edges are unreachable, hence, trivially satisfied
+          continue;
+        }
         const auto out_edges = instance.n().out_edges(v);
         const auto in_edges  = instance.n().in_edges(v);
-        lhs                  = vars["x_v"](tr, t, v);
+        lhs                  = pruned_var("x_v", tr, t, v);
         GRBLinExpr rhs_in    = 0;
         GRBLinExpr rhs_out   = 0;
         for (const auto& e : out_edges) {
-          rhs_out += vars["x"](tr, t, e);
+          rhs_out += pruned_var("x", tr, t, e);
         }
         for (const auto& e : in_edges) {
-          rhs_in += vars["x"](tr, t, e);
+          rhs_in += pruned_var("x", tr, t, e);
         }
         if (v == exit) {
           rhs_out += vars["x_out"](tr, t);
@@ -161,10 +176,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       lhs = 0;
       rhs = -1;
       for (size_t e = 0; e < num_edges; ++e) {
-        lhs += vars["x"](tr, t, e);
+        lhs += pruned_var("x", tr, t, e);
       }
       for (size_t v = 0; v < num_vertices; ++v) {
-        rhs += vars["x_v"](tr, t, v);
+        rhs += pruned_var("x_v", tr, t, v);
       }
       model->addConstr(lhs, GRB_EQUAL, rhs,
                        "train_pos_simple_connected_path_" + tr_name + "_" +
@@ -179,35 +194,41 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         for (const auto& e2 : out_edges) {
           if (t < train_interval[tr].second &&
               instance.n().is_valid_successor(e1, e2)) {
+            if (!is_reachable(tr, t + 1, e1)) {
+              continue;
+            }
             // Prohibit train going backwards
             // x_e1(t+1) <= x_e1(t) + (1-x_e2(t))
-            model->addConstr(vars["x"](tr, t + 1, e1), GRB_LESS_EQUAL,
-                             vars["x"](tr, t, e1) + (1 - vars["x"](tr, t, e2)),
+            model->addConstr(pruned_var("x", tr, t + 1, e1), GRB_LESS_EQUAL,
+                             pruned_var("x", tr, t, e1) +
+                                 (1 - pruned_var("x", tr, t, e2)),
                              "train_pos_no_backwards_" + tr_name + "_" +
                                  std::to_string(t) + "_" + std::to_string(e1) +
                                  "_" + std::to_string(e2));
-          } else if (!instance.n().is_valid_successor(e1, e2)) {
+          } else if (!instance.n().is_valid_successor(e1, e2) &&
+                     is_reachable(tr, t, e1) && is_reachable(tr, t, e2)) {
             // Prohibit illegal movement
             // x_e1 + x_e2 <= 1
             model->addConstr(
-                vars["x"](tr, t, e1) + vars["x"](tr, t, e2), GRB_LESS_EQUAL, 1,
+                pruned_var("x", tr, t, e1) + pruned_var("x", tr, t, e2),
+                GRB_LESS_EQUAL, 1,
                 "train_pos_switches_" + tr_name + "_" + std::to_string(t) +
                     "_" + std::to_string(e1) + "_" + std::to_string(e2));
           }
         }
 
         // Only going forward on edge
-        if (t < train_interval[tr].second) {
+        if (t < train_interval[tr].second && is_reachable(tr, t, e1)) {
           // e_lda(t) <= e_lda(t+1) + e_len * (1 - x_e(t+1))
           // e_mu(t) <= e_mu(t+1) + e_len * (1 - x_e(t+1))
-          model->addConstr(vars["e_lda"](tr, t, e1), GRB_LESS_EQUAL,
-                           vars["e_lda"](tr, t + 1, e1) +
-                               e_len * (1 - vars["x"](tr, t + 1, e1)),
+          model->addConstr(pruned_var("e_lda", tr, t, e1), GRB_LESS_EQUAL,
+                           pruned_var("e_lda", tr, t + 1, e1) +
+                               e_len * (1 - pruned_var("x", tr, t + 1, e1)),
                            "train_pos_e_lda_" + tr_name + "_" +
                                std::to_string(t) + "_" + std::to_string(e1));
-          model->addConstr(vars["e_mu"](tr, t, e1), GRB_LESS_EQUAL,
-                           vars["e_mu"](tr, t + 1, e1) +
-                               e_len * (1 - vars["x"](tr, t + 1, e1)),
+          model->addConstr(pruned_var("e_mu", tr, t, e1), GRB_LESS_EQUAL,
+                           pruned_var("e_mu", tr, t + 1, e1) +
+                               e_len * (1 - pruned_var("x", tr, t + 1, e1)),
                            "train_pos_e_mu_" + tr_name + "_" +
                                std::to_string(t) + "_" + std::to_string(e1));
         }
@@ -245,7 +266,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       // Train cannot be solely on the exit edge
       GRBLinExpr lhs = vars["x_in"](tr, t);
       for (size_t e = 0; e < num_edges; ++e) {
-        lhs += vars["x"](tr, t, e);
+        lhs += pruned_var("x", tr, t, e);
       }
       // lhs >= 1
       model->addConstr(lhs, GRB_GREATER_EQUAL, 1,
@@ -255,7 +276,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       // Correct overlap length
       lhs = vars["len_in"](tr, t + 1) + vars["len_out"](tr, t);
       for (size_t e = 0; e < num_edges; ++e) {
-        lhs += vars["overlap"](tr, t, e);
+        lhs += pruned_var("overlap", tr, t, e);
       }
       GRBLinExpr rhs = tr_len;
       if (this->include_braking_curves) {
@@ -272,28 +293,46 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         const auto& out_edges = instance.n().out_edges(e_v1);
         const auto& e_len     = instance.n().get_edge(e).length;
 
+        // overlap <= e_mu(t) - e_lda(t+1)
+        if (is_reachable(tr, t + 1, e)) {
+          model->addConstr(
+              pruned_var("overlap", tr, t, e), GRB_LESS_EQUAL,
+              pruned_var("e_mu", tr, t, e) - pruned_var("e_lda", tr, t + 1, e),
+              "train_pos_overlap_e_ub_" + tr_name + "_" + std::to_string(t) +
+                  "_" + std::to_string(e));
+        }
+        if (e_v0 == entry && is_reachable(tr, t, e)) {
+          // len_in <= tr_len * overlap_e + tr_len * (1 - x_e)
+          model->addConstr(vars["len_in"](tr, t), GRB_LESS_EQUAL,
+                           tr_len * pruned_var("overlap", tr, t, e) +
+                               tr_len * (1 - pruned_var("x", tr, t, e)),
+                           "train_pos_overlap_at_front_" + tr_name + "_" +
+                               std::to_string(t) + "_len_in" +
+                               std::to_string(e));
+        }
+        if (!is_reachable(tr, t, e) || !is_reachable(tr, t + 1, e)) {
+          // Overlap is zero, the remaining constraints are trivially satisfied
+          continue;
+        }
+
         // overlap >= e_mu(t) - e_lda(t+1) if e is occupied at t+1, i.e.,
         // overlap_e + e_len * (1 - x_e(t+1)) >= e_mu(t) - e_lda(t+1)
-        model->addConstr(vars["overlap"](tr, t, e) +
-                             e_len * (1 - vars["x"](tr, t + 1, e)),
+        model->addConstr(pruned_var("overlap", tr, t, e) +
+                             e_len * (1 - pruned_var("x", tr, t + 1, e)),
                          GRB_GREATER_EQUAL,
-                         vars["e_mu"](tr, t, e) - vars["e_lda"](tr, t + 1, e),
+                         pruned_var("e_mu", tr, t, e) -
+                             pruned_var("e_lda", tr, t + 1, e),
                          "train_pos_overlap_e_lb_" + tr_name + "_" +
                              std::to_string(t) + "_" + std::to_string(e));
-        // overlap <= e_mu(t) - e_lda(t+1)
-        model->addConstr(vars["overlap"](tr, t, e), GRB_LESS_EQUAL,
-                         vars["e_mu"](tr, t, e) - vars["e_lda"](tr, t + 1, e),
-                         "train_pos_overlap_e_ub_" + tr_name + "_" +
-                             std::to_string(t) + "_" + std::to_string(e));
 
         // overlap <= e_len * x_e(t)
         // overlap <= e_len * x_e(t+1)
-        model->addConstr(vars["overlap"](tr, t, e), GRB_LESS_EQUAL,
-                         e_len * vars["x"](tr, t, e),
+        model->addConstr(pruned_var("overlap", tr, t, e), GRB_LESS_EQUAL,
+                         e_len * pruned_var("x", tr, t, e),
                          "train_pos_overlap_e_t_" + tr_name + "_" +
                              std::to_string(t) + "_" + std::to_string(e));
-        model->addConstr(vars["overlap"](tr, t, e), GRB_LESS_EQUAL,
-                         e_len * vars["x"](tr, t + 1, e),
+        model->addConstr(pruned_var("overlap", tr, t, e), GRB_LESS_EQUAL,
+                         e_len * pruned_var("x", tr, t + 1, e),
                          "train_pos_overlap_e_tp1_" + tr_name + "_" +
                              std::to_string(t) + "_" + std::to_string(e));
 
@@ -301,26 +340,17 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         for (const auto& e2 : out_edges) {
           if (instance.n().is_valid_successor(e, e2)) {
             // overlap_e <= e_len * overlap_e2 + e_len * (1 - x_e2)
-            model->addConstr(vars["overlap"](tr, t, e), GRB_LESS_EQUAL,
-                             e_len * vars["overlap"](tr, t, e2) +
-                                 e_len * (1 - vars["x"](tr, t, e2)),
+            model->addConstr(pruned_var("overlap", tr, t, e), GRB_LESS_EQUAL,
+                             e_len * pruned_var("overlap", tr, t, e2) +
+                                 e_len * (1 - pruned_var("x", tr, t, e2)),
                              "train_pos_overlap_at_front_" + tr_name + "_" +
                                  std::to_string(t) + "_" + std::to_string(e) +
                                  "_" + std::to_string(e2));
           }
         }
-        if (e_v0 == entry) {
-          // len_in <= tr_len * overlap_e + tr_len * (1 - x_e)
-          model->addConstr(vars["len_in"](tr, t), GRB_LESS_EQUAL,
-                           tr_len * vars["overlap"](tr, t, e) +
-                               tr_len * (1 - vars["x"](tr, t, e)),
-                           "train_pos_overlap_at_front_" + tr_name + "_" +
-                               std::to_string(t) + "_len_in" +
-                               std::to_string(e));
-        }
         if (e_v1 == exit) {
           // overlap_e <= e_len * len_out + e_len * (1 - x_out)
-          model->addConstr(vars["overlap"](tr, t, e), GRB_LESS_EQUAL,
+          model->addConstr(pruned_var("overlap", tr, t, e), GRB_LESS_EQUAL,
                            e_len * vars["len_out"](tr, t) +
                                e_len * (1 - vars["x_out"](tr, t)),
                            "train_pos_overlap_at_front_" + tr_name + "_" +
@@ -378,22 +408,29 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       const auto& e_len     = instance.n().get_edge(e).length;
       for (size_t t = train_interval[tr].first; t <= train_interval[tr].second;
            ++t) {
-        // e_lda <= e_mu
-        model->addConstr(vars["e_lda"](tr, t, e), GRB_LESS_EQUAL,
-                         vars["e_mu"](tr, t, e),
-                         "train_occupation_free_routes_mu_lda_" + tr_name +
-                             "_" + std::to_string(t) + "_" + std::to_string(e));
-        // e_mu <= e_len * x
-        model->addConstr(vars["e_mu"](tr, t, e), GRB_LESS_EQUAL,
-                         e_len * vars["x"](tr, t, e),
-                         "train_occupation_free_routes_mu_x_" + tr_name + "_" +
-                             std::to_string(t) + "_" + std::to_string(e));
+        // x, e_lda and e_mu are zero if the edge is unreachable
+        const bool reachable = is_reachable(tr, t, e);
+
+        if (reachable) {
+          // e_lda <= e_mu
+          model->addConstr(pruned_var("e_lda", tr, t, e), GRB_LESS_EQUAL,
+                           pruned_var("e_mu", tr, t, e),
+                           "train_occupation_free_routes_mu_lda_" + tr_name +
+                               "_" + std::to_string(t) + "_" +
+                               std::to_string(e));
+          // e_mu <= e_len * x
+          model->addConstr(pruned_var("e_mu", tr, t, e), GRB_LESS_EQUAL,
+                           e_len * pruned_var("x", tr, t, e),
+                           "train_occupation_free_routes_mu_x_" + tr_name +
+                               "_" + std::to_string(t) + "_" +
+                               std::to_string(e));
+        }
 
         // e_mu = e_len if not last edge, i.e.,
         // e_mu + e_len*(1-x) >= e_len * sum_outedges x
         GRBLinExpr rhs = 0;
         for (const auto& e2 : out_edges) {
-          rhs += vars["x"](tr, t, e2);
+          rhs += pruned_var("x", tr, t, e2);
         }
         if (e_v1 == exit) {
           // exit is an out-edge of the last edge
@@ -401,16 +438,17 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         }
         rhs *= e_len;
         model->addConstr(
-            vars["e_mu"](tr, t, e) + e_len * (1 - vars["x"](tr, t, e)),
+            pruned_var("e_mu", tr, t, e) +
+                e_len * (1 - pruned_var("x", tr, t, e)),
             GRB_GREATER_EQUAL, rhs,
             "train_occupation_free_routes_mu_1_if_not_last_edge_" + tr_name +
                 "_" + std::to_string(t) + "_" + std::to_string(e));
 
         // e_lda = 0 if not first edge, i.e.,
         // e_lda <= e_len * (1 - sum_inedges x) + e_len * (1-x)
-        rhs = 2 - vars["x"](tr, t, e);
+        rhs = 2 - pruned_var("x", tr, t, e);
         for (const auto& e2 : in_edges) {
-          rhs -= vars["x"](tr, t, e2);
+          rhs -= pruned_var("x", tr, t, e2);
         }
         if (e_v0 == entry) {
           // entry is an in-edge of the first edge
@@ -418,17 +456,20 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         }
         rhs *= e_len;
         model->addConstr(
-            vars["e_lda"](tr, t, e), GRB_LESS_EQUAL, rhs,
+            pruned_var("e_lda", tr, t, e), GRB_LESS_EQUAL, rhs,
             "train_occupation_free_routes_lda_0_if_not_first_edge_" + tr_name +
                 "_" + std::to_string(t) + "_" + std::to_string(e));
 
         // x = 0 if mu=lda, i.e.,
         // x <= e_mu - e_lda
-        model->addConstr(vars["x"](tr, t, e), GRB_LESS_EQUAL,
-                         vars["e_mu"](tr, t, e) - vars["e_lda"](tr, t, e),
-                         "train_occupation_free_routes_x_0_if_mu_lda_" +
-                             tr_name + "_" + std::to_string(t) + "_" +
-                             std::to_string(e));
+        if (reachable) {
+          model->addConstr(pruned_var("x", tr, t, e), GRB_LESS_EQUAL,
+                           pruned_var("e_mu", tr, t, e) -
+                               pruned_var("e_lda", tr, t, e),
+                           "train_occupation_free_routes_x_0_if_mu_lda_" +
+                               tr_name + "_" + std::to_string(t) + "_" +
+                               std::to_string(e));
+        }
       }
     }
 
@@ -518,14 +559,14 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         if (dist_travelled_before < dist_before) {
           // Edge cannot be reached, i.e. x = 0
           model->addConstr(
-              vars["x"](tr, t, e), GRB_EQUAL, 0,
+              pruned_var("x", tr, t, e), GRB_EQUAL, 0,
               "train_occupation_free_routes_impossibility_before_var1_" +
                   tr_name + "_" + std::to_string(t) + "_" + std::to_string(e));
         } else if (dist_travelled_before < dist_before + e_len) {
           // Edge can be reached, but not fully, i.e.
           // e_mu <= dist_travelled_before - dist_before
           model->addConstr(
-              vars["e_mu"](tr, t, e), GRB_LESS_EQUAL,
+              pruned_var("e_mu", tr, t, e), GRB_LESS_EQUAL,
               dist_travelled_before - dist_before,
               "train_occupation_free_routes_impossibility_before_var2_" +
                   tr_name + "_" + std::to_string(t) + "_" + std::to_string(e));
@@ -549,16 +590,16 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         if (dist_travelled_after < dist_after) {
           // Destination is unreachable from edge, hence not possible and x = 0
           model->addConstr(
-              vars["x"](tr, t, e), GRB_EQUAL, 0,
+              pruned_var("x", tr, t, e), GRB_EQUAL, 0,
               "train_occupation_free_routes_impossibility_after_var1_" +
                   tr_name + "_" + std::to_string(t) + "_" + std::to_string(e));
         } else if (dist_travelled_after < dist_after + e_len) {
           // Destination is reachable, but not from full edge, i.e.,
           // e_lda >= (e_len - (dist_travelled_after - dist_after))*x
           model->addConstr(
-              vars["e_lda"](tr, t, e), GRB_GREATER_EQUAL,
+              pruned_var("e_lda", tr, t, e), GRB_GREATER_EQUAL,
               (e_len - (dist_travelled_after - dist_after)) *
-                  vars["x"](tr, t, e),
+                  pruned_var("x", tr, t, e),
               "train_occupation_free_routes_impossibility_after_var2_" +
                   tr_name + "_" + std::to_string(t) + "_" + std::to_string(e));
         }
@@ -586,9 +627,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
           // e_mu(e) <= b_pos(e_index) + M1 * (1 - b_front(e_index))
           const auto m1 = e_len;
           model->addConstr(
-              vars["e_mu"](tr, t, e), GRB_LESS_EQUAL,
+              pruned_var("e_mu", tr, t, e), GRB_LESS_EQUAL,
               vars["b_pos"](e_index, vss) +
-                  m1 * (1 - vars["b_front"](tr, t, e_index, vss)),
+                  m1 *
+                      (1 - sparse_vars["b_front"](tr, t, e_index, vss)),
               "train_occupation_free_routes_vss_lda_b_pos_b_front_" + tr_name +
                   "_" + std::to_string(t) + "_" + std::to_string(e) + "_" +
                   std::to_string(vss));
@@ -597,8 +639,9 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
             const auto m2 = e_len;
             model->addConstr(
                 vars["b_pos"](e_index, vss), GRB_LESS_EQUAL,
-                vars["e_lda"](tr, t, e) +
-                    m2 * (1 - vars["b_rear"](tr, t, e_index, vss)),
+                pruned_var("e_lda", tr, t, e) +
+                    m2 *
+                        (1 - sparse_vars["b_rear"](tr, t, e_index, vss)),
                 "train_occupation_free_routes_vss_b_pos_mu_b_rear_" + tr_name +
                     "_" + std::to_string(t) + "_" + std::to_string(e) + "_" +
                     std::to_string(vss));
@@ -692,15 +735,17 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         const auto& tr_name = instance.get_train_list().get_train(tr).name;
         for (size_t t = train_interval[tr].first + 2;
              t <= train_interval[tr].second; ++t) {
-          model->addConstr(vars["e_mu"](tr, t - 1, e), GRB_GREATER_EQUAL,
+          model->addConstr(pruned_var("e_mu", tr, t - 1, e), GRB_GREATER_EQUAL,
                            vars["b_pos"](i, vss) - STOP_TOLERANCE -
-                               e_len * (1 - vars["b_tight"](tr, t, i, vss)),
+                               e_len *
+                                   (1 - sparse_vars["b_tight"](tr, t, i, vss)),
                            "tight_vss_border_constraint_1_" + tr_name + "_" +
                                std::to_string(t * dt) + "_" + edge_name + "_" +
                                std::to_string(vss));
-          model->addConstr(vars["e_mu"](tr, t - 1, e), GRB_LESS_EQUAL,
+          model->addConstr(pruned_var("e_mu", tr, t - 1, e), GRB_LESS_EQUAL,
                            vars["b_pos"](i, vss) +
-                               e_len * (1 - vars["b_tight"](tr, t, i, vss)),
+                               e_len *
+                                   (1 - sparse_vars["b_tight"](tr, t, i, vss)),
                            "tight_vss_border_constraint_2_" + tr_name + "_" +
                                std::to_string(t * dt) + "_" + edge_name + "_" +
                                std::to_string(vss));
@@ -720,7 +765,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       const auto& tr_name = instance.get_train_list().get_train(tr).name;
       for (size_t t = train_interval[tr].first + 2;
            t <= train_interval[tr].second; ++t) {
-        model->addConstr(vars["e_mu"](tr, t - 1, e), GRB_GREATER_EQUAL,
+        model->addConstr(pruned_var("e_mu", tr, t - 1, e), GRB_GREATER_EQUAL,
                          e_len * vars["e_tight"](tr, t, e) - STOP_TOLERANCE,
                          "tight_ttd_border_constraint_" + tr_name + "_" +
                              std::to_string(t * dt) + "_" + edge_name);
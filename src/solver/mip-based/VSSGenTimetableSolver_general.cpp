@@ -113,6 +113,12 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::solve(
    * - update_value: Specify the update value or fraction to use. Only relevant
    * if iterative approach is used. In case of fixed update, the value has to be
    * greater than 1, otherwise between 0 and 1. Default: 2
+   * - include_cuts: If true, cuts are added to enforce the use of additional
+   * VSS in the next iteration. Only relevant if iterative approach is used.
+   * Default: true
+   * - parallel_budget_levels: Number of VSS budget levels that are solved
+   * concurrently, each as its own model. Only relevant if iterative approach
+   * is used. Default: 1, i.e., the levels are solved sequentially
    *
    * @param solution_settings: Specify information on the solution, namely
    * - postprocess: If true, the solution is postprocessed to remove potentially
@@ -134,6 +140,14 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::solve(
    * @return Solution object containing status, objective value, and solution
    */
 
+  if (solver_strategy.iterative_approach &&
+      solver_strategy.parallel_budget_levels > 1) {
+    return solve_parallel_budget_levels(model_detail, model_settings,
+                                        solver_strategy, solution_settings,
+                                        time_limit, debug_input,
+                                        overwrite_severity);
+  }
+
   auto old_instance = initialize_variables(
       model_detail, model_settings, solver_strategy, solution_settings,
       time_limit, debug_input, overwrite_severity);
@@ -166,7 +180,8 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
    */
 
   vars["v"] = MultiArray<GRBVar>(num_tr, num_t + 1);
-  vars["x"] = MultiArray<GRBVar>(num_tr, num_t, num_edges);
+  // Only stored for reachable combinations
+  sparse_vars["x"] = SparseMultiArray<GRBVar>(num_tr, num_t, num_edges);
   vars["x_sec"] =
       MultiArray<GRBVar>(num_tr, num_t, unbreakable_sections.size());
   vars["y_sec_fwd"] = MultiArray<GRBVar>(num_t, fwd_bwd_sections.size());
@@ -190,11 +205,14 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
          ++t) {
       for (auto const edge_id :
            instance.edges_used_by_train(tr_name, fix_routes)) {
+        if (!is_reachable(i, t, edge_id)) {
+          continue;
+        }
         const auto& edge = instance.n().get_edge(edge_id);
         const auto& edge_name =
             "[" + instance.n().get_vertex(edge.source).name + "," +
             instance.n().get_vertex(edge.target).name + "]";
-        vars["x"](i, t, edge_id) = model->addVar(
+        sparse_vars["x"](i, t, edge_id) = model->addVar(
             0, 1, 0, GRB_BINARY,
             "x_" + tr_name + "_" + std::to_string(t * dt) + "_" + edge_name);
       }
@@ -245,10 +263,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
   }
 
   vars["b_pos"] = MultiArray<GRBVar>(num_breakable_sections, max_vss);
-  vars["b_front"] =
-      MultiArray<GRBVar>(num_tr, num_t, num_breakable_sections, max_vss);
-  vars["b_rear"] =
-      MultiArray<GRBVar>(num_tr, num_t, num_breakable_sections, max_vss);
+  sparse_vars["b_front"] = SparseMultiArray<GRBVar>(
+      num_tr, num_t, num_breakable_sections, max_vss);
+  sparse_vars["b_rear"] = SparseMultiArray<GRBVar>(
+      num_tr, num_t, num_breakable_sections, max_vss);
 
   if (this->vss_model.get_model_type() == vss::ModelType::Inferred) {
     vars["num_vss_segments"]  = MultiArray<GRBVar>(relevant_edges.size());
@@ -289,12 +307,12 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       for (const size_t tr : instance.trains_on_edge(e, this->fix_routes)) {
         for (size_t t = train_interval[tr].first;
              t <= train_interval[tr].second; ++t) {
-          vars["b_front"](tr, t, i, vss) = model->addVar(
+          sparse_vars["b_front"](tr, t, i, vss) = model->addVar(
               0, 1, 0, GRB_BINARY,
               "b_front_" + std::to_string(tr) + "_" + std::to_string(t * dt) +
                   "_" + edge_name + "_" + std::to_string(vss));
           if (instance.get_train_list().get_train(tr).tim) {
-            vars["b_rear"](tr, t, i, vss) = model->addVar(
+            sparse_vars["b_rear"](tr, t, i, vss) = model->addVar(
                 0, 1, 0, GRB_BINARY,
                 "b_rear_" + std::to_string(tr) + "_" + std::to_string(t * dt) +
                     "_" + edge_name + "_" + std::to_string(vss));
@@ -379,8 +397,8 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
     max_vss = std::max(max_vss, instance.n().max_vss_on_edge(e));
   }
 
-  vars["b_tight"] =
-      MultiArray<GRBVar>(num_tr, num_t, num_breakable_sections, max_vss);
+  sparse_vars["b_tight"] = SparseMultiArray<GRBVar>(
+      num_tr, num_t, num_breakable_sections, max_vss);
   vars["e_tight"] = MultiArray<GRBVar>(num_tr, num_t, num_edges);
 
   for (size_t i = 0; i < breakable_edges.size(); ++i) {
@@ -395,7 +413,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         const auto& tr_name = instance.get_train_list().get_train(tr).name;
         for (size_t t = train_interval[tr].first + 2;
              t <= train_interval[tr].second; ++t) {
-          vars["b_tight"](tr, t, i, vss) = model->addVar(
+          sparse_vars["b_tight"](tr, t, i, vss) = model->addVar(
               0, 1, 0, GRB_BINARY,
               "b_tight_" + tr_name + "_" + std::to_string(t * dt) + "_" +
                   edge_name + "_" + std::to_string(vss));
@@ -503,31 +521,39 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
               GRBLinExpr lhs_second = 0;
               if (tr1_route.contains_edge(
                       no_border_vss_section_sorted[e1].first)) {
-                lhs -= vars["x"](
-                    tr1, t, no_border_vss_section_sorted[e1].first.value());
-                lhs_first += vars["x"](
-                    tr1, t, no_border_vss_section_sorted[e1].first.value());
+                lhs -= pruned_var(
+                    "x", tr1, t,
+                    no_border_vss_section_sorted[e1].first.value());
+                lhs_first += pruned_var(
+                    "x", tr1, t,
+                    no_border_vss_section_sorted[e1].first.value());
               }
               if (tr1_route.contains_edge(
                       no_border_vss_section_sorted[e1].second)) {
-                lhs -= vars["x"](
-                    tr1, t, no_border_vss_section_sorted[e1].second.value());
-                lhs_second += vars["x"](
-                    tr1, t, no_border_vss_section_sorted[e1].second.value());
+                lhs -= pruned_var(
+                    "x", tr1, t,
+                    no_border_vss_section_sorted[e1].second.value());
+                lhs_second += pruned_var(
+                    "x", tr1, t,
+                    no_border_vss_section_sorted[e1].second.value());
               }
               if (tr2_route.contains_edge(
                       no_border_vss_section_sorted[e2].first)) {
-                lhs -= vars["x"](
-                    tr2, t, no_border_vss_section_sorted[e2].first.value());
-                lhs_first += vars["x"](
-                    tr2, t, no_border_vss_section_sorted[e2].first.value());
+                lhs -= pruned_var(
+                    "x", tr2, t,
+                    no_border_vss_section_sorted[e2].first.value());
+                lhs_first += pruned_var(
+                    "x", tr2, t,
+                    no_border_vss_section_sorted[e2].first.value());
               }
               if (tr2_route.contains_edge(
                       no_border_vss_section_sorted[e2].second)) {
-                lhs -= vars["x"](
-                    tr2, t, no_border_vss_section_sorted[e2].second.value());
-                lhs_second += vars["x"](
-                    tr2, t, no_border_vss_section_sorted[e2].second.value());
+                lhs -= pruned_var(
+                    "x", tr2, t,
+                    no_border_vss_section_sorted[e2].second.value());
+                lhs_second += pruned_var(
+                    "x", tr2, t,
+                    no_border_vss_section_sorted[e2].second.value());
               }
 
               for (size_t e_overlap = std::min(e1, e2);
@@ -623,7 +649,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         int        count = 0;
         for (auto const e_index : sec) {
           if (tr_route.contains_edge(e_index)) {
-            lhs += vars["x"](tr, t, e_index);
+            lhs += pruned_var("x", tr, t, e_index);
             count++;
           }
         }
@@ -682,7 +708,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         if (t >= t0 && t < t1) { // because otherwise the front corresponds to
                                  // t1+dt which is allowed outside
           for (auto const e : inverse_stop_edges) {
-            model->addConstr(vars["x"](tr, t, e) == 0,
+            if (!sparse_vars["x"].contains(tr, t, e)) {
+              continue;
+            }
+            model->addConstr(sparse_vars["x"](tr, t, e) == 0,
                              "station_x_" + tr_name + "_" + std::to_string(t) +
                                  "_" + std::to_string(e));
           }
@@ -693,7 +722,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         for (auto const e : stop_edges) {
           // If e in tr_edges
           if (std::ranges::contains(tr_edges, e)) {
-            lhs += vars["x"](tr, t, e);
+            lhs += pruned_var("x", tr, t, e);
           }
         }
         model->addConstr(lhs >= 1, "station_occupancy_" + tr_name + "_" +
@@ -877,15 +906,15 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
            ++t) {
         for (size_t vss = 0; vss < vss_number_e; ++vss) {
           // x(tr,t,e) >= b_front(tr,t,e_index,vss)
-          model->addConstr(vars["x"](tr, t, e), GRB_GREATER_EQUAL,
-                           vars["b_front"](tr, t, e_index, vss),
+          model->addConstr(pruned_var("x", tr, t, e), GRB_GREATER_EQUAL,
+                           sparse_vars["b_front"](tr, t, e_index, vss),
                            "x_b_front_" + std::to_string(tr) + "_" +
                                std::to_string(t) + "_" + std::to_string(e) +
                                "_" + std::to_string(vss));
           // x(tr,t,e) >= b_rear(tr,t,e_index,vss)
           if (instance.get_train_list().get_train(tr).tim) {
-            model->addConstr(vars["x"](tr, t, e), GRB_GREATER_EQUAL,
-                             vars["b_rear"](tr, t, e_index, vss),
+            model->addConstr(pruned_var("x", tr, t, e), GRB_GREATER_EQUAL,
+                             sparse_vars["b_rear"](tr, t, e_index, vss),
                              "x_b_rear_" + std::to_string(tr) + "_" +
                                  std::to_string(t) + "_" + std::to_string(e) +
                                  "_" + std::to_string(vss));
@@ -911,12 +940,12 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
            instance.trains_at_t(static_cast<int>(t) * dt, tr_on_e)) {
         create_constraint = true;
         for (size_t vss = 0; vss < vss_number_e; ++vss) {
-          lhs_front += vars["b_front"](tr, t, e_index, vss);
+          lhs_front += sparse_vars["b_front"](tr, t, e_index, vss);
           if (instance.get_train_list().get_train(tr).tim) {
-            lhs_rear += vars["b_rear"](tr, t, e_index, vss);
+            lhs_rear += sparse_vars["b_rear"](tr, t, e_index, vss);
           }
         }
-        rhs += vars["x"](tr, t, e);
+        rhs += pruned_var("x", tr, t, e);
       }
       if (create_constraint) {
         model->addConstr(lhs_front, GRB_GREATER_EQUAL, rhs,
@@ -946,9 +975,9 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         const auto& e_index      = breakable_edge_indices[e];
         const auto  vss_number_e = instance.n().max_vss_on_edge(e);
         for (size_t vss = 0; vss < vss_number_e; ++vss) {
-          lhs_front += vars["b_front"](tr, t, e_index, vss);
+          lhs_front += sparse_vars["b_front"](tr, t, e_index, vss);
           if (instance.get_train_list().get_train(tr).tim) {
-            lhs_rear += vars["b_rear"](tr, t, e_index, vss);
+            lhs_rear += sparse_vars["b_rear"](tr, t, e_index, vss);
           }
         }
       }
@@ -974,9 +1003,9 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         GRBLinExpr rhs = 0;
         for (const auto& tr :
              instance.trains_at_t(static_cast<int>(t) * dt, tr_on_e)) {
-          lhs += vars["b_front"](tr, t, e_index, vss);
+          lhs += sparse_vars["b_front"](tr, t, e_index, vss);
           if (instance.get_train_list().get_train(tr).tim) {
-            rhs += vars["b_rear"](tr, t, e_index, vss);
+            rhs += sparse_vars["b_rear"](tr, t, e_index, vss);
           }
         }
         model->addConstr(lhs, GRB_EQUAL, rhs,
@@ -1015,7 +1044,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         for (size_t vss = 0; vss < vss_number_e; ++vss) {
           if (vss_model.get_model_type() == vss::ModelType::Continuous) {
             // b_front(tr, t, e_index, vss) <= b_used(e_index_relevant, vss)
-            model->addConstr(vars["b_front"](tr, t, e_index, vss),
+            model->addConstr(sparse_vars["b_front"](tr, t, e_index, vss),
                              GRB_LESS_EQUAL,
                              vars["b_used"](e_index_relevant, vss),
                              "b_front_b_used_" + std::to_string(tr) + "_" +
@@ -1023,7 +1052,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
                                  "_" + std::to_string(vss));
             // b_rear(tr, t, e_index, vss) <= b_used(e_index_relevant, vss)
             if (instance.get_train_list().get_train(tr).tim) {
-              model->addConstr(vars["b_rear"](tr, t, e_index, vss),
+              model->addConstr(sparse_vars["b_rear"](tr, t, e_index, vss),
                                GRB_LESS_EQUAL,
                                vars["b_used"](e_index_relevant, vss),
                                "b_rear_b_used_" + std::to_string(tr) + "_" +
@@ -1033,7 +1062,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
           } else if (vss_model.get_model_type() == vss::ModelType::Inferred) {
             // b_front(tr, t, e_index, vss) <=
             // (num_vss_segments(e_index_relevant) - 1) / (vss + 1)
-            model->addConstr(vars["b_front"](tr, t, e_index, vss),
+            model->addConstr(sparse_vars["b_front"](tr, t, e_index, vss),
                              GRB_LESS_EQUAL,
                              (vars["num_vss_segments"](e_index_relevant) - 1) /
                                  (static_cast<double>(vss) + 1),
@@ -1044,7 +1073,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
             // (num_vss_segments(e_index_relevant) - 1) / (vss + 1)
             if (instance.get_train_list().get_train(tr).tim) {
               model->addConstr(
-                  vars["b_rear"](tr, t, e_index, vss), GRB_LESS_EQUAL,
+                  sparse_vars["b_rear"](tr, t, e_index, vss), GRB_LESS_EQUAL,
                   (vars["num_vss_segments"](e_index_relevant) - 1) /
                       (static_cast<double>(vss) + 1),
                   "b_rear_num_vss_segments_" + std::to_string(tr) + "_" +
@@ -1064,7 +1093,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
                                                      sep_type_index, vss2);
               }
             }
-            model->addConstr(vars["b_front"](tr, t, e_index, vss),
+            model->addConstr(sparse_vars["b_front"](tr, t, e_index, vss),
                              GRB_LESS_EQUAL, rhs,
                              "b_front_num_vss_segments_" + std::to_string(tr) +
                                  "_" + std::to_string(t) + "_" +
@@ -1073,7 +1102,8 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
             // type_num_vss_segments(e_index_relevant, *, <= vss)
             if (instance.get_train_list().get_train(tr).tim) {
               model->addConstr(
-                  vars["b_rear"](tr, t, e_index, vss), GRB_LESS_EQUAL, rhs,
+                  sparse_vars["b_rear"](tr, t, e_index, vss), GRB_LESS_EQUAL,
+                  rhs,
                   "b_rear_num_vss_segments_" + std::to_string(tr) + "_" +
                       std::to_string(t) + "_" + std::to_string(e) + "_" +
                       std::to_string(vss));
@@ -1096,7 +1126,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       for (const auto& tr :
            instance.trains_at_t(static_cast<int>(t) * dt, tr_on_e)) {
         if (!instance.get_train_list().get_train(tr).tim) {
-          lhs += vars["x"](tr, t, e);
+          lhs += pruned_var("x", tr, t, e);
         }
       }
       model->addConstr(lhs, GRB_LESS_EQUAL, 1,
@@ -1308,7 +1338,8 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
           // v(tr,t+1) <= max_speed + (tr_speed - max_speed) * (1 - x(tr,t,e))
           model->addConstr(
               vars["v"](tr, t + 1), GRB_LESS_EQUAL,
-              max_speed + (tr_speed - max_speed) * (1 - vars["x"](tr, t, e)),
+              max_speed +
+                  (tr_speed - max_speed) * (1 - pruned_var("x", tr, t, e)),
               "v_max_speed_" + std::to_string(tr) + "_" +
                   std::to_string((t + 1) * dt) + "_" + std::to_string(e));
           // If brakelens are included the speed is reduced before entering an
@@ -1317,7 +1348,8 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
           if (!this->include_braking_curves) {
             model->addConstr(
                 vars["v"](tr, t), GRB_LESS_EQUAL,
-                max_speed + (tr_speed - max_speed) * (1 - vars["x"](tr, t, e)),
+                max_speed +
+                    (tr_speed - max_speed) * (1 - pruned_var("x", tr, t, e)),
                 "v_max_speed2_" + std::to_string(tr) + "_" +
                     std::to_string(t * dt) + "_" + std::to_string(e));
           }
@@ -1346,9 +1378,9 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         const auto tr_on_edge =
             instance.trains_on_edge(e, this->fix_routes, tr_at_t);
         for (const auto& tr : tr_on_edge) {
-          rhs += vars["x"](tr, t, e);
+          rhs += pruned_var("x", tr, t, e);
           model->addConstr(vars["y_sec_fwd"](t, i), GRB_GREATER_EQUAL,
-                           vars["x"](tr, t, e),
+                           pruned_var("x", tr, t, e),
                            "y_sec_fwd_linker_1_" + std::to_string(t) + "_" +
                                std::to_string(i) + "_" + std::to_string(tr) +
                                "_" + std::to_string(e));
@@ -1365,9 +1397,9 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         const auto tr_on_edge =
             instance.trains_on_edge(e, this->fix_routes, tr_at_t);
         for (const auto& tr : tr_on_edge) {
-          rhs += vars["x"](tr, t, e);
+          rhs += pruned_var("x", tr, t, e);
           model->addConstr(vars["y_sec_bwd"](t, i), GRB_GREATER_EQUAL,
-                           vars["x"](tr, t, e),
+                           pruned_var("x", tr, t, e),
                            "y_sec_bwd_linker_1_" + std::to_string(t) + "_" +
                                std::to_string(i) + "_" + std::to_string(tr) +
                                "_" + std::to_string(e));
@@ -1520,7 +1552,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         const auto& vss_e     = instance.const_n().max_vss_on_edge(e);
         const auto& e_b_index = breakable_edge_indices.at(e);
         for (size_t vss = 0; vss < vss_e; ++vss) {
-          lhs += vars["b_tight"](tr, t, e_b_index, vss);
+          lhs += sparse_vars["b_tight"](tr, t, e_b_index, vss);
         }
       }
       model->addConstr(lhs, GRB_LESS_EQUAL, 1,
@@ -1544,7 +1576,7 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
            t <= train_interval[tr].second; ++t) {
         GRBLinExpr lhs = vars["e_tight"](tr, t, e);
         for (size_t vss = 0; vss < vss_e; ++vss) {
-          lhs += vars["b_tight"](tr, t, i, vss);
+          lhs += sparse_vars["b_tight"](tr, t, i, vss);
         }
         model->addConstr(lhs, GRB_LESS_EQUAL, 1,
                          "b_tight_e_tight_max_one_" + tr_name + "_" +
@@ -1574,11 +1606,12 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         GRBLinExpr lhs = vars["e_tight"](tr, t, e);
         if (breakable_e_index.has_value()) {
           for (size_t vss = 0; vss < vss_e.value(); ++vss) {
-            lhs += vars["b_tight"](tr, t, breakable_e_index.value(), vss);
+            lhs += sparse_vars["b_tight"](tr, t, breakable_e_index.value(),
+                                          vss);
           }
         }
         model->addConstr(lhs, GRB_GREATER_EQUAL,
-                         vars["x"](tr, t - 1, e) - vars["stopped"](tr, t),
+                         pruned_var("x", tr, t - 1, e) - vars["stopped"](tr, t),
                          "b_tight_e_tight_min_one_" + tr_name + "_" +
                              std::to_string(t * dt) + "_" + edge_name);
       }
@@ -1613,10 +1646,10 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
            t <= train_interval[tr].second; ++t) {
         GRBLinExpr lhs = 0;
         for (const auto& e_out : delta_out_tr) {
-          lhs += vars["x"](tr, t - 1, e_out);
+          lhs += pruned_var("x", tr, t - 1, e_out);
         }
         model->addConstr(lhs, GRB_GREATER_EQUAL,
-                         vars["x"](tr, t - 1, e) - vars["stopped"](tr, t),
+                         pruned_var("x", tr, t - 1, e) - vars["stopped"](tr, t),
                          "no_stop_on_non-border_edge_ending_" + tr_name + "_" +
                              std::to_string(t * dt) + "_" + edge_name);
       }
@@ -1636,14 +1669,15 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
       for (size_t t = train_interval[tr].first + 2;
            t <= train_interval[tr].second; ++t) {
         for (size_t vss = 0; vss < vss_e; ++vss) {
-          model->addConstr(vars["b_tight"](tr, t, i, vss), GRB_LESS_EQUAL,
-                           vars["b_front"](tr, t, i, vss),
+          model->addConstr(sparse_vars["b_tight"](tr, t, i, vss),
+                           GRB_LESS_EQUAL,
+                           sparse_vars["b_front"](tr, t, i, vss),
                            "b_tight_not_front_1_" + tr_name + "_" +
                                std::to_string(t * dt) + "_" + edge_name + "_" +
                                std::to_string(vss));
           model->addConstr(
-              vars["b_tight"](tr, t, i, vss), GRB_GREATER_EQUAL,
-              vars["b_front"](tr, t, i, vss) - vars["stopped"](tr, t),
+              sparse_vars["b_tight"](tr, t, i, vss), GRB_GREATER_EQUAL,
+              sparse_vars["b_front"](tr, t, i, vss) - vars["stopped"](tr, t),
               "b_tight_not_front_2_" + tr_name + "_" + std::to_string(t * dt) +
                   "_" + edge_name + "_" + std::to_string(vss));
         }
@@ -1667,7 +1701,8 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::
         }
         const auto& vss_e = instance.const_n().max_vss_on_edge(e);
         for (size_t vss = 0; vss < vss_e; ++vss) {
-          lhs += vars["b_tight"](tr, t, breakable_edge_indices.at(e), vss);
+          lhs += sparse_vars["b_tight"](tr, t, breakable_edge_indices.at(e),
+                                        vss);
         }
       }
       model->addConstr(lhs, GRB_GREATER_EQUAL, 1 - vars["stopped"](tr, t),
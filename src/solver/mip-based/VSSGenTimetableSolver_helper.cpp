@@ -15,8 +15,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
 #include <optional>
 #include <plog/Log.h>
+#include <queue>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -142,6 +146,192 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::max_distance_travelled(
   return ret_val;
 }
 
+std::vector<double>
+cda_rail::solver::mip_based::VSSGenTimetableSolver::distances_from_entry(
+    size_t tr) const {
+  /**
+   * Returns for every edge the length of the shortest path from the entry
+   * vertex of the train to the source of the edge using only valid
+   * successors. Unreachable edges have distance INF.
+   */
+
+  const auto& network = instance.const_n();
+  const auto  entry   = instance.get_schedule(tr).get_entry();
+
+  std::vector<double> dist(num_edges, INF);
+  std::priority_queue<std::pair<double, size_t>,
+                      std::vector<std::pair<double, size_t>>, std::greater<>>
+      pq;
+  for (const auto& e : network.out_edges(entry)) {
+    dist.at(e) = 0;
+    pq.emplace(0, e);
+  }
+  while (!pq.empty()) {
+    const auto [d, e] = pq.top();
+    pq.pop();
+    if (d > dist.at(e)) {
+      continue;
+    }
+    const auto d_next = d + network.get_edge(e).length;
+    for (const auto& e_next : network.get_successors(e)) {
+      if (d_next < dist.at(e_next)) {
+        dist.at(e_next) = d_next;
+        pq.emplace(d_next, e_next);
+      }
+    }
+  }
+  return dist;
+}
+
+std::vector<double>
+cda_rail::solver::mip_based::VSSGenTimetableSolver::distances_to_exit(
+    size_t tr) const {
+  /**
+   * Returns for every edge the length of the shortest path from the target of
+   * the edge to the exit vertex of the train using only valid successors.
+   * Edges from which the exit cannot be reached have distance INF.
+   */
+
+  const auto& network = instance.const_n();
+  const auto  exit    = instance.get_schedule(tr).get_exit();
+
+  std::vector<double> dist(num_edges, INF);
+  std::priority_queue<std::pair<double, size_t>,
+                      std::vector<std::pair<double, size_t>>, std::greater<>>
+      pq;
+  for (const auto& e : network.in_edges(exit)) {
+    dist.at(e) = 0;
+    pq.emplace(0, e);
+  }
+  while (!pq.empty()) {
+    const auto [d, e] = pq.top();
+    pq.pop();
+    if (d > dist.at(e)) {
+      continue;
+    }
+    const auto d_prev = d + network.get_edge(e).length;
+    for (const auto& e_prev : network.get_predecessors(e)) {
+      if (d_prev < dist.at(e_prev)) {
+        dist.at(e_prev) = d_prev;
+        pq.emplace(d_prev, e_prev);
+      }
+    }
+  }
+  return dist;
+}
+
+void cda_rail::solver::mip_based::VSSGenTimetableSolver::
+    calculate_reachable_steps() {
+  /**
+   * Calculates for every train the time steps in which it can occupy an edge
+   * or vertex. The front (including braking distance) can at most travel the
+   * maximal distance given the entry speed and acceleration. The rear has to
+   * pass the exit vertex before the train leaves the network at maximal speed.
+   * Hence, an edge is reachable at time step t only if
+   * - its source is at most that distance away from the entry at the end of t
+   * - its target can reach the exit in the remaining time.
+   * Empty ranges are represented by t_min > t_max.
+   */
+
+  reachable_edge_steps.clear();
+  reachable_vertex_steps.clear();
+  reachable_edge_steps.reserve(num_tr);
+  reachable_vertex_steps.reserve(num_tr);
+
+  // Distances only depend on the entry and exit vertices, the maximal front
+  // positions only on the train class and the initial speed. Hence, they are
+  // shared by all trains with identical data.
+  const auto train_classes = instance.get_train_list().get_train_classes();
+  std::unordered_map<size_t, std::vector<double>>          dist_entry_cache;
+  std::unordered_map<size_t, std::vector<double>>          dist_exit_cache;
+  std::map<std::pair<size_t, double>, std::vector<double>> max_front_cache;
+
+  size_t num_reachable = 0;
+  size_t num_total     = 0;
+  for (size_t tr = 0; tr < num_tr; ++tr) {
+    const auto& [t_0, t_n] = train_interval.at(tr);
+    const auto& tr_object  = instance.get_train_list().get_train(tr);
+    const auto  v_0        = instance.get_schedule(tr).get_v_0();
+    const auto  entry      = instance.get_schedule(tr).get_entry();
+    const auto  exit       = instance.get_schedule(tr).get_exit();
+
+    auto& edge_steps   = reachable_edge_steps.emplace_back(
+        num_edges, std::pair<size_t, size_t>(t_0, t_n));
+    auto& vertex_steps = reachable_vertex_steps.emplace_back(
+        num_vertices, std::pair<size_t, size_t>(t_0, t_n));
+    num_total += num_edges * (t_n - t_0 + 1);
+    if (!this->prune_unreachable) {
+      num_reachable += num_edges * (t_n - t_0 + 1);
+      continue;
+    }
+
+    auto& dist_entry = dist_entry_cache[entry];
+    if (dist_entry.empty()) {
+      dist_entry = distances_from_entry(tr);
+    }
+    auto& dist_exit = dist_exit_cache[exit];
+    if (dist_exit.empty()) {
+      dist_exit = distances_to_exit(tr);
+    }
+
+    // max_front.at(i) is the maximal front position after i+1 time steps
+    auto& max_front = max_front_cache[{train_classes.at(tr), v_0}];
+    while (max_front.size() < t_n - t_0 + 1) {
+      max_front.push_back(max_distance_travelled(
+          tr, max_front.size() + 1, v_0, tr_object.acceleration,
+          this->include_braking_curves));
+    }
+    std::vector<double> max_rear(t_n - t_0 + 1);
+    for (size_t t = t_0; t <= t_n; ++t) {
+      max_rear.at(t - t_0) =
+          tr_object.max_speed * static_cast<double>((t_n + 1 - t) * dt);
+    }
+
+    for (size_t e = 0; e < num_edges; ++e) {
+      // max_front is increasing and max_rear is decreasing in t
+      size_t t_min = t_n + 1;
+      size_t t_max = t_0;
+      for (size_t t = t_0; t <= t_n; ++t) {
+        if (dist_entry.at(e) <= max_front.at(t - t_0) + GRB_EPS &&
+            dist_exit.at(e) <= max_rear.at(t - t_0) + GRB_EPS) {
+          t_min = std::min(t_min, t);
+          t_max = std::max(t_max, t);
+        }
+      }
+      if (t_min > t_max) {
+        edge_steps.at(e) = {t_n + 1, t_n};
+      } else {
+        edge_steps.at(e) = {t_min, t_max};
+        num_reachable += t_max - t_min + 1;
+      }
+    }
+
+    // A vertex is reachable whenever one of its incident edges is
+    const auto& network = instance.const_n();
+    for (size_t v = 0; v < num_vertices; ++v) {
+      if (v == entry || v == exit) {
+        continue;
+      }
+      size_t t_min = t_n + 1;
+      size_t t_max = t_0;
+      for (const auto& edges : {network.in_edges(v), network.out_edges(v)}) {
+        for (const auto& e : edges) {
+          if (edge_steps.at(e).first <= edge_steps.at(e).second) {
+            t_min = std::min(t_min, edge_steps.at(e).first);
+            t_max = std::max(t_max, edge_steps.at(e).second);
+          }
+        }
+      }
+      vertex_steps.at(v) =
+          t_min > t_max ? std::pair<size_t, size_t>(t_n + 1, t_n)
+                        : std::pair<size_t, size_t>(t_min, t_max);
+    }
+  }
+
+  PLOGD << "Reachable train-time-edge combinations: " << num_reachable
+        << " of " << num_total;
+}
+
 std::pair<std::vector<cda_rail::index_vector>,
           std::vector<cda_rail::index_vector>>
 cda_rail::solver::mip_based::VSSGenTimetableSolver::common_entry_exit_vertices()
@@ -215,7 +405,13 @@ void cda_rail::solver::mip_based::VSSGenTimetableSolver::cleanup() {
   max_vss_per_edge_in_iteration.clear();
   breakable_edge_indices.clear();
   fwd_bwd_sections.clear();
+  prune_unreachable = false;
+  reachable_edge_steps.clear();
+  reachable_vertex_steps.clear();
+  incumbent_vars.clear();
+  incumbent_values.clear();
   GeneralMIPSolver::cleanup();
+  shared_bounds_callback.reset();
 }
 
 bool cda_rail::solver::mip_based::VSSGenTimetableSolver::update_vss(
@@ -251,6 +447,60 @@ bool cda_rail::solver::mip_based::VSSGenTimetableSolver::update_vss(
   return true;
 }
 
+double
+cda_rail::solver::mip_based::VSSGenTimetableSolver::budget_lower_bound() const {
+  /**
+   * Every solution that is not feasible for the current VSS budget uses more
+   * VSS on at least one edge than allowed. Hence, its objective is at least
+   * the returned value. The bound of the restricted model is only valid up to
+   * this value.
+   */
+
+  double bound = INF;
+  for (size_t i = 0; i < relevant_edges.size(); ++i) {
+    const auto max_vss_e = static_cast<size_t>(
+        instance.const_n().max_vss_on_edge(relevant_edges.at(i)));
+    if (max_vss_per_edge_in_iteration.at(i) < max_vss_e) {
+      bound = std::min(
+          bound, static_cast<double>(max_vss_per_edge_in_iteration.at(i)) + 1);
+    }
+  }
+  return bound;
+}
+
+void cda_rail::solver::mip_based::VSSGenTimetableSolver::store_incumbent() {
+  /**
+   * Stores the current solution of all variables. Gurobi discards it once the
+   * model is modified for the next iteration.
+   */
+
+  // NOLINTBEGIN(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+  const int                       num_vars = model->get(GRB_IntAttr_NumVars);
+  const std::unique_ptr<GRBVar[]> grb_vars(model->getVars());
+  const std::unique_ptr<double[]> values(
+      model->get(GRB_DoubleAttr_X, grb_vars.get(), num_vars));
+  incumbent_vars.assign(grb_vars.get(), grb_vars.get() + num_vars);
+  incumbent_values.assign(values.get(), values.get() + num_vars);
+  // NOLINTEND(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+}
+
+void cda_rail::solver::mip_based::VSSGenTimetableSolver::
+    set_incumbent_as_start() {
+  /**
+   * Passes the stored incumbent as MIP start. It remains feasible, since the
+   * number of possible VSS is only increased and the objective bounds are
+   * satisfied by it. Variables added afterwards are completed by Gurobi.
+   */
+
+  if (incumbent_vars.empty()) {
+    return;
+  }
+
+  model->set(GRB_DoubleAttr_Start, incumbent_vars.data(),
+             incumbent_values.data(), static_cast<int>(incumbent_vars.size()));
+  PLOGD << "Use previous incumbent as MIP start";
+}
+
 void cda_rail::solver::mip_based::VSSGenTimetableSolver::update_max_vss_on_edge(
     size_t relevant_edge_index, size_t new_max_vss, GRBLinExpr& cut_expr) {
   const auto& e            = relevant_edges.at(relevant_edge_index);
@@ -334,8 +584,17 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::initialize_variables(
    * This function initializes the variables affecting the model creation and
    * optimization process
    */
-  this->solve_init_vss_gen_timetable(time_limit, debug_input,
-                                     overwrite_severity);
+  if (shared_incumbent != nullptr) {
+    shared_bounds_callback.emplace(this);
+    this->solve_init_general_mip(time_limit, debug_input, overwrite_severity,
+                                 &(shared_bounds_callback.value()));
+  } else {
+    this->solve_init_vss_gen_timetable(time_limit, debug_input,
+                                       overwrite_severity);
+  }
+  if (gurobi_threads > 0) {
+    model->set(GRB_IntParam_Threads, gurobi_threads);
+  }
 
   if (!model_settings.model_type.check_consistency()) {
     PLOGE << "Model type  and separation types/functions are not consistent.";
@@ -354,6 +613,7 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::initialize_variables(
   this->vss_model                 = model_settings.model_type;
   this->include_train_dynamics    = model_detail.train_dynamics;
   this->include_braking_curves    = model_detail.braking_curves;
+  this->prune_unreachable         = model_detail.prune_unreachable;
   this->use_pwl                   = model_settings.use_pwl;
   this->use_schedule_cuts         = model_settings.use_schedule_cuts;
   this->iterative_vss             = solver_strategy.iterative_approach;
@@ -432,6 +692,8 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::initialize_variables(
     train_interval.emplace_back(instance.time_index_interval(i, dt, false));
   }
 
+  calculate_reachable_steps();
+
   if (iterative_vss && vss_model.get_model_type() == vss::ModelType::Discrete) {
     PLOGE << "Iterative VSS not supported for discrete VSS model";
     throw exceptions::ConsistencyException(
@@ -519,7 +781,11 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
   double obj_lb           = 0;
   size_t iteration_number = 0;
 
-  std::vector<GRBConstr> iterative_cuts;
+  std::vector<GRBConstr>   iterative_cuts;
+  std::optional<GRBConstr> obj_lb_constr;
+  std::optional<GRBConstr> obj_ub_constr;
+  incumbent_vars.clear();
+  incumbent_values.clear();
   this->iterative_include_cuts_tmp = this->iterative_include_cuts;
 
   while (reoptimize) {
@@ -544,6 +810,10 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
         sol_object =
             extract_solution(postprocess, !iterative_vss, old_instance);
         this->iterative_include_cuts_tmp = false;
+
+        if (iterative_vss) {
+          store_incumbent();
+        }
       }
     }
 
@@ -553,6 +823,12 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
 
     if (iterative_vss) {
       // If applicable, iteratively update the model
+      if (shared_incumbent != nullptr &&
+          shared_incumbent->is_stop_requested()) {
+        PLOGD << "Break because a concurrent budget level finished";
+        break;
+      }
+
       if (model->get(GRB_IntAttr_Status) == GRB_TIME_LIMIT) {
         PLOGD << "Break because of timeout";
         if (sol_object->has_solution()) {
@@ -564,17 +840,20 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
         break;
       }
 
-      auto obj_lb_tmp = model->get(GRB_DoubleAttr_ObjBound);
-      for (int i = 0; i < relevant_edges.size(); ++i) {
-        if (static_cast<double>(max_vss_per_edge_in_iteration.at(i)) + 1 <
-                obj_lb_tmp &&
-            max_vss_per_edge_in_iteration.at(i) <
-                instance.const_n().max_vss_on_edge(relevant_edges.at(i))) {
-          obj_lb_tmp =
-              static_cast<double>(max_vss_per_edge_in_iteration.at(i)) + 1;
+      obj_lb = std::max(
+          std::min(model->get(GRB_DoubleAttr_ObjBound), budget_lower_bound()),
+          obj_lb);
+
+      if (shared_incumbent != nullptr) {
+        shared_incumbent->update_lower_bound(obj_lb);
+        obj_lb = std::max(obj_lb, shared_incumbent->get_lower_bound());
+        if (shared_incumbent->get_upper_bound() <= obj_lb + GRB_EPS) {
+          PLOGD << "Break because a concurrent budget level found an optimal "
+                   "solution";
+          shared_incumbent->request_stop();
+          break;
         }
       }
-      obj_lb = std::max(obj_lb_tmp, obj_lb);
 
       if (obj_lb + GRB_EPS >= obj_ub && (sol_object->has_solution())) {
         PLOGD << "Break because obj_lb (" << obj_lb << ") >= obj_ub (" << obj_ub
@@ -602,20 +881,26 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
         break;
       }
 
-      model->addConstr(objective_expr, GRB_GREATER_EQUAL, obj_lb,
-                       "obj_lb_" + std::to_string(obj_lb) + "_" +
-                           std::to_string(iteration_number));
-      model->addConstr(objective_expr, GRB_LESS_EQUAL, obj_ub,
-                       "obj_ub_" + std::to_string(obj_ub) + "_" +
-                           std::to_string(iteration_number));
-      PLOGD << "Added constraint: obj >= " << obj_lb;
-      PLOGD << "Added constraint: obj <= " << obj_ub;
+      // The bounds of previous rounds remain valid, hence, only the right
+      // hand sides of the respective constraints are tightened
+      if (obj_lb_constr.has_value()) {
+        obj_lb_constr->set(GRB_DoubleAttr_RHS, obj_lb);
+        obj_ub_constr->set(GRB_DoubleAttr_RHS, obj_ub);
+      } else {
+        obj_lb_constr = model->addConstr(objective_expr, GRB_GREATER_EQUAL,
+                                         obj_lb, "obj_lb");
+        obj_ub_constr =
+            model->addConstr(objective_expr, GRB_LESS_EQUAL, obj_ub, "obj_ub");
+      }
+      PLOGD << "Set constraint: obj >= " << obj_lb;
+      PLOGD << "Set constraint: obj <= " << obj_ub;
 
       if (this->iterative_include_cuts_tmp) {
         iterative_cuts.push_back(
             model->addConstr(cut_expr, GRB_GREATER_EQUAL, 1,
                              "cut_" + std::to_string(iteration_number)));
-        model->reset(1);
+        // Keep MIP start information, i.e., only discard the solution
+        model->reset(0);
         PLOGD << "Added constraint: cut_expr >= 1";
       } else {
         PLOGD << "Remove " << iterative_cuts.size() << " cut constraints";
@@ -650,6 +935,8 @@ cda_rail::solver::mip_based::VSSGenTimetableSolver::optimize(
       }
 
       model->update();
+
+      set_incumbent_as_start();
     }
   }
 
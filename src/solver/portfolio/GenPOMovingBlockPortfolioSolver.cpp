@@ -0,0 +1,212 @@
+#include "solver/portfolio/GenPOMovingBlockPortfolioSolver.hpp"
+
+#include "CustomExceptions.hpp"
+#include "Definitions.hpp"
+#include "plog/Log.h"
+#include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
+#include "solver/GeneralSolver.hpp"
+#include "solver/SharedIncumbent.hpp"
+#include "solver/astar-based/GenPOMovingBlockAStarSolver.hpp"
+#include "solver/mip-based/GenPOMovingBlockMIPSolver.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::size_t;
+
+namespace {
+std::string strategy_name(
+    cda_rail::solver::portfolio::PortfolioStrategyType strategy) {
+  switch (strategy) {
+  case cda_rail::solver::portfolio::PortfolioStrategyType::AStar:
+    return "A*";
+  case cda_rail::solver::portfolio::PortfolioStrategyType::LazyMIP:
+    return "lazy MIP";
+  case cda_rail::solver::portfolio::PortfolioStrategyType::SimplifiedMIP:
+    return "simplified MIP";
+  default:
+    return "unknown";
+  }
+}
+} // namespace
+
+cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+    cda_rail::instances::GeneralPerformanceOptimizationInstance>
+cda_rail::solver::portfolio::GenPOMovingBlockPortfolioSolver::run_strategy(
+    PortfolioStrategyType                   strategy,
+    const SolverStrategyPortfolio&          solver_strategy_input,
+    const std::shared_ptr<SharedIncumbent>& shared, int time_limit,
+    bool debug_input) const {
+  /**
+   * Runs a single strategy on its own copy of the instance. The objective of
+   * the returned solution is converted to the weighted sum of exit times. A
+   * strategy that proves optimality stops the others via the shared incumbent.
+   */
+
+  if (strategy == PortfolioStrategyType::AStar) {
+    astar_based::GenPOMovingBlockAStarSolver solver(instance);
+    solver.set_shared_incumbent(shared);
+    return solver.solve(solver_strategy_input.astar_model_detail,
+                        solver_strategy_input.astar_solver_strategy, {},
+                        time_limit, debug_input, false);
+  }
+
+  auto model_detail    = solver_strategy_input.mip_model_detail;
+  auto solver_strategy = solver_strategy_input.mip_solver_strategy;
+  model_detail.simplify_headway_constraints =
+      (strategy == PortfolioStrategyType::SimplifiedMIP);
+  if (strategy == PortfolioStrategyType::LazyMIP) {
+    solver_strategy.use_lazy_constraints = true;
+  }
+  solver_strategy.retain_model = false;
+
+  mip_based::GenPOMovingBlockMIPSolver solver(instance);
+  solver.set_shared_incumbent(shared);
+  auto sol = solver.solve(model_detail, solver_strategy, {}, time_limit,
+                          debug_input, false);
+  if (sol.has_solution()) {
+    sol.set_obj(mip_based::GenPOMovingBlockMIPSolver::absolute_objective(
+        instance, sol.get_obj()));
+  }
+  return sol;
+}
+
+cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+    cda_rail::instances::GeneralPerformanceOptimizationInstance>
+cda_rail::solver::portfolio::GenPOMovingBlockPortfolioSolver::solve(
+    const SolverStrategyPortfolio& solver_strategy_input,
+    const GeneralSolutionSettings& solution_settings_input, int time_limit,
+    bool debug_input, bool overwrite_severity) {
+  /**
+   * Solves the instance by racing the selected strategies.
+   *
+   * @param time_limit: time limit for every strategy in seconds. If -1, no
+   * time limit is set.
+   * @param debug_input: if true, the debug output is enabled.
+   * @param overwrite_severity: if true, the severity of the log is overwritten
+   *
+   * @return: best solution found by any strategy
+   */
+
+  this->solve_init_general(time_limit, debug_input, overwrite_severity);
+  winning_strategy.reset();
+
+  std::vector<PortfolioStrategyType> strategies;
+  if (solver_strategy_input.use_astar) {
+    strategies.push_back(PortfolioStrategyType::AStar);
+  }
+  if (solver_strategy_input.use_lazy_mip) {
+    strategies.push_back(PortfolioStrategyType::LazyMIP);
+  }
+  if (solver_strategy_input.use_simplified_mip) {
+    strategies.push_back(PortfolioStrategyType::SimplifiedMIP);
+  }
+  if (strategies.empty()) {
+    throw exceptions::InvalidInputException(
+        "At least one portfolio strategy has to be selected.");
+  }
+
+  PLOGI << "Starting portfolio with " << strategies.size() << " strategies";
+
+  const auto shared = std::make_shared<SharedIncumbent>();
+
+  std::vector<std::future<instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>>>
+      futures;
+  futures.reserve(strategies.size());
+  for (const auto& strategy : strategies) {
+    futures.push_back(std::async(std::launch::async, [&, strategy]() {
+      return run_strategy(strategy, solver_strategy_input, shared, time_limit,
+                          debug_input);
+    }));
+  }
+
+  std::vector<std::pair<PortfolioStrategyType,
+                        instances::SolGeneralPerformanceOptimizationInstance<
+                            instances::GeneralPerformanceOptimizationInstance>>>
+                     results;
+  std::exception_ptr first_exception;
+  for (size_t i = 0; i < futures.size(); i++) {
+    try {
+      results.emplace_back(strategies.at(i), futures.at(i).get());
+    } catch (const std::exception& e) {
+      PLOGE << "Strategy " << strategy_name(strategies.at(i))
+            << " failed: " << e.what();
+      if (!first_exception) {
+        first_exception = std::current_exception();
+      }
+    }
+  }
+  if (results.empty()) {
+    std::rethrow_exception(first_exception);
+  }
+
+  // Lowest objective wins, on ties a proven optimum is preferred. Without any
+  // solution, a proof of infeasibility is preferred over a timeout.
+  std::optional<size_t> best_index;
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& sol = results.at(i).second;
+    if (!sol.has_solution()) {
+      continue;
+    }
+    if (!best_index.has_value()) {
+      best_index = i;
+      continue;
+    }
+    const auto& best = results.at(best_index.value()).second;
+    if (sol.get_obj() < best.get_obj() - GRB_EPS ||
+        (sol.get_obj() <= best.get_obj() + GRB_EPS &&
+         sol.get_status() == SolutionStatus::Optimal &&
+         best.get_status() != SolutionStatus::Optimal)) {
+      best_index = i;
+    }
+  }
+  if (!best_index.has_value()) {
+    best_index = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+      if (results.at(i).second.get_status() == SolutionStatus::Infeasible) {
+        best_index = i;
+        break;
+      }
+    }
+  }
+
+  auto& [strategy, sol_object] = results.at(best_index.value());
+  winning_strategy             = strategy;
+
+  // The exact MIP might have been stopped by an incumbent of another strategy
+  // matching its bound
+  if (sol_object.has_solution() &&
+      sol_object.get_status() == SolutionStatus::Feasible &&
+      sol_object.get_obj() <= shared->get_lower_bound() + GRB_EPS) {
+    sol_object.set_status(SolutionStatus::Optimal);
+  }
+
+  PLOGI << "Portfolio finished, winning strategy: " << strategy_name(strategy);
+  if (sol_object.has_solution()) {
+    PLOGI << "Objective " << sol_object.get_obj() << " (shared lower bound "
+          << shared->get_lower_bound() << ")";
+  }
+
+  if (solution_settings_input.export_option ==
+          GeneralExportOption::ExportSolution ||
+      solution_settings_input.export_option ==
+          GeneralExportOption::ExportSolutionWithInstance) {
+    const bool export_instance =
+        (solution_settings_input.export_option ==
+         GeneralExportOption::ExportSolutionWithInstance);
+    PLOGI << "Saving solution";
+    std::filesystem::path path = solution_settings_input.path;
+    path /= solution_settings_input.name;
+    sol_object.export_solution(path, export_instance);
+  }
+
+  return sol_object;
+}
@@ -6,8 +6,12 @@
 #include "solver/mip-based/GenPOMovingBlockMIPSolver.hpp"
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <filesystem>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -1353,6 +1357,305 @@ TEST(GenPOMovingBlockMIPSolver, StandardLazySimplified3) {
   }
 }
 
+TEST(GenPOMovingBlockMIPSolver, LazyCutPool) {
+  const std::vector<std::string> paths{"SimpleStation", "Stammstrecke4Trains"};
+
+  for (const auto& p : paths) {
+    const std::string instance_path = "./example-networks/" + p + "/";
+    const auto        instance_before_parse =
+        cda_rail::instances::VSSGenerationTimetable(instance_path);
+    const auto instance =
+        cda_rail::instances::GeneralPerformanceOptimizationInstance::
+            cast_from_vss_generation(instance_before_parse);
+    cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+
+    cda_rail::solver::mip_based::SolverStrategyMovingBlock strategy_no_pool;
+    strategy_no_pool.use_lazy_cut_pool = false;
+    const auto sol_no_pool = solver.solve({}, strategy_no_pool, {}, 120);
+    EXPECT_EQ(solver.get_number_of_promoted_lazy_cuts(), 0);
+
+    cda_rail::solver::mip_based::SolverStrategyMovingBlock strategy_pool;
+    strategy_pool.promote_lazy_cuts_after = 1;
+    const auto sol_pool = solver.solve({}, strategy_pool, {}, 120);
+    const auto num_promoted = solver.get_number_of_promoted_lazy_cuts();
+    EXPECT_GT(num_promoted, 0);
+
+    // Second solve uses promoted cuts as hard constraints
+    const auto sol_promoted = solver.solve({}, strategy_pool, {}, 120);
+    EXPECT_GE(solver.get_number_of_promoted_lazy_cuts(), num_promoted);
+
+    // Changing the model detail invalidates the promoted cuts
+    const auto sol_changed_detail =
+        solver.solve({false, 10}, strategy_pool, {}, 120);
+
+    solver.clear_lazy_cut_pool();
+    EXPECT_EQ(solver.get_number_of_promoted_lazy_cuts(), 0);
+
+    for (const auto& sol :
+         {sol_no_pool, sol_pool, sol_promoted, sol_changed_detail}) {
+      EXPECT_TRUE(sol.has_solution())
+          << "No solution found for instance " << instance_path;
+      EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal)
+          << "Solution status is not optimal for instance " << instance_path;
+      EXPECT_EQ(sol.get_obj(), 0)
+          << "Objective value is not 0 for instance " << instance_path;
+      check_last_train_pos(instance_before_parse, sol, instance_path);
+    }
+  }
+}
+
+TEST(GenPOMovingBlockMIPSolver, IncrementalResolve) {
+  const std::string instance_path = "./example-networks/SimpleStation/";
+  const auto        instance_before_parse =
+      cda_rail::instances::VSSGenerationTimetable(instance_path);
+  const auto instance =
+      cda_rail::instances::GeneralPerformanceOptimizationInstance::
+          cast_from_vss_generation(instance_before_parse);
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+
+  EXPECT_FALSE(solver.has_retained_model());
+  EXPECT_THROW(static_cast<void>(solver.resolve()),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_THROW(solver.set_train_weight("tr1", 2),
+               cda_rail::exceptions::ConsistencyException);
+
+  cda_rail::solver::mip_based::SolverStrategyMovingBlock strategy;
+  strategy.retain_model = true;
+  const auto sol        = solver.solve({}, strategy, {}, 120);
+  EXPECT_TRUE(solver.has_retained_model());
+  EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol.get_obj(), 0);
+
+  // Re-solve without changes
+  const auto sol_unchanged = solver.resolve(120);
+  EXPECT_EQ(sol_unchanged.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol_unchanged.get_obj(), 0);
+  check_last_train_pos(instance_before_parse, sol_unchanged, instance_path);
+
+  // Delay tr1, shift its stop and change its weight
+  auto       instance_changed = instance;
+  const auto t_0              = instance.get_schedule("tr1").get_t_0_range();
+  const auto stop             = instance.get_schedule("tr1").get_stops().at(0);
+  const std::pair<int, int> new_t_0   = {t_0.first + 15, t_0.second + 15};
+  const std::pair<int, int> new_begin = {stop.get_begin_range().first + 15,
+                                         stop.get_begin_range().second + 15};
+  const std::pair<int, int> new_end   = {stop.get_end_range().first + 15,
+                                         stop.get_end_range().second + 15};
+
+  // Entry times beyond the latest exit time are rejected
+  const auto t_n = instance.get_schedule("tr1").get_t_n_range();
+  EXPECT_THROW(solver.set_train_entry_time_range(
+                   "tr1", {t_n.second - 1, t_n.second + 1}),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_THROW(solver.set_train_entry_time_range(
+                   "tr1", {t_0.first + 1, t_0.first}),
+               cda_rail::exceptions::InvalidInputException);
+  solver.set_train_entry_time_range("tr1", new_t_0);
+  solver.set_stop_time_ranges("tr1", stop.get_station_name(), new_begin,
+                              new_end);
+  solver.set_train_weight("tr1", 2);
+  instance_changed.editable_schedule("tr1").set_t_0_range(new_t_0);
+  instance_changed.editable_schedule("tr1").set_stops(
+      {cda_rail::GeneralScheduledStop(new_begin, new_end,
+                                      stop.get_min_stopping_time(),
+                                      stop.get_station_name())});
+  instance_changed.set_train_weight("tr1", 2);
+  EXPECT_EQ(solver.get_instance().get_schedule("tr1").get_t_0_range(),
+            new_t_0);
+
+  const auto sol_changed = solver.resolve(120);
+
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver_fresh(
+      instance_changed);
+  const auto sol_fresh = solver_fresh.solve({}, {}, {}, 120);
+  EXPECT_EQ(sol_changed.get_status(), sol_fresh.get_status());
+  EXPECT_EQ(sol_changed.get_obj(), sol_fresh.get_obj());
+
+  // Closing and reopening an edge
+  const auto& network = solver.get_instance().const_n();
+  const auto& first_edge =
+      network.get_edge(network.out_edges(network.get_vertex_index("l0")).at(0));
+  solver.close_edge(network.get_vertex(first_edge.source).name,
+                    network.get_vertex(first_edge.target).name);
+  solver.reopen_edge(network.get_vertex(first_edge.source).name,
+                     network.get_vertex(first_edge.target).name);
+  const auto sol_reopened = solver.resolve(120);
+  EXPECT_EQ(sol_reopened.get_status(), sol_fresh.get_status());
+  EXPECT_EQ(sol_reopened.get_obj(), sol_fresh.get_obj());
+
+  // Only edges of the instance network can be closed
+  EXPECT_THROW(solver.close_edge("l0", "l0"),
+               cda_rail::exceptions::InvalidInputException);
+  EXPECT_THROW(solver.close_edge("l0", "no_vertex"),
+               cda_rail::exceptions::InvalidInputException);
+
+  solver.release_model();
+  EXPECT_FALSE(solver.has_retained_model());
+  EXPECT_EQ(solver.get_instance().get_schedule("tr1").get_t_0_range(),
+            new_t_0);
+
+  // Solving again without retaining the model also works
+  const auto sol_again = solver.solve({}, {}, {}, 120);
+  EXPECT_EQ(sol_again.get_status(), sol_fresh.get_status());
+  EXPECT_EQ(sol_again.get_obj(), sol_fresh.get_obj());
+  EXPECT_FALSE(solver.has_retained_model());
+}
+
+TEST(GenPOMovingBlockMIPSolver, IncrementalResolveSymmetryBreaking) {
+  cda_rail::Network network;
+  const auto        v0 = network.add_vertex("v0", cda_rail::VertexType::TTD);
+  const auto        v1 = network.add_vertex("v1", cda_rail::VertexType::TTD);
+  network.add_edge(v0, v1, 5000, 50, true);
+
+  cda_rail::GeneralTimetable<
+      cda_rail::GeneralSchedule<cda_rail::GeneralScheduledStop>>
+      timetable;
+  timetable.add_train("Train1", 100, 50, 4, 2, true, {0, 60}, 15, v0,
+                      {30, 600}, 40, v1, network);
+  timetable.add_train("Train2", 100, 50, 4, 2, true, {0, 60}, 15, v0,
+                      {30, 600}, 40, v1, network);
+  const cda_rail::RouteMap                                          routes;
+  const cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+  ASSERT_EQ(instance.get_symmetric_train_groups().size(), 1);
+
+  cda_rail::solver::mip_based::SolverStrategyMovingBlock strategy;
+  strategy.abs_mip_gap            = 0;
+  strategy.retain_model           = true;
+  strategy.break_train_symmetries = true;
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+  const auto sol = solver.solve({}, strategy, {}, 120);
+  EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal);
+
+  // Train2 becomes more important and should enter first, which violates the
+  // symmetry breaking constraint of the original instance
+  solver.set_train_weight("Train2", 10);
+  const auto sol_changed = solver.resolve(120);
+
+  auto instance_changed = instance;
+  instance_changed.set_train_weight("Train2", 10);
+  strategy.retain_model           = false;
+  strategy.break_train_symmetries = false;
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver_fresh(
+      instance_changed);
+  const auto sol_fresh = solver_fresh.solve({}, strategy, {}, 120);
+  EXPECT_EQ(sol_changed.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol_fresh.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_NEAR(sol_changed.get_obj(), sol_fresh.get_obj(), 1e-4);
+}
+
+TEST(GenPOMovingBlockMIPSolver, SharedRoutesOnDiscretizedNetwork) {
+  const std::string instance_path = "./example-networks/SimpleStation/";
+  const auto        instance_before_parse =
+      cda_rail::instances::VSSGenerationTimetable(instance_path);
+  const auto instance =
+      cda_rail::instances::GeneralPerformanceOptimizationInstance::
+          cast_from_vss_generation(instance_before_parse);
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+
+  cda_rail::solver::mip_based::SolverStrategyMovingBlock strategy;
+  strategy.retain_model = true;
+  const auto sol        = solver.solve({}, strategy, {}, 120);
+  EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal);
+  ASSERT_TRUE(solver.has_retained_model());
+
+  // Shared routes refer to the instance network, the retained model to the
+  // network in which the stop of tr1 in Central has been separated
+  const cda_rail::solver::SharedIncumbent::NamedRoute route = {
+      {"l0", "l1"},   {"l1", "l2"}, {"l2", "l3"}, {"l3", "g00"},
+      {"g00", "g01"}, {"g01", "r2"}, {"r2", "r1"}, {"r1", "r0"}};
+  const auto& network          = solver.instance.const_n();
+  const auto& original_network = instance.const_n();
+  const auto  stop_edge        = original_network.get_edge_index("g00", "g01");
+  ASSERT_FALSE(network.has_edge("g00", "g01"));
+
+  const auto tr1 = solver.instance.get_train_list().get_train_index("tr1");
+  const auto route_edges = solver.get_discretized_route_edges(tr1, route);
+  ASSERT_TRUE(route_edges.has_value());
+  size_t num_stop_edges = 0;
+  for (size_t e = 0; e < network.number_of_edges(); e++) {
+    const auto old_e = network.get_old_edge(e).first;
+    const bool on_route = std::ranges::any_of(route, [&](const auto& edge) {
+      return original_network.get_edge_index(edge.first, edge.second) == old_e;
+    });
+    EXPECT_EQ(route_edges->contains(e), on_route);
+    if (old_e == stop_edge) {
+      EXPECT_TRUE(route_edges->contains(e));
+      num_stop_edges++;
+    }
+  }
+  EXPECT_GT(num_stop_edges, 1);
+
+  // Routes that are not part of the instance network are skipped
+  EXPECT_FALSE(solver.get_discretized_route_edges(tr1, {}).has_value());
+  EXPECT_FALSE(solver.get_discretized_route_edges(tr1, {{"l0", "r0"}})
+                   .has_value());
+  EXPECT_FALSE(solver.get_discretized_route_edges(tr1, {{"l0", "x0"}})
+                   .has_value());
+}
+
+TEST(GenPOMovingBlockMIPSolver, NoTinyCoefficients) {
+  const std::string instance_path = "./example-networks/SimpleStation/";
+  const auto        instance_before_parse =
+      cda_rail::instances::VSSGenerationTimetable(instance_path);
+  const auto instance =
+      cda_rail::instances::GeneralPerformanceOptimizationInstance::
+          cast_from_vss_generation(instance_before_parse);
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver solver(instance);
+
+  cda_rail::solver::mip_based::SolverStrategyMovingBlock strategy;
+  strategy.retain_model = true;
+  const auto sol        = solver.solve({}, strategy, {}, 120);
+  EXPECT_EQ(sol.get_status(), cda_rail::SolutionStatus::Optimal);
+  ASSERT_TRUE(solver.has_retained_model());
+
+  const auto tol = solver.coefficient_tolerance;
+  ASSERT_GT(tol, 0);
+
+  // No constraint of the built model contains a tiny coefficient
+  const std::unique_ptr<GRBConstr[]> constrs(solver.model->getConstrs());
+  for (int i = 0; i < solver.model->get(GRB_IntAttr_NumConstrs); i++) {
+    const auto row = solver.model->getRow(constrs[i]);
+    for (unsigned int j = 0; j < row.size(); j++) {
+      const auto coeff = row.getCoeff(static_cast<int>(j));
+      EXPECT_TRUE(coeff == 0 || std::abs(coeff) >= tol);
+    }
+  }
+  for (const auto& [key, cut] : solver.lazy_cut_pool) {
+    for (unsigned int j = 0; j < cut.expr.size(); j++) {
+      const auto coeff = cut.expr.getCoeff(static_cast<int>(j));
+      EXPECT_TRUE(coeff == 0 || std::abs(coeff) >= tol);
+    }
+  }
+
+  // Terms are merged per variable before checking the coefficients
+  const std::unique_ptr<GRBVar[]> grb_vars(solver.model->getVars());
+  const auto&                     a = grb_vars[0];
+  const auto&                     b = grb_vars[1];
+  const auto&                     c = grb_vars[2];
+
+  GRBLinExpr expr = 2 + a + (tol / 10) * b + 0.1 * c + 0.2 * c - 0.3 * c;
+  for (int i = 0; i < 20; i++) {
+    expr += (tol / 10) * a;
+  }
+  const auto num_dropped_before = solver.num_dropped_coefficients;
+  const auto checked            = solver.checked_expr(expr);
+  EXPECT_EQ(solver.num_dropped_coefficients, num_dropped_before + 2);
+  EXPECT_EQ(checked.getConstant(), 2);
+  ASSERT_EQ(checked.size(), 1);
+  EXPECT_TRUE(checked.getVar(0).sameAs(a));
+  EXPECT_NEAR(checked.getCoeff(0), 1 + 2 * tol, 1e-12);
+
+  // Tiny terms that sum up above the tolerance are kept
+  GRBLinExpr tiny_terms = 0;
+  for (int i = 0; i < 20; i++) {
+    tiny_terms += (tol / 10) * b;
+  }
+  const auto checked_tiny_terms = solver.checked_expr(tiny_terms);
+  ASSERT_EQ(checked_tiny_terms.size(), 1);
+  EXPECT_NEAR(checked_tiny_terms.getCoeff(0), 2 * tol, 1e-12);
+}
+
 TEST(GenPOMovingBlockMIPSolver, SimpleStationExportOptions) {
   const std::string instance_path = "./example-networks/SimpleStation/";
   const auto        instance_before_parse =
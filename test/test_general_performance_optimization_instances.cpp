@@ -774,6 +774,78 @@ TEST(GeneralPerformanceOptimizationInstances,
   EXPECT_FALSE(sol2_read.get_instance().has_route("tr2"));
 }
 
+TEST(GeneralPerformanceOptimizationInstances,
+     SolGeneralPerformanceOptimizationInstanceExportImportBinary) {
+  instances::GeneralPerformanceOptimizationInstance instance;
+
+  instance.n().add_vertex("v0", cda_rail::VertexType::TTD);
+  instance.n().add_vertex("v1", cda_rail::VertexType::TTD);
+  instance.n().add_vertex("v2", cda_rail::VertexType::TTD);
+
+  const auto v0_v1 = instance.n().add_edge("v0", "v1", 100, 10);
+  const auto v1_v2 = instance.n().add_edge("v1", "v2", 200, 20);
+
+  instance.n().add_successor({"v0", "v1"}, {"v1", "v2"});
+
+  instance.add_train("tr1", 50, 10, 2, 2, {0, 60}, 0, "v0", {120, 180}, 5,
+                     "v2");
+  instance.add_train("tr2", 50, 10, 2, 2, {0, 60}, 0, "v0", {120, 180}, 5,
+                     "v2");
+
+  EXPECT_TRUE(instance.check_consistency(false));
+
+  instances::SolGeneralPerformanceOptimizationInstance<
+      instances::GeneralPerformanceOptimizationInstance>
+      sol_instance(instance);
+
+  sol_instance.set_obj(1.5);
+  sol_instance.set_status(cda_rail::SolutionStatus::Feasible);
+
+  for (const auto& tr : {"tr1", "tr2"}) {
+    sol_instance.add_empty_route(tr);
+    sol_instance.push_back_edge_to_route(tr, v0_v1);
+    sol_instance.push_back_edge_to_route(tr, v1_v2);
+    sol_instance.set_train_routed(tr);
+  }
+
+  // Fine-grained trajectories with non-integral times
+  for (int i = 0; i <= 300; ++i) {
+    const double t = 0.4 * i;
+    sol_instance.add_train_pos("tr1", t, 2.5 * t);
+    sol_instance.add_train_speed("tr1", t, 2.5);
+    sol_instance.add_train_pos("tr2", t + 1.0 / 3, t);
+    sol_instance.add_train_speed("tr2", t + 1.0 / 3, 1);
+  }
+
+  EXPECT_TRUE(sol_instance.check_consistency());
+
+  sol_instance.export_solution_binary("./tmp/test-sol-instance-binary", false);
+  EXPECT_TRUE(std::filesystem::exists(
+      "./tmp/test-sol-instance-binary/solution/trajectories.bin"));
+  EXPECT_FALSE(std::filesystem::exists(
+      "./tmp/test-sol-instance-binary/solution/train_pos.json"));
+  const auto sol_read =
+      cda_rail::instances::SolGeneralPerformanceOptimizationInstance<
+          instances::GeneralPerformanceOptimizationInstance>::
+          import_solution("./tmp/test-sol-instance-binary", instance);
+  std::filesystem::remove_all("./tmp");
+
+  EXPECT_TRUE(sol_read.check_consistency());
+  EXPECT_EQ(sol_read.get_obj(), 1.5);
+  EXPECT_EQ(sol_read.get_status(), cda_rail::SolutionStatus::Feasible);
+  EXPECT_TRUE(sol_read.get_train_routed("tr1"));
+  EXPECT_TRUE(sol_read.get_train_routed("tr2"));
+  for (int i = 0; i <= 300; ++i) {
+    const double t = 0.4 * i;
+    EXPECT_EQ(sol_read.get_train_pos("tr1", t), 2.5 * t);
+    EXPECT_EQ(sol_read.get_train_speed("tr1", t), 2.5);
+    EXPECT_EQ(sol_read.get_train_pos("tr2", t + 1.0 / 3), t);
+    EXPECT_EQ(sol_read.get_train_speed("tr2", t + 1.0 / 3), 1);
+  }
+  EXPECT_EQ(sol_read.get_train_times("tr1").size(), 301);
+  EXPECT_EQ(sol_read.get_train_times("tr2").size(), 301);
+}
+
 TEST(GeneralPerformanceOptimizationInstances, DiscretizationOfStops1) {
   // Create instance members
   Network network("./example-networks/SimpleStation/network/");
@@ -1453,6 +1525,57 @@ TEST(GeneralPerformanceOptimizationInstances, LeavingTimes) {
   EXPECT_APPROX_EQ(instance.get_minimal_leaving_time(tr4, 5), 7.25);
 }
 
+TEST(GeneralPerformanceOptimizationInstances, SymmetricTrainGroups) {
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance;
+
+  const auto v0 = instance.n().add_vertex("v0", cda_rail::VertexType::TTD);
+  const auto v1 = instance.n().add_vertex("v1", cda_rail::VertexType::TTD);
+  const auto v2 = instance.n().add_vertex("v2", cda_rail::VertexType::TTD);
+
+  const auto e01 = instance.n().add_edge(v0, v1, 1000, 20);
+  const auto e12 = instance.n().add_edge(v1, v2, 1000, 20);
+  instance.n().add_successor(e01, e12);
+
+  // Train1, Train3, and Train6 are identical
+  const auto tr1 = instance.add_train("Train1", 100, 50, 1, 1, {0, 60}, 10, v0,
+                                      {300, 360}, 10, v2);
+  // Different time window
+  instance.add_train("Train2", 100, 50, 1, 1, {0, 120}, 10, v0, {300, 360}, 10,
+                     v2);
+  const auto tr3 = instance.add_train("Train3", 100, 50, 1, 1, {0, 60}, 10, v0,
+                                      {300, 360}, 10, v2);
+  // Different weight
+  instance.add_train("Train4", 100, 50, 1, 1, {0, 60}, 10, v0, {300, 360}, 10,
+                     v2, 2);
+  // Different physics
+  const auto tr5 = instance.add_train("Train5", 100, 40, 1, 1, {0, 60}, 10, v0,
+                                      {300, 360}, 10, v2);
+  const auto tr6 = instance.add_train("Train6", 100, 50, 1, 1, {0, 60}, 10, v0,
+                                      {300, 360}, 10, v2);
+  // Identical to Train5
+  const auto tr7 = instance.add_train("Train7", 100, 40, 1, 1, {0, 60}, 10, v0,
+                                      {300, 360}, 10, v2);
+
+  const auto groups = instance.get_symmetric_train_groups();
+  ASSERT_EQ(groups.size(), 2);
+  EXPECT_EQ(groups.at(0), (cda_rail::index_vector{tr1, tr3, tr6}));
+  EXPECT_EQ(groups.at(1), (cda_rail::index_vector{tr5, tr7}));
+
+  // A fixed route distinguishes otherwise identical trains
+  instance.add_empty_route("Train3");
+  instance.push_back_edge_to_route("Train3", e01);
+  instance.push_back_edge_to_route("Train3", e12);
+  const auto groups_with_route = instance.get_symmetric_train_groups();
+  ASSERT_EQ(groups_with_route.size(), 2);
+  EXPECT_EQ(groups_with_route.at(0), (cda_rail::index_vector{tr1, tr6}));
+  EXPECT_EQ(groups_with_route.at(1), (cda_rail::index_vector{tr5, tr7}));
+
+  instance.set_train_optional(tr6);
+  const auto groups_with_optional = instance.get_symmetric_train_groups();
+  ASSERT_EQ(groups_with_optional.size(), 1);
+  EXPECT_EQ(groups_with_optional.at(0), (cda_rail::index_vector{tr5, tr7}));
+}
+
 TEST(GeneralPerformanceOptimizationInstances, RASPaths) {
   const std::vector<std::string> paths{"toy", "practical"};
 
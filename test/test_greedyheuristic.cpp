@@ -446,6 +446,118 @@ TEST(GreedyHeuristic, FullGreedyHeuristicRejectsMismatchedResultSizes) {
                cda_rail::exceptions::ConsistencyException);
 }
 
+TEST(GreedyHeuristic, RemainingTimeHeuristicCache) {
+  Network    network;
+  const auto v0 = network.add_vertex("v0", VertexType::TTD);
+  const auto v1 = network.add_vertex("v1", VertexType::TTD);
+  const auto v2 = network.add_vertex("v2", VertexType::TTD);
+  const auto v3 = network.add_vertex("v3", VertexType::TTD);
+
+  const auto v0_v1 = network.add_edge(v0, v1, 100, 10);
+  const auto v1_v2 = network.add_edge(v1, v2, 200, 20);
+  const auto v2_v3 = network.add_edge(v2, v3, 100, 10);
+  network.add_successor(v0_v1, v1_v2);
+  network.add_successor(v1_v2, v2_v3);
+
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  timetable.add_station("Station1");
+  timetable.add_track_to_station("Station1", v1_v2, network);
+  const auto tr1 = timetable.add_train("Train1", 50, 20, 4, 2, true, {0, 60},
+                                       10, v0, {10, 600}, 10, v3, network);
+  timetable.add_stop(tr1, "Station1", {20, 100}, {40, 120}, 30);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+  cda_rail::simulator::GreedySimulator simulator(instance, {});
+
+  // Not entered: 100 / 10 + 200 / 20 to the station, 100 / 10 to the exit
+  const auto travel_times0 =
+      cda_rail::simulator::remaining_travel_times(tr1, simulator);
+  ASSERT_TRUE(travel_times0.has_value());
+  EXPECT_EQ(travel_times0.value(), std::vector<double>({20, 10}));
+
+  cda_rail::simulator::RemainingTimeHeuristicCache cache;
+  for (const double exit_time : {0.0, 50.0, 200.0}) {
+    for (const bool consider_earliest_exit : {false, true}) {
+      const auto [feas, obj] =
+          cda_rail::simulator::simple_remaining_time_heuristic(
+              tr1, simulator, exit_time, 0, false, false,
+              consider_earliest_exit);
+      const auto [feas_cached, obj_cached] =
+          cda_rail::simulator::simple_remaining_time_heuristic(
+              tr1, simulator, exit_time, 0, false, false,
+              consider_earliest_exit, &cache);
+      EXPECT_EQ(feas_cached, feas);
+      EXPECT_DOUBLE_EQ(obj_cached, obj);
+    }
+  }
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.get_hits(), 5);
+
+  // Every position and number of served stops is cached separately
+  simulator.set_train_edges_of_tr(tr1, {v0_v1, v1_v2});
+  const auto& travel_times1 = cache.travel_times(tr1, simulator);
+  ASSERT_TRUE(travel_times1.has_value());
+  EXPECT_EQ(travel_times1.value(), std::vector<double>({0, 10}));
+  simulator.set_stop_positions_of_tr(tr1, {300});
+  const auto& travel_times2 = cache.travel_times(tr1, simulator);
+  ASSERT_TRUE(travel_times2.has_value());
+  EXPECT_EQ(travel_times2.value(), std::vector<double>({10}));
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_EQ(cache.get_hits(), 5);
+}
+
+TEST(GreedyHeuristic, PairwiseExitConflictHeuristic) {
+  Network    network;
+  const auto v0    = network.add_vertex("v0", VertexType::TTD, 30);
+  const auto v1    = network.add_vertex("v1", VertexType::TTD, 59.5);
+  const auto v0_v1 = network.add_edge(v0, v1, 1000, 20, true);
+
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  const auto tr1 = timetable.add_train("Train1", 100, 20, 1, 1, true, {0, 60},
+                                       0, v0, {0, 600}, 10, v1, network);
+  const auto tr2 = timetable.add_train("Train2", 100, 20, 1, 1, true, {0, 60},
+                                       0, v0, {0, 600}, 10, v1, network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+  instance.set_train_weight(tr2, 2);
+  cda_rail::simulator::GreedySimulator simulator(instance, {});
+
+  cda_rail::simulator::SimulatorResults sim_results{};
+  sim_results.success            = true;
+  sim_results.exit_times         = {0.0, 0.0};
+  sim_results.braking_times      = {-1.0, -1.0};
+  sim_results.braking_distances  = {-1.0, -1.0};
+  sim_results.stop_times         = {{}, {}};
+  sim_results.vertex_headways    = {0.0, 0.0};
+  sim_results.train_trajectories = {};
+
+  // Headway is rounded up to 60 seconds
+  // Train1 first: Train2 delayed by 100 + 60 - 120 = 40 seconds, weighted 80
+  // Train2 first: Train1 delayed by 120 + 60 - 100 = 80 seconds, weighted 80
+  EXPECT_DOUBLE_EQ(cda_rail::simulator::pairwise_exit_conflict_heuristic(
+                       simulator, sim_results, {100, 120}),
+                   80);
+  // Trains that are far enough apart do not conflict
+  EXPECT_DOUBLE_EQ(cda_rail::simulator::pairwise_exit_conflict_heuristic(
+                       simulator, sim_results, {100, 200}),
+                   0);
+
+  // Both trains cannot exit before 150, afterwards they conflict by 60 seconds
+  sim_results.vertex_headways.at(v1) = 150;
+  EXPECT_DOUBLE_EQ(cda_rail::simulator::pairwise_exit_conflict_heuristic(
+                       simulator, sim_results, {100, 120}),
+                   50 + (2 * 30) + 60);
+
+  // Train1 is already ordered, hence, only Train2 is delayed
+  simulator.set_train_edges_of_tr(tr1, {v0_v1});
+  simulator.set_vertex_orders_of_vertex(v1, {tr1});
+  EXPECT_DOUBLE_EQ(cda_rail::simulator::pairwise_exit_conflict_heuristic(
+                       simulator, sim_results, {160, 120}),
+                   2 * 30);
+}
+
 TEST(GreedyHeuristic, FinalStateHeuristic) {
   Network    network;
   const auto v0 = network.add_vertex("v0", VertexType::TTD);
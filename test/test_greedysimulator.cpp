@@ -7,12 +7,15 @@
 #include "simulator/GreedySimulator.hpp"
 
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <plog/Appenders/ColorConsoleAppender.h>
 #include <plog/Formatters/TxtFormatter.h>
 #include <plog/Init.h>
 #include <plog/Log.h>
 #include <plog/Severity.h>
+#include <vector>
 
 using namespace cda_rail;
 
@@ -1662,6 +1665,71 @@ TEST(GreedySimulator, FutureSpeedRestrictionConstraintsAfterLeaving) {
   EXPECT_GE(ma3, (15.0 + 15.0) * 1.0 / 2.0 + 15.0 * 15.0 / 4.0);
 }
 
+TEST(GreedySimulator, SpeedLimitProfile) {
+  Network    network;
+  const auto v0 = network.add_vertex("v0", VertexType::TTD);
+  const auto v1 = network.add_vertex("v1", VertexType::TTD);
+  const auto v2 = network.add_vertex("v2", VertexType::TTD);
+  const auto v3 = network.add_vertex("v3", VertexType::TTD);
+  const auto v4 = network.add_vertex("v4", VertexType::TTD);
+  const auto v5 = network.add_vertex("v5", VertexType::TTD);
+
+  const auto v0_v1 = network.add_edge(v0, v1, 100, 40, true);
+  const auto v1_v2 = network.add_edge(v1, v2, 110, 30, true);
+  const auto v2_v3 = network.add_edge(v2, v3, 200, 20, true);
+  const auto v3_v4 = network.add_edge(v3, v4, 100, 50, true);
+  const auto v4_v5 = network.add_edge(v4, v5, 1500, 10, true);
+
+  network.add_successor(v0_v1, v1_v2);
+  network.add_successor(v1_v2, v2_v3);
+  network.add_successor(v2_v3, v3_v4);
+  network.add_successor(v3_v4, v4_v5);
+
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  const auto tr1 = timetable.add_train("Train1", 200, 51, 3, 2, true, {0, 60},
+                                       10, v0, {360, 420}, 14, v5, network);
+
+  RouteMap routes;
+
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  cda_rail::simulator::GreedySimulator simulator(instance, {{}});
+  simulator.set_train_edges_of_tr(tr1, {v0_v1, v1_v2, v2_v3, v3_v4, v4_v5});
+
+  EXPECT_THROW(static_cast<void>(simulator.speed_limit_profile(1000)),
+               cda_rail::exceptions::TrainNotExistentException);
+
+  const auto profile = simulator.speed_limit_profile(tr1);
+  EXPECT_EQ(profile.number_of_edges(), 5);
+  EXPECT_EQ(profile.milestones,
+            std::vector<double>({0, 100, 210, 410, 510, 2010}));
+  EXPECT_EQ(profile.speed_limits, std::vector<double>({40, 30, 20, 50, 10}));
+  EXPECT_EQ(profile.route_length(), 2010);
+
+  EXPECT_EQ(profile.first_edge_ending_after(-200), 0);
+  EXPECT_EQ(profile.first_edge_ending_after(0), 0);
+  EXPECT_EQ(profile.first_edge_ending_after(99), 0);
+  EXPECT_EQ(profile.first_edge_ending_after(100), 1);
+  EXPECT_EQ(profile.first_edge_ending_after(450), 3);
+  EXPECT_EQ(profile.first_edge_ending_after(2010), 5);
+
+  // Compare every range to the minimum computed directly
+  for (size_t first = 0; first < profile.number_of_edges(); ++first) {
+    for (size_t last = first + 1; last <= profile.number_of_edges(); ++last) {
+      EXPECT_EQ(profile.min_speed_limit(first, last),
+                *std::min_element(profile.speed_limits.begin() +
+                                      static_cast<std::ptrdiff_t>(first),
+                                  profile.speed_limits.begin() +
+                                      static_cast<std::ptrdiff_t>(last)));
+    }
+  }
+  EXPECT_THROW(static_cast<void>(profile.min_speed_limit(2, 2)),
+               cda_rail::exceptions::InvalidInputException);
+  EXPECT_THROW(static_cast<void>(profile.min_speed_limit(0, 6)),
+               cda_rail::exceptions::InvalidInputException);
+}
+
 TEST(GreedySimulator, EoMDisplacement) {
   cda_rail::instances::GeneralPerformanceOptimizationInstance instance;
   cda_rail::simulator::GreedySimulator simulator(instance, {});
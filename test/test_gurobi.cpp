@@ -1,5 +1,6 @@
 #include "gurobi_c++.h"
 #include "gurobi_c.h"
+#include "solver/mip-based/GRBEnvPool.hpp"
 
 #include "gtest/gtest.h"
 #include <exception>
@@ -41,3 +42,49 @@ TEST(Gurobi, GurobiInstallation) {
     throw e;
   }
 }
+
+TEST(Gurobi, EnvironmentPool) {
+  auto& pool = cda_rail::solver::mip_based::GRBEnvPool::get_instance();
+  pool.clear();
+
+  const auto created_before = pool.get_number_of_created_environments();
+
+  GRBEnv* first_env_ptr = nullptr;
+  {
+    const auto env = pool.acquire();
+    first_env_ptr  = env.get();
+    EXPECT_EQ(pool.get_number_of_available_environments(), 0);
+    EXPECT_EQ(pool.get_number_of_created_environments(), created_before + 1);
+    env->set(GRB_DoubleParam_MIPGap, 0.5);
+  }
+  EXPECT_EQ(pool.get_number_of_available_environments(), 1);
+
+  {
+    // Reused environment with reset parameters
+    const auto env = pool.acquire();
+    EXPECT_EQ(env.get(), first_env_ptr);
+    EXPECT_EQ(pool.get_number_of_created_environments(), created_before + 1);
+    EXPECT_DOUBLE_EQ(env->get(GRB_DoubleParam_MIPGap), 1e-4);
+
+    // Concurrently borrowed environments are distinct
+    const auto env2 = pool.acquire();
+    EXPECT_NE(env.get(), env2.get());
+    EXPECT_EQ(pool.get_number_of_created_environments(), created_before + 2);
+
+    GRBModel     model = GRBModel(*env2);
+    const GRBVar x     = model.addVar(0.0, 1.0, 1.0, GRB_BINARY, "x");
+    model.set(GRB_IntParam_OutputFlag, 0);
+    model.setObjective(GRBLinExpr(x), GRB_MAXIMIZE);
+    model.optimize();
+    EXPECT_EQ(model.get(GRB_IntAttr_Status), GRB_OPTIMAL);
+    EXPECT_EQ(model.get(GRB_DoubleAttr_ObjVal), 1);
+  }
+  EXPECT_EQ(pool.get_number_of_available_environments(), 2);
+
+  pool.set_max_pool_size(1);
+  EXPECT_EQ(pool.get_number_of_available_environments(), 1);
+  pool.set_max_pool_size(16);
+
+  pool.clear();
+  EXPECT_EQ(pool.get_number_of_available_environments(), 0);
+}
@@ -499,6 +499,22 @@ TEST(Solver, OvertakeFreeContinuous) {
   EXPECT_EQ(obj_val_braking.get_mip_obj(), 14);
 }
 
+TEST(Solver, OvertakeFreeContinuousUnpruned) {
+  cda_rail::solver::mip_based::VSSGenTimetableSolver solver(
+      "./example-networks/Overtake/");
+
+  const auto obj_val_pruned =
+      solver.solve({15, false, true, true, true}, {}, {}, {}, 120);
+  const auto obj_val_unpruned =
+      solver.solve({15, false, true, true, false}, {}, {}, {}, 120);
+
+  EXPECT_EQ(obj_val_pruned.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(obj_val_unpruned.get_status(), cda_rail::SolutionStatus::Optimal);
+
+  EXPECT_EQ(obj_val_pruned.get_obj(), 14);
+  EXPECT_EQ(obj_val_unpruned.get_obj(), 14);
+}
+
 TEST(Solver, Stammstrecke4FixedContinuous) {
   cda_rail::solver::mip_based::VSSGenTimetableSolver solver(
       "./example-networks/Stammstrecke4Trains/");
@@ -860,6 +876,37 @@ TEST(Solver, IterativeContinuousOvertakeRelative) {
   EXPECT_EQ(obj_val.get_mip_obj(), 14);
 }
 
+TEST(Solver, IterativeParallelContinuousSingleTrack) {
+  cda_rail::solver::mip_based::VSSGenTimetableSolver solver(
+      "./example-networks/SingleTrack/");
+
+  const auto obj_val = solver.solve(
+      {}, {},
+      {true, cda_rail::OptimalityStrategy::Optimal,
+       cda_rail::solver::mip_based::UpdateStrategy::Fixed, 1, 2, true, 3},
+      {}, 60, true);
+
+  EXPECT_EQ(obj_val.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(obj_val.get_obj(), 9);
+  EXPECT_EQ(obj_val.get_mip_obj(), 9);
+}
+
+TEST(Solver, IterativeParallelContinuousOvertakeRelative) {
+  cda_rail::solver::mip_based::VSSGenTimetableSolver solver(
+      "./example-networks/Overtake/");
+
+  const auto obj_val = solver.solve(
+      {}, {},
+      {true, cda_rail::OptimalityStrategy::Optimal,
+       cda_rail::solver::mip_based::UpdateStrategy::Relative, 0.05, 0.05, true,
+       4},
+      {}, 60, true);
+
+  EXPECT_EQ(obj_val.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(obj_val.get_obj(), 14);
+  EXPECT_EQ(obj_val.get_mip_obj(), 14);
+}
+
 TEST(Solver, OnlyStopAtBoundariesContinuousFixed1) {
   cda_rail::solver::mip_based::VSSGenTimetableSolver solver(
       "./example-networks/SimpleStation/");
@@ -1,6 +1,7 @@
 #include "CustomExceptions.hpp"
 #include "Definitions.hpp"
 #include "EOMHelper.hpp"
+#include "MemoryResource.hpp"
 #include "VSSModel.hpp"
 #include "solver/astar-based/GenPOMovingBlockAStarSolver.hpp"
 
@@ -9,6 +10,7 @@
 #include <cmath>
 #include <cstddef>
 #include <limits>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <unordered_set>
@@ -1631,6 +1633,74 @@ TEST(Helper, EoMPosOnEdgeAtTime) {
                cda_rail::exceptions::InvalidInputException);
 }
 
+TEST(Helper, EoMBatch) {
+  // Batched variants coincide with the scalar functions
+  const std::vector<double> v_1    = {0, 10, 10, 20, 5, 14};
+  const std::vector<double> v_2    = {0, 22, 10, 0, 20, 14};
+  const std::vector<double> v_line = {5, 14, 14, 10, 12, 6};
+  const std::vector<double> t      = {1, 3, 5, 2, 7, 10};
+  const double              a      = 2;
+  const double              d      = 1;
+  const double              s      = 200;
+
+  std::vector<double> out(v_1.size());
+  cda_rail::min_travel_time_batch(v_1, v_2, 25, a, d, s, out);
+  for (size_t i = 0; i < v_1.size(); i++) {
+    EXPECT_EQ(out.at(i),
+              cda_rail::min_travel_time(v_1.at(i), v_2.at(i), 25, a, d, s));
+  }
+
+  for (const bool stopping_allowed : {false, true}) {
+    cda_rail::max_travel_time_batch(v_1, v_2, 1, a, d, s, stopping_allowed,
+                                    out);
+    for (size_t i = 0; i < v_1.size(); i++) {
+      EXPECT_EQ(out.at(i),
+                cda_rail::max_travel_time(v_1.at(i), v_2.at(i), 1, a, d, s,
+                                          stopping_allowed));
+    }
+  }
+
+  cda_rail::time_on_edge_batch(v_1, v_2, v_line, a, d, s, out);
+  for (size_t i = 0; i < v_1.size(); i++) {
+    EXPECT_EQ(out.at(i), cda_rail::time_on_edge(v_1.at(i), v_2.at(i),
+                                                v_line.at(i), a, d, s));
+  }
+
+  cda_rail::pos_on_edge_at_time_batch(v_1, v_2, v_line, a, d, s, t, out);
+  for (size_t i = 0; i < v_1.size(); i++) {
+    EXPECT_EQ(out.at(i),
+              cda_rail::pos_on_edge_at_time(v_1.at(i), v_2.at(i), v_line.at(i),
+                                            a, d, s, t.at(i)));
+  }
+
+  const std::vector<double> t_line = {30, 15, 20, 20, 25, 14};
+  cda_rail::get_line_speed_batch(v_1, v_2, 1, 25, a, d, s, t_line, out);
+  for (size_t i = 0; i < v_1.size(); i++) {
+    EXPECT_EQ(out.at(i), cda_rail::get_line_speed(v_1.at(i), v_2.at(i), 1, 25,
+                                                  a, d, s, t_line.at(i)));
+    EXPECT_LE(cda_rail::time_on_edge(v_1.at(i), v_2.at(i), out.at(i), a, d, s),
+              t_line.at(i) + cda_rail::LINE_SPEED_TIME_ACCURACY);
+  }
+
+  // Invalid entries and sizes are detected
+  const std::vector<double> v_invalid_1 = {0, 30};
+  const std::vector<double> v_invalid_2 = {0, 0};
+  std::vector<double>       out_invalid(2);
+  EXPECT_THROW(cda_rail::min_travel_time_batch(v_invalid_1, v_invalid_2, 25, a,
+                                               d, s, out_invalid),
+               cda_rail::exceptions::ConsistencyException);
+  EXPECT_THROW(cda_rail::min_travel_time_batch(v_1, v_invalid_2, 25, a, d, s,
+                                               out),
+               cda_rail::exceptions::InvalidInputException);
+
+  const std::vector<double> v_exceeded = {10, 10};
+  const std::vector<double> t_exceeded = {5, 11};
+  EXPECT_THROW(cda_rail::pos_on_edge_at_time_batch(v_exceeded, v_exceeded,
+                                                   v_exceeded, 1, 1, 100,
+                                                   t_exceeded, out_invalid),
+               cda_rail::exceptions::InvalidInputException);
+}
+
 TEST(Helper, ConsistencySmallNegativeValues) {
   auto   v1_in = -cda_rail::GRB_EPS / 2;
   auto   v2_in = -cda_rail::GRB_EPS / 2;
@@ -1866,4 +1936,35 @@ TEST(Helper, GreedySimulatorStateHash) {
   EXPECT_TRUE(states.contains(state3));
 }
 
+TEST(Helper, ScratchMemoryResource) {
+  cda_rail::CountingMemoryResource counting;
+  EXPECT_EQ(counting.get_counters().allocations, 0);
+
+  void* p = counting.allocate(64, alignof(double));
+  EXPECT_EQ(counting.get_counters().allocations, 1);
+  EXPECT_EQ(counting.get_counters().deallocations, 0);
+  EXPECT_EQ(counting.get_counters().bytes, 64);
+  counting.deallocate(p, 64, alignof(double));
+  EXPECT_EQ(counting.get_counters().deallocations, 1);
+
+  {
+    std::pmr::monotonic_buffer_resource arena(&counting);
+    std::pmr::vector<size_t>            v(&arena);
+    for (size_t i = 0; i < 1000; ++i) {
+      v.emplace_back(i);
+    }
+    EXPECT_EQ(v.back(), 999);
+  }
+  const auto counters = counting.get_counters();
+  EXPECT_GT(counters.allocations, 1);
+  EXPECT_EQ(counters.allocations, counters.deallocations);
+
+  // The scratch pool belongs to the calling thread
+  EXPECT_EQ(cda_rail::thread_scratch_pool(), cda_rail::thread_scratch_pool());
+  std::pmr::vector<size_t> scratch(cda_rail::thread_scratch_pool());
+  scratch.resize(100, 1);
+  EXPECT_EQ(scratch.size(), 100);
+  EXPECT_GT(cda_rail::scratch_allocation_counters().allocations, 0);
+}
+
 // NOLINTEND(clang-diagnostic-unused-result)
@@ -6,9 +6,12 @@
 #include "datastructure/Route.hpp"
 #include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
 #include "simulator/GreedySimulator.hpp"
+#include "solver/SharedIncumbent.hpp"
 #include "solver/astar-based/GenPOMovingBlockAStarSolver.hpp"
 
 #include "gtest/gtest.h"
+#include <memory>
+#include <memory_resource>
 
 using namespace cda_rail;
 
@@ -386,6 +389,297 @@ TEST(GenPOMovingBlockAStarSolver, NextStatesTTD) {
   EXPECT_TRUE(next_states4.contains(expected_state4_2));
 }
 
+TEST(GenPOMovingBlockAStarSolver, CanonicalState) {
+  Network    network;
+  const auto v0 = network.add_vertex("v0", VertexType::TTD, 60);
+  const auto v1 = network.add_vertex("v1", VertexType::TTD, 30);
+  const auto v2 = network.add_vertex("v2", VertexType::TTD, 30);
+
+  const auto v0_v1 = network.add_edge(v0, v1, 500, 20, true);
+  const auto v1_v2 = network.add_edge(v1, v2, 1000, 20, true);
+  network.add_successor(v0_v1, v1_v2);
+
+  // Train1 and Train3 are interchangeable
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  const auto tr1 = timetable.add_train("Train1", 100, 50, 2, 1, true,
+                                       {10, 200}, 0, v0, {10, 600}, 20, v2,
+                                       network);
+  const auto tr2 = timetable.add_train("Train2", 50, 20, 1, 1, true, {20, 200},
+                                       0, v0, {10, 600}, 20, v2, network);
+  const auto tr3 = timetable.add_train("Train3", 100, 50, 2, 1, true,
+                                       {10, 200}, 0, v0, {10, 600}, 20, v2,
+                                       network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver solver(instance);
+  solver.symmetric_train_groups = instance.get_symmetric_train_groups();
+  ASSERT_EQ(solver.symmetric_train_groups.size(), 1);
+
+  // Train1 entered, Train2 and Train3 have not entered yet
+  const cda_rail::solver::astar_based::GreedySimulatorState state1{
+      .train_edges    = {{v0_v1, v1_v2}, {}, {}},
+      .ttd_orders     = {},
+      .vertex_orders  = {{tr1}, {tr1}, {}},
+      .stop_positions = {{}, {}, {}}};
+  // The same state with Train1 and Train3 exchanged
+  const cda_rail::solver::astar_based::GreedySimulatorState state2{
+      .train_edges    = {{}, {}, {v0_v1, v1_v2}},
+      .ttd_orders     = {},
+      .vertex_orders  = {{tr3}, {tr3}, {}},
+      .stop_positions = {{}, {}, {}}};
+
+  EXPECT_EQ(solver.canonical_state(state1), state2);
+  EXPECT_EQ(solver.canonical_state(state2), state2);
+
+  // Both states are simulated alike
+  cda_rail::simulator::GreedySimulator simulator(instance, {});
+  const auto simulate_state =
+      [&simulator](
+          const cda_rail::solver::astar_based::GreedySimulatorState& s) {
+        simulator.set_train_edges(s.train_edges);
+        simulator.set_ttd_orders(s.ttd_orders);
+        simulator.set_vertex_orders(s.vertex_orders);
+        simulator.set_stop_positions(s.stop_positions);
+        return simulator.simulate(6, false, false, false, true);
+      };
+  const auto sim_res1 = simulate_state(state1);
+  const auto sim_res2 = simulate_state(state2);
+  ASSERT_TRUE(sim_res1.success);
+  ASSERT_TRUE(sim_res2.success);
+  EXPECT_EQ(sim_res1.exit_times.at(tr1), sim_res2.exit_times.at(tr3));
+  EXPECT_EQ(sim_res1.exit_times.at(tr2), sim_res2.exit_times.at(tr2));
+  EXPECT_EQ(sim_res1.exit_times.at(tr3), sim_res2.exit_times.at(tr1));
+
+  // Exchanging Train1 and Train3 changes the order in which Train1 and Train2
+  // are simulated, hence, the state is not renumbered
+  const cda_rail::solver::astar_based::GreedySimulatorState state3{
+      .train_edges    = {{v0_v1, v1_v2}, {v0_v1}, {}},
+      .ttd_orders     = {},
+      .vertex_orders  = {{tr1, tr2}, {tr1}, {}},
+      .stop_positions = {{}, {}, {}}};
+  EXPECT_EQ(solver.canonical_state(state3), state3);
+
+  // Routed trains of a group keep their order, independent of their routes
+  const cda_rail::solver::astar_based::GreedySimulatorState state4{
+      .train_edges    = {{v0_v1}, {}, {v0_v1, v1_v2}},
+      .ttd_orders     = {},
+      .vertex_orders  = {{tr3, tr1}, {tr3}, {}},
+      .stop_positions = {{}, {}, {}}};
+  EXPECT_EQ(solver.canonical_state(state4), state4);
+
+  // Symmetry reduction does not change the optimal objective
+  const auto sol_obj =
+      solver.solve({}, {.symmetry_reduction = false}, {}, -1, false);
+  const auto sol_obj_reduced = solver.solve({}, {}, {}, -1, false);
+  EXPECT_EQ(sol_obj.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol_obj_reduced.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_DOUBLE_EQ(sol_obj_reduced.get_obj(), sol_obj.get_obj());
+}
+
+TEST(GenPOMovingBlockAStarSolver, StateActions) {
+  Network    network;
+  const auto a0 = network.add_vertex("a0", VertexType::TTD, 60);
+  const auto a1 = network.add_vertex("a1", VertexType::TTD, 30);
+  const auto b0 = network.add_vertex("b0", VertexType::TTD, 60);
+  const auto b1 = network.add_vertex("b1", VertexType::TTD, 30);
+
+  const auto a0_a1 = network.add_edge(a0, a1, 500, 20, true);
+  const auto b0_b1 = network.add_edge(b0, b1, 500, 20, true);
+
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  const auto tr1 = timetable.add_train("Train1", 100, 50, 2, 1, true,
+                                       {10, 200}, 0, a0, {10, 600}, 20, a1,
+                                       network);
+  const auto tr2 = timetable.add_train("Train2", 100, 50, 2, 1, true,
+                                       {10, 200}, 0, b0, {10, 600}, 20, b1,
+                                       network);
+  const auto tr3 = timetable.add_train("Train3", 50, 20, 1, 1, true, {20, 200},
+                                       0, a0, {10, 600}, 20, a1, network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  const cda_rail::solver::astar_based::GreedySimulatorState state0{
+      .train_edges    = {{}, {}, {}},
+      .ttd_orders     = {},
+      .vertex_orders  = {{}, {}, {}, {}},
+      .stop_positions = {{}, {}, {}}};
+  // Train1 enters and leaves on a0 -> a1
+  const cda_rail::solver::astar_based::GreedySimulatorState state1{
+      .train_edges    = {{a0_a1}, {}, {}},
+      .ttd_orders     = {},
+      .vertex_orders  = {{tr1}, {tr1}, {}, {}},
+      .stop_positions = {{}, {}, {}}};
+  // Train2 enters and leaves on b0 -> b1
+  const cda_rail::solver::astar_based::GreedySimulatorState state2{
+      .train_edges    = {{}, {b0_b1}, {}},
+      .ttd_orders     = {},
+      .vertex_orders  = {{}, {}, {tr2}, {tr2}},
+      .stop_positions = {{}, {}, {}}};
+  // Train3 enters and leaves on a0 -> a1
+  const cda_rail::solver::astar_based::GreedySimulatorState state3{
+      .train_edges    = {{}, {}, {a0_a1}},
+      .ttd_orders     = {},
+      .vertex_orders  = {{tr3}, {tr3}, {}, {}},
+      .stop_positions = {{}, {}, {}}};
+  // Train1 stops at the end of a0 -> a1
+  const cda_rail::solver::astar_based::GreedySimulatorState state4{
+      .train_edges    = {{a0_a1}, {}, {}},
+      .ttd_orders     = {},
+      .vertex_orders  = {{tr1}, {tr1}, {}, {}},
+      .stop_positions = {{500}, {}, {}}};
+
+  using cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver;
+  const auto action1 =
+      GenPOMovingBlockAStarSolver::state_action(state0, state1);
+  const auto action2 =
+      GenPOMovingBlockAStarSolver::state_action(state0, state2);
+  const auto action3 =
+      GenPOMovingBlockAStarSolver::state_action(state0, state3);
+  const auto action4 =
+      GenPOMovingBlockAStarSolver::state_action(state1, state4);
+
+  EXPECT_EQ(action1.train, tr1);
+  EXPECT_EQ(action1.new_edges, cda_rail::index_vector({a0_a1}));
+  EXPECT_TRUE(action1.new_stop_positions.empty());
+  EXPECT_TRUE(action1.ttd_sections.empty());
+  EXPECT_EQ(action1.vertices, cda_rail::index_vector({a0, a1}));
+
+  EXPECT_EQ(action4.train, tr1);
+  EXPECT_TRUE(action4.new_edges.empty());
+  EXPECT_EQ(action4.new_stop_positions, std::vector<double>({500}));
+  EXPECT_TRUE(action4.vertices.empty());
+
+  // Trains on disjoint lines commute, trains sharing their entry do not
+  EXPECT_TRUE(action1.is_independent_of(action2));
+  EXPECT_TRUE(action2.is_independent_of(action1));
+  EXPECT_FALSE(action1.is_independent_of(action3));
+  EXPECT_TRUE(action2.is_independent_of(action3));
+  EXPECT_TRUE(action4.is_independent_of(action3));
+  EXPECT_FALSE(action4.is_independent_of(action1));
+
+  EXPECT_THROW(GenPOMovingBlockAStarSolver::state_action(state1, state1),
+               cda_rail::exceptions::ConsistencyException);
+
+  // Sleeping actions are not generated
+  const cda_rail::simulator::GreedySimulator simulator(instance, {});
+  const auto all_next_states =
+      GenPOMovingBlockAStarSolver::next_states_single_edge(simulator);
+  const auto awake_next_states =
+      GenPOMovingBlockAStarSolver::next_states_single_edge(
+          simulator, std::pmr::get_default_resource(), {action2});
+  EXPECT_EQ(all_next_states.size(), 3);
+  EXPECT_TRUE(all_next_states.contains(state2));
+  EXPECT_EQ(awake_next_states.size(), 2);
+  EXPECT_TRUE(awake_next_states.contains(state1));
+  EXPECT_FALSE(awake_next_states.contains(state2));
+  EXPECT_TRUE(awake_next_states.contains(state3));
+
+  // Partial order reduction does not change the optimal objective. Commuting
+  // interleavings reach the same state, which is queued only once anyway.
+  // Hence, only fewer successors are generated.
+  GenPOMovingBlockAStarSolver solver(instance);
+  const auto sol_obj     = solver.solve({}, {}, {}, -1, false);
+  const auto expansions  = solver.get_number_of_expansions();
+  const auto generated   = solver.get_number_of_generated_states();
+  const auto simulations = solver.get_number_of_simulations();
+  const auto sol_obj_reduced =
+      solver.solve({}, {.partial_order_reduction = true}, {}, -1, false);
+  EXPECT_EQ(solver.get_number_of_expansions(), expansions);
+  EXPECT_LT(solver.get_number_of_generated_states(), generated);
+  EXPECT_LE(solver.get_number_of_simulations(), simulations);
+  EXPECT_EQ(sol_obj.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol_obj_reduced.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_DOUBLE_EQ(sol_obj_reduced.get_obj(), sol_obj.get_obj());
+}
+
+TEST(GenPOMovingBlockAStarSolver, PartialOrderReductionSimulations) {
+  Network    network;
+  const auto a0 = network.add_vertex("a0", VertexType::TTD, 60);
+  const auto a1 = network.add_vertex("a1", VertexType::TTD, 30);
+  const auto a2 = network.add_vertex("a2", VertexType::TTD, 30);
+  const auto b0 = network.add_vertex("b0", VertexType::TTD, 60);
+  const auto b1 = network.add_vertex("b1", VertexType::TTD, 30);
+  const auto b2 = network.add_vertex("b2", VertexType::TTD, 30);
+
+  const auto a0_a1 = network.add_edge(a0, a1, 500, 20, true);
+  const auto a1_a2 = network.add_edge(a1, a2, 500, 20, true);
+  const auto b0_b1 = network.add_edge(b0, b1, 500, 20, true);
+  const auto b1_b2 = network.add_edge(b1, b2, 500, 20, true);
+  network.add_successor(a0_a1, a1_a2);
+  network.add_successor(b0_b1, b1_b2);
+
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  timetable.add_train("Train1", 100, 50, 2, 1, true, {10, 200}, 0, a0,
+                      {10, 600}, 20, a2, network);
+  timetable.add_train("Train2", 100, 50, 2, 1, true, {10, 200}, 0, b0,
+                      {10, 600}, 20, b2, network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver solver(instance);
+  const auto sol_obj = solver.solve({}, {}, {}, -1, false);
+  ASSERT_EQ(sol_obj.get_status(), cda_rail::SolutionStatus::Optimal);
+
+  // Only queued states are remembered. States pruned by the incumbent of a
+  // concurrent solver, e.g., one whose time is not discretized, are simulated
+  // again whenever they are reached. Sleep sets reach them only once.
+  size_t simulations = 0;
+  for (const bool por : {false, true}) {
+    const auto shared = std::make_shared<cda_rail::solver::SharedIncumbent>();
+    shared->update_upper_bound(sol_obj.get_obj() - 1);
+    solver.set_shared_incumbent(shared);
+    const auto sol_bounded = solver.solve(
+        {}, {.partial_order_reduction = por}, {}, -1, false);
+    EXPECT_NE(sol_bounded.get_status(), cda_rail::SolutionStatus::Optimal);
+    if (por) {
+      EXPECT_LT(solver.get_number_of_simulations(), simulations);
+    } else {
+      simulations = solver.get_number_of_simulations();
+    }
+  }
+}
+
+TEST(GenPOMovingBlockAStarSolver, PairwiseConflictHeuristic) {
+  Network    network;
+  const auto v0a = network.add_vertex("v0a", VertexType::TTD, 60);
+  const auto v0b = network.add_vertex("v0b", VertexType::TTD, 60);
+  const auto v1  = network.add_vertex("v1", VertexType::TTD, 10);
+  const auto v2  = network.add_vertex("v2", VertexType::TTD, 90);
+
+  const auto v0a_v1 = network.add_edge(v0a, v1, 500, 20, true);
+  const auto v0b_v1 = network.add_edge(v0b, v1, 700, 20, true);
+  const auto v1_v2  = network.add_edge(v1, v2, 1000, 30, true);
+  network.add_successor(v0a_v1, v1_v2);
+  network.add_successor(v0b_v1, v1_v2);
+
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  timetable.add_train("Train1", 100, 30, 2, 1, true, {0, 300}, 0, v0a,
+                      {0, 1200}, 10, v2, network);
+  timetable.add_train("Train2", 150, 25, 1, 1, true, {20, 300}, 0, v0b,
+                      {0, 1200}, 10, v2, network);
+  timetable.add_train("Train3", 50, 30, 2, 1, true, {40, 300}, 0, v0a,
+                      {0, 1200}, 10, v2, network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  // Exit headways are bounded admissibly, i.e., the optimum does not change
+  cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver solver(instance);
+  const auto sol_obj = solver.solve({}, {}, {}, -1, false);
+  const auto sol_obj_pairwise = solver.solve(
+      {},
+      {.remaining_time_heuristic_type =
+           cda_rail::simulator::RemainingTimeHeuristicType::PairwiseConflicts},
+      {}, -1, false);
+  EXPECT_EQ(sol_obj.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(sol_obj_pairwise.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_DOUBLE_EQ(sol_obj_pairwise.get_obj(), sol_obj.get_obj());
+}
+
 TEST(GenPOMovingBlockAStarSolver, SimpleInstance) {
   Network    network;
   const auto v0 = network.add_vertex("v0", VertexType::TTD, 60);
@@ -496,6 +790,104 @@ TEST(GenPOMovingBlockAStarSolver, SimpleSolutionExtraction) {
   EXPECT_EQ(sol_obj.get_train_speed("Train1", 45), 20);
 }
 
+TEST(GenPOMovingBlockAStarSolver, ScreeningTimeStep) {
+  Network    network;
+  const auto v0 = network.add_vertex("v0", VertexType::TTD, 60);
+  const auto v1 = network.add_vertex("v1", VertexType::TTD, 30);
+  const auto v2 = network.add_vertex("v2", VertexType::TTD, 30);
+
+  const auto v0_v1 = network.add_edge(v0, v1, 500, 20, true);
+  const auto v1_v2 = network.add_edge(v1, v2, 1000, 20, true);
+  network.add_successor(v0_v1, v1_v2);
+
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  timetable.add_train("Train1", 100, 50, 2, 1, true, {10, 60}, 0, v0, {10, 400},
+                      20, v2, network);
+  timetable.add_train("Train2", 50, 20, 1, 1, true, {20, 80}, 0, v0, {10, 400},
+                      20, v2, network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver solver(instance);
+  const auto sol_obj = solver.solve({.dt = 5}, {}, {}, -1, false);
+  const auto sol_obj_screened =
+      solver.solve({.dt = 5}, {.screening_dt = 15}, {}, -1, false);
+
+  EXPECT_TRUE(sol_obj.has_solution());
+  EXPECT_EQ(sol_obj.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_TRUE(sol_obj_screened.has_solution());
+  // Screening does not prove optimality
+  EXPECT_EQ(sol_obj_screened.get_status(), cda_rail::SolutionStatus::Feasible);
+  EXPECT_DOUBLE_EQ(sol_obj_screened.get_obj(), sol_obj.get_obj());
+
+  // Trajectories are always extracted with the model's time step
+  for (const auto& tr_name : {"Train1", "Train2"}) {
+    const auto times = sol_obj_screened.get_train_times(tr_name);
+    EXPECT_EQ(times, sol_obj.get_train_times(tr_name));
+    for (const auto& t : times) {
+      EXPECT_EQ(static_cast<int>(t) % 5, 0);
+    }
+  }
+}
+
+TEST(GenPOMovingBlockAStarSolver, HashDistributedSearch) {
+  Network    network;
+  const auto v0 = network.add_vertex("v0", VertexType::TTD, 60);
+  const auto v1 = network.add_vertex("v1", VertexType::TTD, 30);
+  const auto v2 = network.add_vertex("v2", VertexType::TTD, 30);
+
+  const auto v0_v1 = network.add_edge(v0, v1, 500, 20, true);
+  const auto v1_v2 = network.add_edge(v1, v2, 1000, 20, true);
+  network.add_successor(v0_v1, v1_v2);
+
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  timetable.add_train("Train1", 100, 50, 2, 1, true, {10, 60}, 0, v0, {10, 400},
+                      20, v2, network);
+  timetable.add_train("Train2", 50, 20, 1, 1, true, {20, 80}, 0, v0, {10, 400},
+                      20, v2, network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver solver(instance);
+  const auto sol_obj = solver.solve({.dt = 5}, {}, {}, -1, false);
+  const auto sol_obj_hda =
+      solver.solve({.dt = 5}, {.num_threads = 4}, {}, -1, false);
+
+  EXPECT_TRUE(sol_obj_hda.has_solution());
+  EXPECT_EQ(sol_obj_hda.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_DOUBLE_EQ(sol_obj_hda.get_obj(), sol_obj.get_obj());
+  EXPECT_EQ(sol_obj_hda.get_train_times("Train1"),
+            sol_obj.get_train_times("Train1"));
+  EXPECT_EQ(sol_obj_hda.get_train_times("Train2"),
+            sol_obj.get_train_times("Train2"));
+
+  // Two trains in opposite directions on a single track
+  Network    network_infeasible;
+  const auto u0 = network_infeasible.add_vertex("v0", VertexType::TTD, 60);
+  const auto u1 = network_infeasible.add_vertex("v1", VertexType::TTD, 30);
+
+  network_infeasible.add_edge(u1, u0, 500, 20, true);
+  network_infeasible.add_edge(u0, u1, 5000, 50, true);
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable_infeasible;
+  timetable_infeasible.add_train("Train1", 100, 50, 4, 2, true, {0, 20}, 15, u0,
+                                 {30, 400}, 40, u1, network_infeasible);
+  timetable_infeasible.add_train("Train2", 100, 50, 4, 2, true, {0, 20}, 15, u1,
+                                 {30, 400}, 40, u0, network_infeasible);
+  cda_rail::instances::GeneralPerformanceOptimizationInstance
+      instance_infeasible(network_infeasible, timetable_infeasible, routes);
+
+  cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver solver_infeasible(
+      instance_infeasible);
+  const auto sol_obj_infeasible =
+      solver_infeasible.solve({}, {.num_threads = 3}, {}, -1, false);
+
+  EXPECT_FALSE(sol_obj_infeasible.has_solution());
+  EXPECT_EQ(sol_obj_infeasible.get_status(),
+            cda_rail::SolutionStatus::Infeasible);
+}
+
 TEST(GenPOMovingBlockAStarSolver, SimpleSolutionExport) {
   Network    network;
   const auto v0 = network.add_vertex("v0", VertexType::TTD, 60);
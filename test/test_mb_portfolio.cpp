@@ -0,0 +1,211 @@
+#include "CustomExceptions.hpp"
+#include "Definitions.hpp"
+#include "datastructure/RailwayNetwork.hpp"
+#include "datastructure/Route.hpp"
+#include "probleminstances/GeneralPerformanceOptimizationInstance.hpp"
+#include "solver/astar-based/GenPOMovingBlockAStarSolver.hpp"
+#include "solver/mip-based/GenPOMovingBlockMIPSolver.hpp"
+#include "solver/SharedIncumbent.hpp"
+#include "solver/portfolio/GenPOMovingBlockPortfolioSolver.hpp"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <memory>
+
+using namespace cda_rail;
+
+// NOLINTBEGIN
+// (clang-analyzer-deadcode.DeadStores,misc-const-correctness,clang-diagnostic-unused-result)
+
+TEST(GenPOMovingBlockPortfolioSolver, SimpleInstance) {
+  Network    network;
+  const auto v0 = network.add_vertex("v0", VertexType::TTD, 60);
+  const auto v1 = network.add_vertex("v1", VertexType::TTD, 30);
+
+  network.add_edge(v1, v0, 500, 20, true);
+  network.add_edge(v0, v1, 5000, 50, true);
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  timetable.add_train("Train1", 100, 50, 4, 2, true, {0, 60}, 15, v0, {30, 400},
+                      40, v1, network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  cda_rail::solver::portfolio::GenPOMovingBlockPortfolioSolver solver(
+      instance);
+  const auto sol_obj = solver.solve(-1, true);
+
+  EXPECT_TRUE(sol_obj.has_solution());
+  EXPECT_EQ(sol_obj.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_TRUE(solver.get_winning_strategy().has_value());
+}
+
+TEST(GenPOMovingBlockPortfolioSolver, SingleStrategies) {
+  Network    network;
+  const auto v0 = network.add_vertex("v0", VertexType::TTD, 60);
+  const auto v1 = network.add_vertex("v1", VertexType::TTD, 30);
+
+  network.add_edge(v1, v0, 500, 20, true);
+  network.add_edge(v0, v1, 5000, 50, true);
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  timetable.add_train("Train1", 100, 50, 4, 2, true, {0, 60}, 15, v0, {30, 400},
+                      40, v1, network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  cda_rail::solver::portfolio::GenPOMovingBlockPortfolioSolver solver(
+      instance);
+  const auto sol_astar = solver.solve(
+      {.use_astar = true, .use_lazy_mip = false, .use_simplified_mip = false},
+      {}, -1, false);
+  EXPECT_TRUE(sol_astar.has_solution());
+  EXPECT_EQ(solver.get_winning_strategy(),
+            cda_rail::solver::portfolio::PortfolioStrategyType::AStar);
+
+  const auto sol_mip = solver.solve(
+      {.use_astar = false, .use_lazy_mip = true, .use_simplified_mip = false},
+      {}, -1, false);
+  EXPECT_TRUE(sol_mip.has_solution());
+  EXPECT_EQ(sol_mip.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_EQ(solver.get_winning_strategy(),
+            cda_rail::solver::portfolio::PortfolioStrategyType::LazyMIP);
+
+  // Objectives of both strategies are reported as weighted sum of exit times
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver mip_solver(instance);
+  const auto sol_mip_direct = mip_solver.solve();
+  EXPECT_NEAR(sol_mip.get_obj(),
+              cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver::
+                  absolute_objective(instance, sol_mip_direct.get_obj()),
+              GRB_EPS);
+  EXPECT_GE(sol_mip.get_obj(), 0);
+  EXPECT_GE(sol_astar.get_obj(), 0);
+
+  EXPECT_THROW(solver.solve({.use_astar          = false,
+                             .use_lazy_mip       = false,
+                             .use_simplified_mip = false},
+                            {}, -1, false),
+               cda_rail::exceptions::InvalidInputException);
+}
+
+TEST(GenPOMovingBlockPortfolioSolver, SimpleInfeasibleInstance) {
+  Network    network;
+  const auto v0 = network.add_vertex("v0", VertexType::TTD, 60);
+  const auto v1 = network.add_vertex("v1", VertexType::TTD, 30);
+
+  network.add_edge(v1, v0, 500, 20, true);
+  network.add_edge(v0, v1, 5000, 50, true);
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  timetable.add_train("Train1", 100, 50, 4, 2, true, {0, 20}, 15, v0, {30, 400},
+                      40, v1, network);
+  timetable.add_train("Train2", 100, 50, 4, 2, true, {0, 20}, 15, v1, {30, 400},
+                      40, v0, network);
+
+  RouteMap                                                    routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  cda_rail::solver::portfolio::GenPOMovingBlockPortfolioSolver solver(
+      instance);
+  const auto sol_obj = solver.solve(-1, false);
+
+  EXPECT_FALSE(sol_obj.has_solution());
+  EXPECT_EQ(sol_obj.get_status(), cda_rail::SolutionStatus::Infeasible);
+}
+
+TEST(GenPOMovingBlockPortfolioSolver, SimpleNetwork) {
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      "example-networks-gen-po/GeneralSimpleNetworkB3Trains");
+
+  cda_rail::solver::portfolio::GenPOMovingBlockPortfolioSolver solver(
+      instance);
+  const auto sol_obj = solver.solve(
+      {.use_astar          = true,
+       .use_lazy_mip       = true,
+       .use_simplified_mip = true,
+       .astar_solver_strategy =
+           {.next_state_strategy =
+                cda_rail::solver::astar_based::NextStateStrategy::NextTTD,
+            .consider_earliest_exit = true}},
+      {}, 60, false);
+
+  EXPECT_TRUE(sol_obj.has_solution());
+  EXPECT_TRUE(solver.get_winning_strategy().has_value());
+}
+
+TEST(GenPOMovingBlockPortfolioSolver, StopOnJointOptimalityProof) {
+  Network    network;
+  const auto v0 = network.add_vertex("v0", VertexType::TTD, 60);
+  const auto v1 = network.add_vertex("v1", VertexType::TTD, 30);
+
+  network.add_edge(v1, v0, 500, 20, true);
+  network.add_edge(v0, v1, 5000, 50, true);
+  GeneralTimetable<GeneralSchedule<GeneralScheduledStop>> timetable;
+  timetable.add_train("Train1", 100, 50, 4, 2, true, {0, 60}, 15, v0, {30, 400},
+                      40, v1, network);
+  timetable.add_train("Train2", 100, 50, 4, 2, true, {0, 60}, 15, v0, {30, 400},
+                      40, v1, network);
+  RouteMap   routes;
+  cda_rail::instances::GeneralPerformanceOptimizationInstance instance(
+      network, timetable, routes);
+
+  cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver astar_solver(
+      instance);
+  const auto sol_astar = astar_solver.solve(-1, false);
+  ASSERT_TRUE(sol_astar.has_solution());
+
+  // A MIP that proves optimality, by itself or because its bound reaches the
+  // incumbent of another solver, stops all other solvers
+  const auto shared = std::make_shared<cda_rail::solver::SharedIncumbent>();
+  shared->update_upper_bound(sol_astar.get_obj());
+  cda_rail::solver::mip_based::GenPOMovingBlockMIPSolver mip_solver(instance);
+  mip_solver.set_shared_incumbent(shared);
+  const auto sol_mip = mip_solver.solve(
+      {}, {.use_lazy_constraints = true, .abs_mip_gap = 0}, {}, -1, false);
+  EXPECT_TRUE(sol_mip.has_solution() ||
+              sol_mip.get_status() == cda_rail::SolutionStatus::Timeout);
+  EXPECT_TRUE(shared->is_stop_requested());
+  EXPECT_GE(shared->get_lower_bound(),
+            shared->get_upper_bound() * (1 - 1e-3) - GRB_EPS);
+
+  // A* whose open states are all bounded by the shared incumbent proves it
+  // optimal and stops all other solvers, also if the search is distributed.
+  // An objective of 1 bounds every state except the initial one.
+  for (const size_t num_threads : {1, 2}) {
+    const auto ub = std::make_shared<cda_rail::solver::SharedIncumbent>();
+    ub->update_upper_bound(1);
+    cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver bounded_solver(
+        instance);
+    bounded_solver.set_shared_incumbent(ub);
+    const auto sol_bounded = bounded_solver.solve(
+        {}, {.num_threads = num_threads}, {}, -1, false);
+    EXPECT_NE(sol_bounded.get_status(), cda_rail::SolutionStatus::Optimal);
+    EXPECT_TRUE(ub->is_stop_requested());
+    EXPECT_GE(ub->get_lower_bound(), ub->get_upper_bound() - GRB_EPS);
+  }
+
+  // A* does not continue its search once a stop is requested
+  const auto stopped = std::make_shared<cda_rail::solver::SharedIncumbent>();
+  stopped->request_stop();
+  cda_rail::solver::astar_based::GenPOMovingBlockAStarSolver stopped_solver(
+      instance);
+  stopped_solver.set_shared_incumbent(stopped);
+  const auto sol_stopped = stopped_solver.solve(-1, false);
+  EXPECT_NE(sol_stopped.get_status(), cda_rail::SolutionStatus::Optimal);
+
+  cda_rail::solver::portfolio::GenPOMovingBlockPortfolioSolver solver(
+      instance);
+  const auto start   = std::chrono::steady_clock::now();
+  const auto sol_obj = solver.solve(
+      {.use_astar = true, .use_lazy_mip = true, .use_simplified_mip = false},
+      {}, 60, false);
+  const auto duration = std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::steady_clock::now() - start);
+
+  EXPECT_EQ(sol_obj.get_status(), cda_rail::SolutionStatus::Optimal);
+  EXPECT_LE(sol_obj.get_obj(), sol_astar.get_obj() + GRB_EPS);
+  EXPECT_LT(duration.count(), 60);
+}
+
+// NOLINTEND
+// (clang-analyzer-deadcode.DeadStores,misc-const-correctness,clang-diagnostic-unused-result)
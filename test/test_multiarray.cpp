@@ -1,8 +1,10 @@
 #include "MultiArray.hpp"
 
 #include "gtest/gtest.h"
+#include <array>
 #include <cstddef>
 #include <stdexcept>
+#include <tuple>
 #include <vector>
 
 using std::size_t;
@@ -32,6 +34,13 @@ TEST(Functionality, MultiArray) {
   EXPECT_EQ(a1.dimensions(), 3);
   EXPECT_EQ(a1.get_shape(), std::vector<size_t>({1, 2, 3}));
 
+  // Elements are stored such that the first index changes fastest
+  const auto& data = a1.get_data();
+  EXPECT_EQ(data.size(), 6);
+  EXPECT_EQ(data.at(1), a1(0, 1, 0));
+  EXPECT_EQ(data.at(2), a1(0, 0, 1));
+  EXPECT_EQ(data.at(5), a1(0, 1, 2));
+
   // Calling with wrong number of arguments should throw std::invalid_argument
   EXPECT_THROW(a1(0), std::invalid_argument);
   EXPECT_THROW(a1(0, 0), std::invalid_argument);
@@ -42,3 +51,36 @@ TEST(Functionality, MultiArray) {
   EXPECT_THROW(a1(0, 2, 0), std::out_of_range);
   EXPECT_THROW(a1(0, 0, 3), std::out_of_range);
 }
+
+TEST(Functionality, SparseMultiArray) {
+  cda_rail::SparseMultiArray<size_t> a1(2, 3, 4);
+
+  EXPECT_EQ(a1.size(), 0);
+  EXPECT_EQ(a1.dimensions(), 3);
+  EXPECT_EQ(a1.get_shape(), std::vector<size_t>({2, 3, 4}));
+
+  a1(1, 2, 3) = 5;
+  a1(0, 1, 0) = 7;
+
+  EXPECT_EQ(a1.size(), 2);
+  EXPECT_TRUE(a1.contains(1, 2, 3));
+  EXPECT_TRUE(a1.contains(0, 1, 0));
+  EXPECT_FALSE(a1.contains(0, 0, 0));
+  EXPECT_FALSE(a1.contains(0, 1, 1));
+  EXPECT_EQ(a1.at(1, 2, 3), 5);
+  EXPECT_EQ(a1.at(0, 1, 0), 7);
+
+  // Reading missing elements returns default values without storing them
+  EXPECT_EQ(a1.at(0, 0, 0), 0);
+  EXPECT_EQ(a1.size(), 2);
+
+  // Calling with wrong number of arguments should throw std::invalid_argument
+  EXPECT_THROW(a1(0), std::invalid_argument);
+  EXPECT_THROW(a1(0, 0), std::invalid_argument);
+  EXPECT_THROW(std::ignore = a1.contains(0, 0, 0, 0), std::invalid_argument);
+
+  // Calling with index too large should throw std::out_of_range
+  EXPECT_THROW(a1(2, 0, 0), std::out_of_range);
+  EXPECT_THROW(std::ignore = a1.at(0, 3, 0), std::out_of_range);
+  EXPECT_THROW(std::ignore = a1.contains(0, 0, 4), std::out_of_range);
+}
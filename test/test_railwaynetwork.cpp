@@ -1068,6 +1068,26 @@ TEST(Functionality, NetworkSections) {
   EXPECT_TRUE(std::find(unbreakable_sections[s2_val].begin(),
                         unbreakable_sections[s2_val].end(),
                         v5_v4) != unbreakable_sections[s2_val].end());
+
+  // Precomputed annotations coincide with the searched sections
+  auto annotated_network = network;
+  annotated_network.update_edge_annotations();
+  for (size_t e1 = 0; e1 < network.number_of_edges(); ++e1) {
+    EXPECT_EQ(annotated_network.get_reverse_edge_index(e1),
+              network.get_reverse_edge_index(e1));
+    EXPECT_EQ(annotated_network.get_track_index(e1),
+              network.get_track_index(e1));
+    auto section_annotated =
+        annotated_network.get_unbreakable_section_containing_edge(e1);
+    auto section = network.get_unbreakable_section_containing_edge(e1);
+    std::ranges::sort(section_annotated);
+    std::ranges::sort(section);
+    EXPECT_EQ(section_annotated, section);
+    for (size_t e2 = 0; e2 < network.number_of_edges(); ++e2) {
+      EXPECT_EQ(annotated_network.is_on_same_unbreakable_section(e1, e2),
+                network.is_on_same_unbreakable_section(e1, e2));
+    }
+  }
 }
 
 TEST(Functionality, NetworkConsistency) {
@@ -3149,6 +3169,21 @@ TEST(Functionality, EditTrains) {
   EXPECT_TRUE(trains.get_train("tr1").tim);
 }
 
+TEST(Functionality, TrainClasses) {
+  auto trains = cda_rail::TrainList();
+  EXPECT_TRUE(trains.get_train_classes().empty());
+
+  trains.add_train("tr1", 100, 83.33, 2, 1, false);
+  trains.add_train("tr2", 200, 83.33, 2, 1, false);
+  trains.add_train("tr3", 100, 83.33, 2, 1, true);
+  trains.add_train("tr4", 100, 50, 2, 1, false);
+  trains.add_train("tr5", 200, 83.33, 2, 1, true);
+
+  // Integrity monitoring does not influence the class
+  EXPECT_EQ(trains.get_train_classes(),
+            std::vector<size_t>({0, 1, 0, 2, 1}));
+}
+
 TEST(Functionality, TrainExceptions) {
   // Create a train list
   auto trains = cda_rail::TrainList();